@@ -157,7 +157,8 @@ int32_t Demo::setupFlows()
     {
         flow->initialize(m_config.m_modelMap,
                          m_config.m_inputMap,
-                         m_config.m_outputMap);
+                         m_config.m_outputMap,
+                         m_config.m_schedulerMap);
 
         /* Collect the input GST pipeline from each flow, and add them to a
          * vector of pipelines i.e srcPipelines.
@@ -39,6 +39,7 @@
 #include <common/include/edgeai_utils.h>
 #include <utils/include/edgeai_perfstats.h>
 #include <common/include/edgeai_demo.h>
+#include <common/include/edgeai_benchmark.h>
 
 using namespace ti::edgeai::common;
 
@@ -57,6 +58,7 @@ static void sigHandler(int32_t sig)
 int main(int argc, char * argv[])
 {
     CmdlineArgs cmdArgs;
+    int32_t     status = 0;
 
     /* Register SIGINT handler. */
     signal(SIGINT, sigHandler);
@@ -68,7 +70,14 @@ int main(int argc, char * argv[])
     cmdArgs.parse(argc, argv);
 
     /* Parse the input configuration file. */
-    const YAML::Node &yaml = YAML::LoadFile(cmdArgs.configFile);
+    YAML::Node yaml = YAML::LoadFile(cmdArgs.configFile);
+
+    /* The benchmark runs headless, without any display output. */
+    if (cmdArgs.benchmark)
+    {
+        Benchmark::applyOverrides(yaml, cmdArgs.benchConfig.unthrottle);
+        cmdArgs.enableCurses = false;
+    }
 
     gDemo = new EdgeAIDemo(yaml);
 
@@ -80,11 +89,21 @@ int main(int argc, char * argv[])
     /* Configure the curses display. */
     Statistics::enableCursesReport(cmdArgs.enableCurses, cmdArgs.verbose, title.c_str());
 
-    /* Configure the performance report. */
-    ti::utils::enableReport(true);
+    if (cmdArgs.benchmark)
+    {
+        Benchmark   benchmark(cmdArgs.benchConfig);
+
+        /* Run until the benchmark limits are reached. */
+        status = benchmark.run(*gDemo, title);
+    }
+    else
+    {
+        /* Configure the performance report. */
+        ti::utils::enableReport(true);
 
-    /* Wait for the threads to exit. */
-    gDemo->waitForExit();
+        /* Wait for the threads to exit. */
+        gDemo->waitForExit();
+    }
 
     /* Dump Gstremer Pipeline as dot file. */
     if(cmdArgs.dumpDot)
@@ -103,6 +122,6 @@ int main(int argc, char * argv[])
 
     delete gDemo;
 
-    return 0;
+    return status;
 }
 
@@ -0,0 +1,453 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* Standard headers. */
+#include <chrono>
+#include <cmath>
+#include <getopt.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <utils/include/ti_stl_helpers.h>
+#include <common/include/edgeai_tensor_capture.h>
+#include <common/include/pre_process_image.h>
+#include <common/include/post_process_image.h>
+
+using namespace std;
+using namespace ti::utils;
+using namespace ti::edgeai::common;
+
+struct ReplayArgs
+{
+    /** Model directory holding param.yaml. */
+    string      modelPath;
+
+    /** Capture file to replay. */
+    string      captureFile;
+
+    /** Capture file to compare against. */
+    string      diffFile;
+
+    /** Post-processing debug output directory. */
+    string      outDir;
+
+    /** Frame width. */
+    int32_t     width{1280};
+
+    /** Frame height. */
+    int32_t     height{720};
+
+    /** Number of passes over the capture. */
+    int32_t     iterations{1};
+
+    /** Logging level. */
+    LogLevel    logLevel{WARN};
+};
+
+static void showUsage(const char *name)
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# %s PARAMETERS [OPTIONAL PARAMETERS]\n", name);
+    printf("# OPTIONS:\n");
+    printf("#  --capture     |-c Path to the tensor capture file.\n");
+    printf("#  --model       |-m Path to the model directory. Required unless diffing.\n");
+    printf("#  [--diff       |-d Compare the outputs against another capture file.]\n");
+    printf("#  [--width      |-W Frame width. Default is 1280.]\n");
+    printf("#  [--height     |-H Frame height. Default is 720.]\n");
+    printf("#  [--iterations |-n Number of passes over the capture. Default is 1.]\n");
+    printf("#  [--out-dir    |-o Directory for the post-processing debug output.]\n");
+    printf("#  [--log-level  |-l Logging level to enable. [0: DEBUG 1:INFO 2:WARN 3:ERROR]. Default is 2.]\n");
+    printf("#  [--help       |-h]\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2024\n");
+    printf("# \n");
+    printf("# \n");
+    exit(0);
+}
+
+static void ParseCmdlineArgs(int32_t    argc,
+                             char      *argv[],
+                             ReplayArgs &args)
+{
+    int32_t longIndex;
+    int32_t opt;
+    static struct option long_options[] = {
+        {"help",       no_argument,       0, 'h' },
+        {"capture",    required_argument, 0, 'c' },
+        {"model",      required_argument, 0, 'm' },
+        {"diff",       required_argument, 0, 'd' },
+        {"width",      required_argument, 0, 'W' },
+        {"height",     required_argument, 0, 'H' },
+        {"iterations", required_argument, 0, 'n' },
+        {"out-dir",    required_argument, 0, 'o' },
+        {"log-level",  required_argument, 0, 'l' },
+        {0,            0,                 0,  0  }
+    };
+
+    while ((opt = getopt_long(argc, argv,"hc:m:d:W:H:n:o:l:",
+                   long_options, &longIndex )) != -1)
+    {
+        switch (opt)
+        {
+            case 'c' :
+                args.captureFile = optarg;
+                break;
+
+            case 'm' :
+                args.modelPath = optarg;
+                break;
+
+            case 'd' :
+                args.diffFile = optarg;
+                break;
+
+            case 'W' :
+                args.width = strtol(optarg, NULL, 0);
+                break;
+
+            case 'H' :
+                args.height = strtol(optarg, NULL, 0);
+                break;
+
+            case 'n' :
+                args.iterations = strtol(optarg, NULL, 0);
+                break;
+
+            case 'o' :
+                args.outDir = optarg;
+                break;
+
+            case 'l' :
+                args.logLevel = static_cast<LogLevel>(strtol(optarg, NULL, 0));
+                break;
+
+            case 'h' :
+            default:
+                showUsage(argv[0]);
+                exit(-1);
+
+        } // switch (opt)
+
+    } // while ((opt = getopt_long(argc, argv
+
+    // Validate the parameters
+    if (args.captureFile.empty() ||
+        (args.diffFile.empty() && args.modelPath.empty()) ||
+        args.width <= 0 || args.height <= 0 || args.iterations <= 0)
+    {
+        showUsage(argv[0]);
+        exit(-1);
+    }
+
+    logSetLevel(args.logLevel);
+
+    return;
+
+} // End of ParseCmdLineArgs()
+
+/**
+ * Compare one output tensor across all the common records of two captures.
+ *
+ * @returns Number of records where the tensor differs.
+ */
+template <typename T>
+static uint64_t diffTensor(const TensorCaptureReader   &ref,
+                           const TensorCaptureReader   &cur,
+                           uint32_t                     index,
+                           uint64_t                     numRecords,
+                           int64_t                      numElem,
+                           double                      &maxDiff,
+                           uint64_t                    &numElemDiff)
+{
+    uint64_t    numRecDiff = 0;
+
+    for (uint64_t r = 0; r < numRecords; r++)
+    {
+        const T    *a = reinterpret_cast<const T *>(ref.getOutputData(r, index));
+        const T    *b = reinterpret_cast<const T *>(cur.getOutputData(r, index));
+        bool        differs = false;
+
+        for (int64_t i = 0; i < numElem; i++)
+        {
+            if (a[i] != b[i])
+            {
+                double d = fabs(static_cast<double>(a[i]) - static_cast<double>(b[i]));
+
+                maxDiff = d > maxDiff ? d : maxDiff;
+                numElemDiff++;
+                differs = true;
+            }
+        }
+
+        numRecDiff += differs;
+    }
+
+    return numRecDiff;
+}
+
+static int32_t runDiff(const ReplayArgs &args)
+{
+    TensorCaptureReader ref(args.captureFile);
+    TensorCaptureReader cur(args.diffFile);
+    const VecDlTensor  *refInfo = ref.getOutputInfo();
+    const VecDlTensor  *curInfo = cur.getOutputInfo();
+    uint64_t            numRecords;
+    int32_t             status = 0;
+
+    if (refInfo->size() != curInfo->size())
+    {
+        LOG_ERROR("The captures have a different number of outputs.\n");
+        return -1;
+    }
+
+    numRecords = min(ref.getNumRecords(), cur.getNumRecords());
+
+    printf("Comparing %ld records.\n", numRecords);
+
+    for (uint32_t i = 0; i < refInfo->size(); i++)
+    {
+        const DlTensor &t = refInfo->at(i);
+        double          maxDiff = 0;
+        uint64_t        numElemDiff = 0;
+        uint64_t        numRecDiff = 0;
+
+        if (t.type != curInfo->at(i).type || t.size != curInfo->at(i).size)
+        {
+            printf("  %-32s type or shape differs\n", t.name.c_str());
+            status = 1;
+            continue;
+        }
+
+#define DIFF_TENSOR(T) \
+        diffTensor<T>(ref, cur, i, numRecords, t.numElem, maxDiff, numElemDiff)
+
+        if (t.type == DlInferType_Int8)
+        {
+            numRecDiff = DIFF_TENSOR(int8_t);
+        }
+        else if (t.type == DlInferType_UInt8)
+        {
+            numRecDiff = DIFF_TENSOR(uint8_t);
+        }
+        else if (t.type == DlInferType_Int16)
+        {
+            numRecDiff = DIFF_TENSOR(int16_t);
+        }
+        else if (t.type == DlInferType_UInt16)
+        {
+            numRecDiff = DIFF_TENSOR(uint16_t);
+        }
+        else if (t.type == DlInferType_Int32)
+        {
+            numRecDiff = DIFF_TENSOR(int32_t);
+        }
+        else if (t.type == DlInferType_UInt32)
+        {
+            numRecDiff = DIFF_TENSOR(uint32_t);
+        }
+        else if (t.type == DlInferType_Int64)
+        {
+            numRecDiff = DIFF_TENSOR(int64_t);
+        }
+        else if (t.type == DlInferType_Float32)
+        {
+            numRecDiff = DIFF_TENSOR(float);
+        }
+
+#undef DIFF_TENSOR
+
+        printf("  %-32s %ld/%ld records differ, %ld elements, max abs diff %g\n",
+               t.name.c_str(), numRecDiff, numRecords, numElemDiff, maxDiff);
+
+        if (numRecDiff)
+        {
+            status = 1;
+        }
+    }
+
+    return status;
+}
+
+static int32_t runPostproc(const ReplayArgs &args)
+{
+    TensorCaptureReader     capture(args.captureFile);
+    PreprocessImageConfig   preProcCfg;
+    PostprocessImageConfig  postProcCfg;
+    DebugDumpConfig         debugConfig;
+    PostprocessImage       *postProcObj;
+    VecDlTensorPtr          inputs;
+    VecDlTensorPtr          outputs;
+    vector<uint8_t>         frame(args.width * args.height * 3);
+    double                  minTime = INFINITY;
+    double                  maxTime = 0;
+    double                  totalTime = 0;
+    double                  inferTime = 0;
+    uint64_t                numRecords = capture.getNumRecords();
+    uint64_t                numFrames = 0;
+    int32_t                 status;
+
+    status = preProcCfg.getConfig(args.modelPath);
+
+    if (status == 0)
+    {
+        status = postProcCfg.getConfig(args.modelPath);
+    }
+
+    if (status < 0)
+    {
+        LOG_ERROR("getConfig() failed.\n");
+        return status;
+    }
+
+    if (numRecords == 0)
+    {
+        LOG_ERROR("%s does not hold a single frame.\n", args.captureFile.c_str());
+        return -1;
+    }
+
+    /* Same setup as ModelInfo::initialize() and createPostprocCntxt(). */
+    if (postProcCfg.taskType == "segmentation")
+    {
+        auto const &t = capture.getOutputInfo()->at(0);
+
+        postProcCfg.inDataWidth  = t.shape[t.dim - 1];
+        postProcCfg.inDataHeight = t.shape[t.dim - 2];
+    }
+    else
+    {
+        postProcCfg.inDataWidth  = preProcCfg.outDataWidth;
+        postProcCfg.inDataHeight = preProcCfg.outDataHeight;
+    }
+
+    postProcCfg.outDataWidth  = args.width;
+    postProcCfg.outDataHeight = args.height;
+
+    if (!args.outDir.empty())
+    {
+        debugConfig.enable = true;
+        debugConfig.dir    = args.outDir;
+        debugConfig.file   = "post";
+    }
+
+    postProcObj = PostprocessImage::makePostprocessImageObj(postProcCfg, debugConfig);
+
+    if (postProcObj == nullptr)
+    {
+        LOG_ERROR("PostprocessImage::makePostprocessImageObj() failed.\n");
+        return -1;
+    }
+
+    for (auto const &t : *capture.getOutputInfo())
+    {
+        outputs.push_back(new DlTensor(t));
+    }
+
+    for (int32_t n = 0; n < args.iterations && status == 0; n++)
+    {
+        for (uint64_t r = 0; r < numRecords; r++)
+        {
+            status = capture.bind(r, inputs, outputs);
+
+            if (status < 0)
+            {
+                break;
+            }
+
+            /* Start every frame from the same blank image, outside of the
+             * timed section.
+             */
+            fill(frame.begin(), frame.end(), 0);
+
+            auto start = chrono::steady_clock::now();
+            (*postProcObj)(frame.data(), outputs);
+            auto end = chrono::steady_clock::now();
+
+            double t = chrono::duration<double, micro>(end - start).count();
+
+            minTime    = t < minTime ? t : minTime;
+            maxTime    = t > maxTime ? t : maxTime;
+            totalTime += t;
+            inferTime += capture.getRecord(r)->inferTime / 1000.0;
+            numFrames++;
+        }
+    }
+
+    if (numFrames)
+    {
+        printf("Task               : %s\n", postProcCfg.taskType.c_str());
+        printf("Frames             : %ld (%ld records x %d)\n",
+               numFrames, numRecords, args.iterations);
+        printf("Frame size         : %dx%d\n", args.width, args.height);
+        printf("Post-process (us)  : min %.1f avg %.1f max %.1f\n",
+               minTime, totalTime / numFrames, maxTime);
+        printf("Captured inference : avg %.1f us\n", inferTime / numFrames);
+    }
+
+    /* The tensors point into the capture mapping. */
+    for (auto &t : outputs)
+    {
+        t->data = nullptr;
+    }
+
+    DeleteVec(outputs);
+    delete postProcObj;
+
+    return status;
+}
+
+int main(int argc, char * argv[])
+{
+    ReplayArgs  args;
+    int32_t     status;
+
+    // Parse the command line options
+    ParseCmdlineArgs(argc, argv, args);
+
+    try
+    {
+        if (!args.diffFile.empty())
+        {
+            status = runDiff(args);
+        }
+        else
+        {
+            status = runPostproc(args);
+        }
+    }
+    catch (const runtime_error &e)
+    {
+        LOG_ERROR("%s\n", e.what());
+        status = -1;
+    }
+
+    return status == 0 ? 0 : (status > 0 ? 1 : 2);
+}
@@ -0,0 +1,576 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* Standard headers. */
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <limits>
+#include <getopt.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/pre_process_image.h>
+#include <common/include/post_process_image.h>
+
+/**
+ * Micro-benchmarks for the pre/post-processing kernels. The kernels are
+ * fed synthetic tensors so no model, camera or accelerator is needed.
+ * Each case reports the time per frame and the number of bytes the kernel
+ * has to read or write, which gives the effective bandwidth.
+ */
+
+using namespace std;
+using namespace ti::utils;
+using namespace ti::edgeai::common;
+
+using BenchClock = chrono::steady_clock;
+
+struct BenchArgs
+{
+    /** Only run the cases whose name contains this string. */
+    string      filter;
+
+    /** Minimum measurement time per case in milliseconds. */
+    double      minTimeMs{200};
+
+    /** Minimum number of measured iterations per case. */
+    int32_t     minIters{10};
+
+    /** Emit CSV instead of a table. */
+    bool        csv{false};
+};
+
+struct BenchType
+{
+    DlInferType type;
+    const char *name;
+    int32_t     elemSize;
+
+    /** Largest value the type holds, the synthetic data stays below it. */
+    double      maxValue;
+};
+
+struct BenchResolution
+{
+    const char *name;
+    int32_t     width;
+    int32_t     height;
+};
+
+static const BenchType gTypes[] =
+{
+    {DlInferType_Int8,    "int8",    1, numeric_limits<int8_t>::max()},
+    {DlInferType_UInt8,   "uint8",   1, numeric_limits<uint8_t>::max()},
+    {DlInferType_Int16,   "int16",   2, numeric_limits<int16_t>::max()},
+    {DlInferType_UInt16,  "uint16",  2, numeric_limits<uint16_t>::max()},
+    {DlInferType_Int32,   "int32",   4, numeric_limits<int32_t>::max()},
+    {DlInferType_UInt32,  "uint32",  4, numeric_limits<uint32_t>::max()},
+    {DlInferType_Int64,   "int64",   8, static_cast<double>(numeric_limits<int64_t>::max())},
+    {DlInferType_Float32, "float32", 4, numeric_limits<float>::max()}
+};
+
+static const BenchResolution gResolutions[] =
+{
+    {"720p",  1280,  720},
+    {"1080p", 1920, 1080},
+    {"4k",    3840, 2160}
+};
+
+/**
+ * Synthetic tensor. The payload is owned by the object so that the
+ * DlTensor never frees it.
+ */
+class BenchTensor
+{
+    public:
+        BenchTensor(const BenchType         &type,
+                    const vector<int64_t>   &shape)
+        {
+            m_tensor.name     = "bench";
+            m_tensor.type     = type.type;
+            m_tensor.elemSize = type.elemSize;
+            m_tensor.shape    = shape;
+            m_tensor.dim      = shape.size();
+            m_tensor.numElem  = 1;
+
+            for (auto d : shape)
+            {
+                m_tensor.numElem *= d;
+            }
+
+            m_tensor.size = m_tensor.numElem * m_tensor.elemSize;
+            m_data.resize(m_tensor.size);
+            m_tensor.data = m_data.data();
+        }
+
+        /** Fill the tensor with gen(index), saturated to the tensor type. */
+        void fill(const function<double(int64_t)> &gen)
+        {
+            switch (m_tensor.type)
+            {
+                case DlInferType_Int8:    fillAs<int8_t>(gen);   break;
+                case DlInferType_UInt8:   fillAs<uint8_t>(gen);  break;
+                case DlInferType_Int16:   fillAs<int16_t>(gen);  break;
+                case DlInferType_UInt16:  fillAs<uint16_t>(gen); break;
+                case DlInferType_Int32:   fillAs<int32_t>(gen);  break;
+                case DlInferType_UInt32:  fillAs<uint32_t>(gen); break;
+                case DlInferType_Int64:   fillAs<int64_t>(gen);  break;
+                case DlInferType_Float32: fillAs<float>(gen);    break;
+                default: break;
+            }
+        }
+
+        ~BenchTensor()
+        {
+            m_tensor.data = nullptr;
+        }
+
+    private:
+        template <typename T>
+        void fillAs(const function<double(int64_t)> &gen)
+        {
+            T  *p = reinterpret_cast<T *>(m_data.data());
+
+            for (int64_t i = 0; i < m_tensor.numElem; i++)
+            {
+                double v = gen(i);
+
+                v = std::max(v, static_cast<double>(numeric_limits<T>::lowest()));
+                v = std::min(v, static_cast<double>(numeric_limits<T>::max()));
+                p[i] = static_cast<T>(v);
+            }
+        }
+
+    public:
+        DlTensor        m_tensor;
+
+    private:
+        vector<uint8_t> m_data;
+};
+
+static void showUsage(const char *name)
+{
+    printf(" \n");
+    printf("# \n");
+    printf("# %s [OPTIONAL PARAMETERS]\n", name);
+    printf("# OPTIONS:\n");
+    printf("#  [--filter     |-f Only run the cases whose name contains the string.]\n");
+    printf("#  [--min-time   |-t Minimum measurement time per case in ms. Default is 200.]\n");
+    printf("#  [--min-iters  |-i Minimum number of iterations per case. Default is 10.]\n");
+    printf("#  [--csv        |-c Print the results as CSV.]\n");
+    printf("#  [--help       |-h]\n");
+    printf("# \n");
+    printf("# (c) Texas Instruments 2024\n");
+    printf("# \n");
+    printf("# \n");
+    exit(0);
+}
+
+static void ParseCmdlineArgs(int32_t    argc,
+                             char      *argv[],
+                             BenchArgs &args)
+{
+    int32_t longIndex;
+    int32_t opt;
+    static struct option long_options[] = {
+        {"help",      no_argument,       0, 'h' },
+        {"filter",    required_argument, 0, 'f' },
+        {"min-time",  required_argument, 0, 't' },
+        {"min-iters", required_argument, 0, 'i' },
+        {"csv",       no_argument,       0, 'c' },
+        {0,           0,                 0,  0  }
+    };
+
+    while ((opt = getopt_long(argc, argv,"hf:t:i:c",
+                   long_options, &longIndex )) != -1)
+    {
+        switch (opt)
+        {
+            case 'f' :
+                args.filter = optarg;
+                break;
+
+            case 't' :
+                args.minTimeMs = strtod(optarg, NULL);
+                break;
+
+            case 'i' :
+                args.minIters = strtol(optarg, NULL, 0);
+                break;
+
+            case 'c' :
+                args.csv = true;
+                break;
+
+            case 'h' :
+            default:
+                showUsage(argv[0]);
+                exit(-1);
+
+        } // switch (opt)
+
+    } // while ((opt = getopt_long(argc, argv
+
+    logSetLevel(ERROR);
+
+    return;
+
+} // End of ParseCmdLineArgs()
+
+class BenchRunner
+{
+    public:
+        BenchRunner(const BenchArgs &args):
+            m_args(args)
+        {
+            if (m_args.csv)
+            {
+                printf("case,iterations,min_ns,median_ns,bytes,gbps\n");
+            }
+            else
+            {
+                printf("%-48s %8s %14s %14s %12s %8s\n", "case", "iters",
+                       "min ns/frame", "med ns/frame", "bytes", "GB/s");
+            }
+        }
+
+        /**
+         * Run one case.
+         *
+         * @param name Case name
+         * @param bytes Bytes read or written by one call of the kernel
+         * @param fn The kernel
+         */
+        void run(const string &name, uint64_t bytes, const function<void()> &fn)
+        {
+            vector<double>  samples;
+            double          elapsed = 0;
+            double          median;
+
+            if (!m_args.filter.empty() && name.find(m_args.filter) == string::npos)
+            {
+                return;
+            }
+
+            /* Warm the caches and let the allocations settle. */
+            for (int32_t i = 0; i < 3; i++)
+            {
+                fn();
+            }
+
+            while (elapsed < m_args.minTimeMs * 1e6 ||
+                   static_cast<int32_t>(samples.size()) < m_args.minIters)
+            {
+                auto start = BenchClock::now();
+                fn();
+                auto end = BenchClock::now();
+
+                double ns = chrono::duration<double, nano>(end - start).count();
+
+                samples.push_back(ns);
+                elapsed += ns;
+            }
+
+            sort(samples.begin(), samples.end());
+            median = samples[samples.size() / 2];
+
+            if (m_args.csv)
+            {
+                printf("%s,%ld,%.0f,%.0f,%ld,%.3f\n", name.c_str(),
+                       samples.size(), samples[0], median, bytes, bytes / median);
+            }
+            else
+            {
+                printf("%-48s %8ld %14.0f %14.0f %12ld %8.3f\n", name.c_str(),
+                       samples.size(), samples[0], median, bytes, bytes / median);
+            }
+
+            fflush(stdout);
+        }
+
+    private:
+        const BenchArgs    &m_args;
+};
+
+static PostprocessImageConfig makePostprocConfig(const string          &taskType,
+                                                 const BenchResolution &res,
+                                                 int32_t                inWidth,
+                                                 int32_t                inHeight)
+{
+    PostprocessImageConfig  config;
+
+    config.taskType       = taskType;
+    config.inDataWidth    = inWidth;
+    config.inDataHeight   = inHeight;
+    config.outDataWidth   = res.width;
+    config.outDataHeight  = res.height;
+    config.labelOffsetMap = {{0, 0}};
+    config.vizThreshold   = 0.5f;
+    config.alpha          = 0.5f;
+    config.topN           = 5;
+
+    return config;
+}
+
+static void runPostproc(BenchRunner                  &runner,
+                        const string                 &name,
+                        const PostprocessImageConfig &config,
+                        BenchTensor                  &tensor,
+                        uint64_t                      bytes)
+{
+    DebugDumpConfig     debugConfig;
+    PostprocessImage   *postProcObj;
+    VecDlTensorPtr      results{&tensor.m_tensor};
+    vector<uint8_t>     frame(config.outDataWidth * config.outDataHeight * 3, 128);
+
+    postProcObj = PostprocessImage::makePostprocessImageObj(config, debugConfig);
+
+    if (postProcObj == nullptr)
+    {
+        LOG_ERROR("makePostprocessImageObj() failed for %s.\n", name.c_str());
+        return;
+    }
+
+    runner.run(name, bytes, [&]{ (*postProcObj)(frame.data(), results); });
+
+    delete postProcObj;
+}
+
+/* Detection output as [1, N, 6] with x1, y1, x2, y2, score, label. */
+static void benchObjDetect(BenchRunner &runner)
+{
+    for (auto const &type : gTypes)
+    {
+        /* The coordinates are in input pixels, so the 8-bit types get a
+         * smaller input rather than saturating every box to the same one.
+         */
+        const int32_t inSize = std::min(320.0, type.maxValue);
+
+        for (auto const &res : gResolutions)
+        {
+            for (int32_t numBoxes : {10, 100, 500})
+            {
+                auto config = makePostprocConfig("detection", res, inSize, inSize);
+                BenchTensor tensor(type, {1, numBoxes, 6});
+                string      name = string("detect/") + type.name + "/" +
+                                   res.name + "/" + to_string(numBoxes);
+
+                config.formatter     = {0, 1, 2, 3, 5, 4};
+                config.resultIndices = {0};
+                config.ignoreIndex   = -1;
+                config.normDetect    = false;
+
+                /* Every box is above the threshold, the worst case. Boxes
+                 * are 1/8th of the input, spread over the image.
+                 */
+                tensor.fill([&](int64_t i)
+                {
+                    int64_t box = i / 6;
+                    int64_t pos = i % 6;
+                    double  x = (box * 37) % (inSize - inSize / 8);
+                    double  y = (box * 53) % (inSize - inSize / 8);
+
+                    switch (pos)
+                    {
+                        case 0:  return x;
+                        case 1:  return y;
+                        case 2:  return x + inSize / 8;
+                        case 3:  return y + inSize / 8;
+                        case 4:  return 1.0;
+                        default: return static_cast<double>(box % 80);
+                    }
+                });
+
+                runPostproc(runner, name, config, tensor, tensor.m_tensor.size);
+            }
+        }
+    }
+}
+
+/* Classification output as [1, C]. */
+static void benchClassify(BenchRunner &runner)
+{
+    const BenchResolution &res = gResolutions[1];
+
+    for (auto const &type : gTypes)
+    {
+        for (int32_t numClasses : {80, 1000})
+        {
+            auto config = makePostprocConfig("classification", res, 224, 224);
+            BenchTensor tensor(type, {1, numClasses});
+            string      name = string("classify/") + type.name + "/" +
+                               res.name + "/" + to_string(numClasses);
+
+            /* Scrambled scores so that the top-N search does real work. */
+            tensor.fill([](int64_t i) { return (i * 7919) % 127; });
+
+            runPostproc(runner, name, config, tensor, tensor.m_tensor.size);
+        }
+    }
+}
+
+/* Segmentation output as [1, 1, H, W] class ids, blended over the frame. */
+static void benchSemanticSeg(BenchRunner &runner)
+{
+    const int32_t inSize = 512;
+
+    for (auto const &type : gTypes)
+    {
+        for (auto const &res : gResolutions)
+        {
+            for (int32_t numClasses : {80, 1000})
+            {
+                /* The 8-bit types cannot hold 1000 class ids. */
+                if (numClasses - 1 > type.maxValue)
+                {
+                    continue;
+                }
+
+                auto config = makePostprocConfig("segmentation", res, inSize, inSize);
+                BenchTensor tensor(type, {1, 1, inSize, inSize});
+                string      name = string("segment/") + type.name + "/" +
+                                   res.name + "/" + to_string(numClasses);
+
+                tensor.fill([numClasses](int64_t i)
+                {
+                    return (i / 64) % numClasses;
+                });
+
+                /* The frame is read and written once per pixel. */
+                uint64_t bytes = tensor.m_tensor.size +
+                                 2ull * res.width * res.height * 3;
+
+                runPostproc(runner, name, config, tensor, bytes);
+            }
+        }
+    }
+}
+
+/* Keypoint output as [1, N, 6 + 17 * 3]. The kernel only reads float. */
+static void benchKeypointDetect(BenchRunner &runner)
+{
+    const int32_t inSize = 640;
+    const int32_t numKpts = 17;
+    const int32_t width = 6 + numKpts * 3;
+    const BenchType &type = gTypes[7];
+
+    for (auto const &res : gResolutions)
+    {
+        for (int32_t numBoxes : {10, 100, 500})
+        {
+            auto config = makePostprocConfig("keypoint_detection", res, inSize, inSize);
+            BenchTensor tensor(type, {1, numBoxes, width});
+            string      name = string("keypoint/") + type.name + "/" +
+                               res.name + "/" + to_string(numBoxes);
+
+            config.normDetect = false;
+
+            tensor.fill([&](int64_t i)
+            {
+                int64_t box = i / width;
+                int64_t pos = i % width;
+                double  x = (box * 37) % (inSize - inSize / 4);
+                double  y = (box * 53) % (inSize - inSize / 4);
+
+                if (pos < 4)
+                {
+                    return (pos & 1 ? y : x) + (pos >= 2 ? inSize / 4 : 0);
+                }
+                else if (pos == 4)
+                {
+                    return 1.0;
+                }
+                else if (pos == 5)
+                {
+                    return 0.0;
+                }
+
+                /* Keypoints as x, y, confidence inside the box. */
+                pos -= 6;
+
+                if (pos % 3 == 2)
+                {
+                    return 1.0;
+                }
+
+                return (pos % 3 ? y : x) + (pos / 3) * 4;
+            });
+
+            runPostproc(runner, name, config, tensor, tensor.m_tensor.size);
+        }
+    }
+}
+
+/* Input tensor copy, i.e. the path without zero copy. */
+static void benchPreproc(BenchRunner &runner)
+{
+    const BenchType types[] = {gTypes[1], gTypes[7]};
+
+    for (auto const &type : types)
+    {
+        for (int32_t size : {224, 320, 512})
+        {
+            PreprocessImageConfig   config;
+            DebugDumpConfig         debugConfig;
+            PreprocessImage        *preProcObj;
+            BenchTensor             tensor(type, {1, 3, size, size});
+            vector<uint8_t>         input(tensor.m_tensor.size, 1);
+            VecDlTensorPtr          outputs{&tensor.m_tensor};
+            string                  name = string("preproc/") + type.name + "/" +
+                                           to_string(size) + "x" + to_string(size);
+
+            preProcObj = PreprocessImage::makePreprocessImageObj(config, debugConfig);
+
+            runner.run(name, 2ull * tensor.m_tensor.size,
+                       [&]{ (*preProcObj)(input.data(), outputs, false); });
+
+            delete preProcObj;
+        }
+    }
+}
+
+int main(int argc, char * argv[])
+{
+    BenchArgs   args;
+
+    ParseCmdlineArgs(argc, argv, args);
+
+    BenchRunner runner(args);
+
+    benchPreproc(runner);
+    benchClassify(runner);
+    benchObjDetect(runner);
+    benchKeypointDetect(runner);
+    benchSemanticSeg(runner);
+
+    return 0;
+}
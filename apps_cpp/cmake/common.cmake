@@ -3,10 +3,6 @@ include(CMakePackageConfigHelpers)
 
 add_compile_options(-std=c++17)
 
-option(USE_TVM_RT "Enable TVM-RT inference" ON)
-option(USE_TENSORFLOW_RT "Enable Tensorflow inference" ON)
-option(USE_ONNX_RT "Enable Onnx inference" ON)
-
 # Specific compile optios across all targets
 #add_compile_definitions(MINIMAL_LOGGING)
 
@@ -76,12 +72,31 @@ elseif ("${TARGET_SOC_LOWER}" STREQUAL "am62p")
     set(TARGET_CPU          A53)
     set(TARGET_OS           LINUX)
     set(TARGET_SOC          AM62P)
+elseif ("${TARGET_SOC_LOWER}" STREQUAL "host")
+    # Developer workstation build against the stock GStreamer and OpenCV
+    # packages, without the TI plugins and libraries.
+    set(TARGET_PLATFORM     HOST)
+    set(TARGET_CPU          ${CMAKE_SYSTEM_PROCESSOR})
+    set(TARGET_OS           LINUX)
+    set(TARGET_SOC          HOST)
 else()
     message(FATAL_ERROR "SOC ${TARGET_SOC_LOWER} is not supported.")
 endif()
 
 message("SOC=${TARGET_SOC_LOWER}")
 
+# The host build only has the runtimes a developer workstation provides,
+# ONNX-RT on the CPU by default.
+if ("${TARGET_SOC}" STREQUAL "HOST")
+    set(EDGEAI_USE_RT_DEFAULT OFF)
+else()
+    set(EDGEAI_USE_RT_DEFAULT ON)
+endif()
+
+option(USE_TVM_RT "Enable TVM-RT inference" ${EDGEAI_USE_RT_DEFAULT})
+option(USE_TENSORFLOW_RT "Enable Tensorflow inference" ${EDGEAI_USE_RT_DEFAULT})
+option(USE_ONNX_RT "Enable Onnx inference" ON)
+
 add_definitions(
     -DTARGET_CPU=${TARGET_CPU}
     -DTARGET_OS=${TARGET_OS}
@@ -106,10 +121,33 @@ if(USE_ONNX_RT)
 add_definitions(-DUSE_ONNX_RT)
 endif()
 
+# The rtsp sink needs the GStreamer RTSP server library, it is left out by
+# default when the library is not installed.
+find_library(GST_RTSP_SERVER_LIB gstrtspserver-1.0
+             PATHS ${TARGET_FS}/usr/lib/aarch64-linux-gnu ${TARGET_FS}/usr/lib)
+
+if(GST_RTSP_SERVER_LIB)
+    set(EDGEAI_RTSP_SERVER_DEFAULT ON)
+else()
+    set(EDGEAI_RTSP_SERVER_DEFAULT OFF)
+endif()
+
+option(EDGEAI_ENABLE_RTSP_SERVER "Enable the rtsp sink" ${EDGEAI_RTSP_SERVER_DEFAULT})
+
+if(EDGEAI_ENABLE_RTSP_SERVER)
+    message("EDGEAI_ENABLE_RTSP_SERVER enabled")
+    add_definitions(-DEDGEAI_ENABLE_RTSP_SERVER)
+endif()
+
 link_directories(${TARGET_FS}/usr/lib/aarch64-linux-gnu
                  ${TARGET_FS}/usr/lib/
                  )
 
+if ("${TARGET_SOC}" STREQUAL "HOST")
+link_directories(/usr/lib/${CMAKE_LIBRARY_ARCHITECTURE})
+include_directories(SYSTEM /usr/lib/${CMAKE_LIBRARY_ARCHITECTURE}/glib-2.0/include)
+endif()
+
 if(USE_TVM_RT)
 link_directories(${TARGET_FS}/usr/lib/python3.12/site-packages/tvm)
 endif()
@@ -180,6 +218,7 @@ set(SYSTEM_LINK_LIBS
     glib-2.0
     gobject-2.0
     gstapp-1.0
+    gstbase-1.0
     opencv_core
     opencv_imgproc
     yaml-cpp
@@ -187,10 +226,15 @@ set(SYSTEM_LINK_LIBS
     dl
     )
 
-if(NOT ${TARGET_SOC} STREQUAL "AM62X" AND NOT ${TARGET_SOC} STREQUAL "AM62P")
+if(NOT ${TARGET_SOC} STREQUAL "AM62X" AND NOT ${TARGET_SOC} STREQUAL "AM62P" AND
+   NOT ${TARGET_SOC} STREQUAL "HOST")
 set(SYSTEM_LINK_LIBS ${SYSTEM_LINK_LIBS} tivision_apps)
 endif()
 
+if(EDGEAI_ENABLE_RTSP_SERVER)
+set(SYSTEM_LINK_LIBS ${SYSTEM_LINK_LIBS} gstrtspserver-1.0)
+endif()
+
 if(USE_TVM_RT)
 set(SYSTEM_LINK_LIBS ${SYSTEM_LINK_LIBS} tvm)
 endif()
@@ -0,0 +1,146 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_BENCHMARK_H_
+#define _TI_EDGEAI_BENCHMARK_H_
+
+/* Standard headers. */
+#include <string>
+
+/* Third-party headers. */
+#include <yaml-cpp/yaml.h>
+
+/* Module headers. */
+#include <common/include/edgeai_demo.h>
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Configuration of a headless benchmark run.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct BenchmarkConfig
+    {
+        /** Number of measured frames, per flow. A value of 0 disables the
+         *  frame limit.
+         */
+        uint64_t    frames{0};
+
+        /** Measured duration in seconds. A value of 0 disables the time
+         *  limit.
+         */
+        float       duration{0.0f};
+
+        /** Number of frames every flow processes before the measurement
+         *  starts.
+         */
+        uint64_t    warmup{30};
+
+        /** Path to the JSON summary. Written to stdout if empty. */
+        string      output;
+
+        /** Disable the throttling of the inputs. */
+        bool        unthrottle{false};
+    };
+
+    /**
+     * \brief Runs a demo without display output and writes a machine
+     *        readable summary of the throughput, the latency percentiles
+     *        and the CPU load.
+     *
+     * \ingroup group_edgeai_common
+     */
+    class Benchmark
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Benchmark configuration
+             */
+            Benchmark(const BenchmarkConfig &config);
+
+            /**
+             * Rewrites the demo configuration for a headless run. Every
+             * output is replaced with a fakesink and, if requested, the
+             * throttling of the inputs is disabled.
+             *
+             * @param yaml Demo configuration to update
+             * @param unthrottle Disable the throttling of the inputs
+             */
+            static void applyOverrides(YAML::Node  &yaml,
+                                       bool         unthrottle);
+
+            /**
+             * Warms the demo up, measures it until the frame or the time
+             * limit is reached, or until the inputs end, and writes the
+             * summary. The demo is stopped on return.
+             *
+             * @param demo Demo to measure
+             * @param title Title of the demo
+             *
+             * @returns 0 on success, -1 otherwise
+             */
+            int32_t run(EdgeAIDemo     &demo,
+                        const string   &title);
+
+            /** Destructor. */
+            ~Benchmark();
+
+        private:
+            /**
+             * Copy Constructor.
+             *
+             * Copy Constructor is not required and allowed and hence prevent
+             * the compiler from generating a default Copy Constructor.
+             */
+            Benchmark(const Benchmark& ) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            Benchmark & operator=(const Benchmark& rhs) = delete;
+
+        private:
+            /** Benchmark configuration. */
+            BenchmarkConfig     m_config;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_BENCHMARK_H_ */
+
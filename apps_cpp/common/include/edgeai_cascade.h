@@ -0,0 +1,217 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_CASCADE_H_
+#define _TI_EDGEAI_CASCADE_H_
+
+/* Standard headers. */
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <edgeai_dl_inferer/ti_dl_inferer.h>
+#include <edgeai_dl_inferer/ti_pre_process_config.h>
+#include <edgeai_dl_inferer/ti_post_process_config.h>
+#include <common/include/edgeai_infer_scheduler.h>
+
+/**
+ * \defgroup group_edgeai_cascade Cascaded classification
+ *
+ * \brief Second stage classification of the regions found by a detector.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+    using namespace ti::dl_inferer;
+    using namespace ti::pre_process;
+    using namespace ti::post_process;
+
+    /**
+     * \brief Configuration of the second stage classification.
+     *
+     * \ingroup group_edgeai_cascade
+     */
+    struct CascadeConfig
+    {
+        /** Identifier of the classification model. */
+        string              model;
+
+        /** Maximum number of regions classified per inferred frame. */
+        int32_t             maxRois{8};
+
+        /** Classes of the detections to classify. All if empty. */
+        vector<int32_t>     classes;
+
+        /**
+         * Helper function to dump the configuration information.
+         */
+        void dumpInfo() const;
+    };
+
+    /**
+     * \brief Classifies regions of a frame with a second model. Each region
+     *        is cropped from the RGB frame and resized into the input
+     *        tensor of the model, applying the normalization and the layout
+     *        the model expects.
+     *
+     * \ingroup group_edgeai_cascade
+     */
+    class CascadeClassifier
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Cascade configuration
+             * @param inferer Inference object of the classification model
+             * @param preProcCfg Pre-processing configuration of the model
+             * @param postProcCfg Post-processing configuration of the model
+             * @param scheduler Scheduler arbitrating the accelerator. The
+             *                  model is run directly if null.
+             * @param priority Scheduling priority
+             */
+            CascadeClassifier(const CascadeConfig          &config,
+                              DLInferer                    *inferer,
+                              const PreprocessImageConfig  &preProcCfg,
+                              const PostprocessImageConfig &postProcCfg,
+                              InferScheduler               *scheduler,
+                              int32_t                       priority);
+
+            /**
+             * Check if the detections of the given class are classified.
+             *
+             * @param classId Class of the detection
+             */
+            bool isCandidate(int32_t classId) const;
+
+            /**
+             * Maximum number of regions to classify per inferred frame.
+             */
+            int32_t getMaxRois() const
+            {
+                return m_config.maxRois;
+            }
+
+            /**
+             * Classify a region of the frame.
+             *
+             * @param frame Packed RGB frame
+             * @param width Frame width in pixels
+             * @param height Frame height in pixels
+             * @param box Region as x1, y1, x2, y2
+             *
+             * @returns The class identifier, with the label offset applied.
+             *          A negative value on failure.
+             */
+            int32_t run(const uint8_t  *frame,
+                        int32_t         width,
+                        int32_t         height,
+                        const int32_t  *box);
+
+            /**
+             * Returns the name of a class of the classification model.
+             *
+             * @param classId Class identifier returned by run()
+             */
+            string getClassName(int32_t classId) const;
+
+            /** Destructor. */
+            ~CascadeClassifier();
+
+        private:
+            /**
+             * Crop the region from the frame and resize it into the input
+             * tensor.
+             */
+            template <typename T>
+            void cropResize(const uint8_t  *frame,
+                            int32_t         width,
+                            int32_t         height,
+                            const int32_t  *box,
+                            T              *out);
+
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            CascadeClassifier(const CascadeClassifier& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            CascadeClassifier & operator=(const CascadeClassifier& rhs) = delete;
+
+        private:
+            /** Configuration. */
+            CascadeConfig           m_config;
+
+            /** Inference object. */
+            DLInferer              *m_inferer;
+
+            /** Pre-processing configuration of the model. */
+            PreprocessImageConfig   m_preProcCfg;
+
+            /** Post-processing configuration of the model. */
+            PostprocessImageConfig  m_postProcCfg;
+
+            /** Scheduler, may be null. */
+            InferScheduler         *m_scheduler;
+
+            /** Scheduling priority. */
+            int32_t                 m_priority;
+
+            /** Input buffers to the inference. */
+            VecDlTensorPtr          m_inputs;
+
+            /** Output buffers to the inference. */
+            VecDlTensorPtr          m_outputs;
+
+            /** Width of the input tensor. */
+            int32_t                 m_inWidth{0};
+
+            /** Height of the input tensor. */
+            int32_t                 m_inHeight{0};
+
+            /** Set if the input tensor is NCHW, NHWC otherwise. */
+            bool                    m_planar{true};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_CASCADE_H_ */
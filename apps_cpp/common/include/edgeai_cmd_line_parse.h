@@ -39,6 +39,7 @@
 /* Module headers. */
 #include <utils/include/ti_logger.h>
 #include <common/include/edgeai_gst_wrapper.h>
+#include <common/include/edgeai_benchmark.h>
 
 namespace ti::edgeai::common
 {
@@ -63,6 +64,12 @@ namespace ti::edgeai::common
 
             /** Logging level. */
             LogLevel            logLevel{WARN};
+
+            /** Run in the headless benchmark mode. */
+            bool                benchmark{false};
+
+            /** Benchmark configuration. */
+            BenchmarkConfig     benchConfig;
     };
 
 } // namespace ti::edgeai::common
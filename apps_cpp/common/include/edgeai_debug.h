@@ -45,6 +45,9 @@ namespace ti::edgeai::common
 #define EDGEAI_ENABLE_DATA_DUMP_MASK    (EDGEAI_ENABLE_PREPROC_DUMP | \
                                          EDGEAI_ENABLE_INFERENCE_DUMP| \
                                          EDGEAI_ENABLE_POSTPROC_DUMP)
+#define EDGEAI_ENABLE_TENSOR_CAPTURE    (0x8)
+#define EDGEAI_ENABLE_DEBUG_MASK        (EDGEAI_ENABLE_DATA_DUMP_MASK | \
+                                         EDGEAI_ENABLE_TENSOR_CAPTURE)
 
     using std::string;
     namespace fs = std::filesystem;
@@ -35,6 +35,7 @@
 
 /* Module headers. */
 #include <yaml-cpp/yaml.h>
+#include <common/include/edgeai_gst_wrapper.h>
 
 /**
  * \defgroup group_edgeai_common Master demo code
@@ -89,6 +90,13 @@ namespace ti::edgeai::common
              */
             void waitForExit();
 
+            /**
+             * Returns the buffer counters of the input appsinks.
+             *
+             * @param counts Map of appsink names to counters, filled in
+             */
+            void getBufferCounts(map<string, GstPipeBufferCount> &counts);
+
             /** Destructor. */
             ~EdgeAIDemo();
 
@@ -47,7 +47,14 @@
 #include <common/include/post_process_image.h>
 #include <common/include/edgeai_gst_helper.h>
 #include <common/include/edgeai_gstelementmap.h>
+#include <common/include/edgeai_frame_export.h>
+#if defined(EDGEAI_ENABLE_RTSP_SERVER)
+#include <common/include/edgeai_rtsp_server.h>
+#endif // defined(EDGEAI_ENABLE_RTSP_SERVER)
 #include <common/include/edgeai_inference_pipe.h>
+#include <common/include/edgeai_preload_source.h>
+#include <common/include/edgeai_replay_inferer.h>
+#include <common/include/edgeai_infer_scheduler.h>
 /**
  * \defgroup group_edgeai_demo_config Demo configuration processing.
  *
@@ -71,6 +78,19 @@ namespace ti::edgeai::common
         vector<string>         outputs;
         vector<vector<int>>    mosaic_infos;
         vector<string>         debug_infos;
+        int32_t                priority{0};
+        float                  target_fps{0.0f};
+        int32_t                every_nth_frame{1};
+        float                  motion_threshold{0.0f};
+        int32_t                motion_refresh{30};
+        bool                   tracking{false};
+        TrackerConfig          tracker_config;
+        bool                   cascade{false};
+        CascadeConfig          cascade_config;
+        bool                   in_pipeline{false};
+        bool                   postproc_element{false};
+        string                 result_socket;
+        bool                   metadata_only{false};
     };
 
     struct FlowConfig
@@ -156,6 +176,21 @@ namespace ti::edgeai::common
              *
              * @param preProcElementVec  A vector of GST pre-process elements.
              * @param preProcScalerElementVec A vector GST scaler elements.
+             * @param preProcShareVec Per sub-flow, the index of the earlier
+             *                        sub-flow whose pre-processing branch is
+             *                        shared, or -1 for an own branch.
+             * @param preProcDropVec Per sub-flow, only every n-th frame
+             *                       enters its pre-processing branch.
+             * @param inPipelineVec Per sub-flow, set if the inference and
+             *                      the post-processing run in the pipeline.
+             *                      The pre-process elements then end with
+             *                      the inferer and post-process elements
+             *                      instead of an appsink.
+             * @param postProcElemVec Per sub-flow, the post-processing
+             *                        element to insert before the sensor
+             *                        appsink, or nullptr.
+             * @param metadataOnlyVec Per sub-flow, set if only the results
+             *                        are used. No sensor branch is built.
              * @param srcElemNames GST element names used in the source command
              * @param sensorDimVec A vector of dimension for constructing
              *                     the gst resize operation.
@@ -164,6 +199,11 @@ namespace ti::edgeai::common
              */
             int32_t addGstPipeline(vector<vector<GstElement*>>    &preProcElementVec,
                                    vector<vector<GstElement*>>    &preProcScalerElementVec,
+                                   const vector<int32_t>          &preProcShareVec,
+                                   const vector<int32_t>          &preProcDropVec,
+                                   const vector<bool>             &inPipelineVec,
+                                   const vector<GstElement*>      &postProcElemVec,
+                                   const vector<bool>             &metadataOnlyVec,
                                    const vector<string>           &srcElemNames,
                                    const vector<vector<int32_t>>  &sensorDimVec);
 
@@ -241,6 +281,29 @@ namespace ti::edgeai::common
             /** Tee element for flow with this input. */
             vector<GstElement*>                 m_teeElement;
 
+            /** Per sub-flow, index of the sub-flow whose pre-processing
+             * branch is shared, or -1 if the sub-flow has its own branch.
+             */
+            vector<int32_t>                     m_preProcShareVec;
+
+            /** Per sub-flow, only every n-th frame enters the
+             * pre-processing branch.
+             */
+            vector<int32_t>                     m_preProcDropVec;
+
+            /** Per sub-flow, set if the inference and the post-processing
+             * run in the pipeline.
+             */
+            vector<bool>                        m_inPipelineVec;
+
+            /** Per sub-flow, set if only the results are used. */
+            vector<bool>                        m_metadataOnlyVec;
+
+            /** Per sub-flow, tee splitting the pre-processing branch to the
+             * sub-flows sharing it. nullptr if the branch is not shared.
+             */
+            vector<GstElement*>                 m_preProcTeeVec;
+
             /** Vector to hold property of Gst Element. */
             vector<vector<const gchar*>>        m_gstElementProperty;
 
@@ -268,6 +331,18 @@ namespace ti::edgeai::common
             /** Loop file input after EOS. */
             bool                                m_loop{true};
 
+            /** Pace the frames at the appsinks to the pipeline clock. Turned
+             * off to feed file and test inputs as fast as the flows consume
+             * them. Has no effect on live sources.
+             */
+            bool                                m_throttle{true};
+
+            /** Loop the input using segment seeks instead of seeking on EOS.
+             * Set for the sources which can be seeked but have no built-in
+             * looping support.
+             */
+            bool                                m_segmentLoop{false};
+
             /** Pattern for GST videotestsrc. */
             string                              m_pattern{"ball"};
 
@@ -290,6 +365,15 @@ namespace ti::edgeai::common
 
             /** Sensor ID for raw sensor. */
             string                              m_sen_id{"imx219"};
+
+            /** Decode image inputs once and replay them from memory. */
+            bool                                m_preload{false};
+
+            /** Optional raw cache file for the pre-loaded frames. */
+            string                              m_preloadCache{};
+
+            /** Source replaying the pre-loaded frames. */
+            PreloadedImageSource               *m_preloadSrc{nullptr};
     };
 
     /**
@@ -327,6 +411,14 @@ namespace ti::edgeai::common
              */
             int32_t appendGstPipeline();
 
+            /**
+             * Adds the display elements generated by appendGstPipeline()
+             * to the output pipeline and links them, the tees included.
+             *
+             * @param sinkPipeline Output pipeline
+             */
+            void addDispElements(GstElement *sinkPipeline);
+
             /** Construct and return pipeline for creating background buffer.
              *
              * @param sinkPipeline Generated GST pipeline
@@ -361,6 +453,43 @@ namespace ti::edgeai::common
             int32_t registerDispParams(const MosaicInfo    *mosaicInfo, 
                                        const string        &modelTitle);
 
+            /**
+             * Creates the elements of a sink, after the encoder if any.
+             *
+             * @param sink Sink, as in the configuration
+             * @param name Name of the sink element
+             * @param elements Vector receiving the elements
+             *
+             * @returns the encoding the sink takes, "h264" or "jpeg", or an
+             *          empty string for raw frames.
+             */
+            string makeSinkElements(const string           &sink,
+                                    const string           &name,
+                                    vector<GstElement *>   &elements);
+
+            /**
+             * Creates the encoder of an encoding.
+             *
+             * @param codec Encoding, "h264" or "jpeg"
+             * @param elements Vector receiving the elements
+             */
+            void makeEncoderElements(const string          &codec,
+                                     vector<GstElement *>  &elements);
+
+            /**
+             * Appends elements after the display elements or after a branch.
+             *
+             * @param parent Branch to append to, -1 for the display elements
+             * @param tapped Set if the parent ends with a tee, the elements
+             *               then form a new branch starting with a queue
+             * @param elements Elements to append
+             *
+             * @returns the branch the elements were appended to.
+             */
+            int32_t appendDispBranch(int32_t                        parent,
+                                     bool                           tapped,
+                                     const vector<GstElement *>    &elements);
+
             /**
              * Helper function to dump the configuration information.
              *
@@ -381,6 +510,12 @@ namespace ti::edgeai::common
              * - *%Nd*.png   [Image]
              * - *.mp4       [Video]
              * - *.avi       [Video]
+             * - shm                     [Shared memory, see FrameExporter]
+             * - rtsp                    [RTSP server, see RtspServer,
+             *                            if built with the server]
+             *
+             * A list of sinks shares the output, each encoding is done once
+             * for all the sinks taking it.
              *
              *ex:- ../c/d/output_image%02d.jpg
              *      /a/b/c/d/output_image%02d.png
@@ -394,6 +529,9 @@ namespace ti::edgeai::common
              */
             string                          m_sink;
 
+            /** All the sinks of the output, m_sink being the first. */
+            vector<string>                  m_sinks;
+
             /** Sink element name.*/
             vector<string>                  m_sinkElemNames;
 
@@ -420,6 +558,12 @@ namespace ti::edgeai::common
             /** Final Display element for this output. */
             vector<GstElement *>            m_dispElements;
 
+            /** Branches tapping the tees of the display elements. */
+            vector<vector<GstElement *>>    m_dispBranches;
+
+            /** Branch each branch taps, -1 for the display elements. */
+            vector<int32_t>                 m_dispBranchParents;
+
             /** If the Display element has been added to pipeline. */
             bool                            m_dispElementAdded{false};
 
@@ -464,6 +608,24 @@ namespace ti::edgeai::common
              */
             string                          m_overlayPerfType{""};
 
+            /** Socket, ring size and reader policy for shm sink.
+             * This field is ignored for sinks other than shm
+             */
+            FrameExportConfig               m_frameExportConfig;
+
+            /** Frame exporter of the shm sink. */
+            FrameExporter                  *m_frameExporter{nullptr};
+
+#if defined(EDGEAI_ENABLE_RTSP_SERVER)
+            /** Port and path for rtsp sink.
+             * This field is ignored for sinks other than rtsp
+             */
+            RtspServerConfig                m_rtspConfig;
+
+            /** Server of the rtsp sink. */
+            RtspServer                     *m_rtspServer{nullptr};
+#endif // defined(EDGEAI_ENABLE_RTSP_SERVER)
+
             /** Output buffer. */
             GstWrapperBuffer                m_outBuff;
 
@@ -534,6 +696,9 @@ namespace ti::edgeai::common
              *  @param preProcElements Generated GST pre-process element vector
              *  @param preProcScalerElements Generated GST scaler element vector
              *  @param preProcObj Fully constructed pre-process object
+             *  @param makeGstElements Generate the GST elements. Not needed
+             *         when the sub-flow taps the pre-processing branch of
+             *         another sub-flow.
              *
              * @returns 0, if successful. A negative value, otherwise.
              */
@@ -541,7 +706,17 @@ namespace ti::edgeai::common
                                        const DebugDumpConfig   &debugConfig,
                                        vector<GstElement *>    &preProcElements,
                                        vector<GstElement *>    &preProcScalerElements,
-                                       PreprocessImage        *&preProcObj);
+                                       PreprocessImage        *&preProcObj,
+                                       bool                     makeGstElements = true);
+
+            /**
+             * Returns the key identifying the GST pre-processing branch this
+             * model needs for the given input. Sub-flows of one input with
+             * the same key can share a single branch.
+             *
+             *  @param inputInfo Input information object
+             */
+            string getPreProcKey(const InputInfo &inputInfo);
 
             /** Function for creating and returning a post-processor object
              *  from the given output and mosaic information objects.
@@ -558,6 +733,40 @@ namespace ti::edgeai::common
                                        const int32_t           sensorHeight,
                                        PostprocessImage       *&postProcObj);
 
+            /**
+             * Checks if the given model entry runs the same model with the
+             * same pre and post-processing settings. Flows from one input
+             * using equivalent entries can share a single inference.
+             *
+             * @param other Model entry to compare against
+             *
+             * @returns true if the entries are equivalent, false otherwise.
+             */
+            bool isEquivalent(const ModelInfo &other) const;
+
+            /**
+             * Moves the model to the given C7x cores, one replica per core.
+             * The inference objects are only re-created if the set of cores
+             * differs from the current one. Must be called before the flows
+             * using the model are set up.
+             *
+             * @param coreIds Cores to run the replicas on
+             *
+             * @returns 0, if successful. A negative value, otherwise.
+             */
+            int32_t setCores(const vector<int32_t> &coreIds);
+
+            /**
+             * Measures the inference time of the model by running it on
+             * dummy input tensors.
+             *
+             * @param numRuns Number of timed runs, after one warm-up run
+             *
+             * @returns Mean inference time in milliseconds, a negative
+             *          value if the inference failed.
+             */
+            float measureInferTime(int32_t numRuns);
+
             /**
              * Helper function to dump the configuration information.
              *
@@ -566,6 +775,15 @@ namespace ti::edgeai::common
             void dumpInfo(const char *prefix="") const;
 
         private:
+            /**
+             * Creates the inference object, with one replica per entry in
+             * m_coreIds on the DSP target. The cores are assigned round
+             * robin if m_coreIds is empty.
+             *
+             * @returns 0, if successful. A negative value, otherwise.
+             */
+            int32_t createInferer();
+
             /**
              * Copy Constructor.
              *
@@ -606,6 +824,28 @@ namespace ti::edgeai::common
 
             /** Number of classification results to pick from the top of the model output. */
             int32_t                 m_topN{5};
+
+            /** Replay backend configuration. Only valid if m_replay is set. */
+            ReplayInfererConfig     m_replayCfg;
+
+            /** Flag to replay recorded outputs instead of running the model. */
+            bool                    m_replay{false};
+
+            /** Flag set if the model is only run by tidlinferer elements of
+             * the pipelines. No inference object is created then.
+             */
+            bool                    m_inPipelineOnly{false};
+
+            /** Number of instances of the model, each on its own C7x core. */
+            int32_t                 m_replicas{1};
+
+            /** Inference time in milliseconds, used to place the model on
+             * the C7x cores. Measured at startup if not given.
+             */
+            float                   m_inferTime{0.0f};
+
+            /** C7x cores running the replicas. */
+            vector<int32_t>         m_coreIds;
     };
 
     /**
@@ -627,10 +867,13 @@ namespace ti::edgeai::common
              * @param inferPipe InferencePipe object.
              * @param preProcObj Pre-process object
              * @param postProcObj Post-process object
+             * @param postProcElement Post-process element, if the
+             *        post-processing runs in the pipeline
              */
             SubFlowInfo(InferencePipe      *inferPipe,
                         PreprocessImage    *preProcObj,
-                        PostprocessImage   *postProcObj);
+                        PostprocessImage   *postProcObj,
+                        PostprocElement    *postProcElement = nullptr);
 
             /** Destructor. */
             ~SubFlowInfo();
@@ -680,6 +923,11 @@ namespace ti::edgeai::common
             /** Post-processing context. */
             PostprocessImage           *m_postProcObj{nullptr};
 
+            /** Post-processing element. Only valid if the post-processing
+             * runs in the source pipeline.
+             */
+            PostprocElement            *m_postProcElement{nullptr};
+
             /** List of display information. */
             MosaicInfo                 *m_mosaicInfo{nullptr};
 
@@ -730,12 +978,16 @@ namespace ti::edgeai::common
              * @param modelMap Map of the models initialized prior to this call
              * @param inputMap Map of the inputs initialized prior to this call
              * @param outputMap Map of the outputs initialized prior to this call
+             * @param schedulerMap Map of the inference schedulers, shared
+             *                     across the flows. New entries are added
+             *                     for the accelerators not seen before.
              *
              * @returns 0, if successful. A negative value, otherwise.
              */
-            int32_t initialize(map<string, ModelInfo*>   &modelMap,
-                               map<string, InputInfo*>   &inputMap,
-                               map<string, OutputInfo*>  &outputMap);
+            int32_t initialize(map<string, ModelInfo*>       &modelMap,
+                               map<string, InputInfo*>       &inputMap,
+                               map<string, OutputInfo*>      &outputMap,
+                               map<string, InferScheduler*>  &schedulerMap);
 
             /** Construct and return a output pipeline associated with all the
              *  outputs in this flow.
@@ -806,6 +1058,11 @@ namespace ti::edgeai::common
             /** Input frame rate. */
             string                              m_framerate{0};
 
+            /** Drop the frames the outputs are too slow to take, instead of
+             * blocking until they do. Follows the drop setting of the input.
+             */
+            bool                                m_dropLateFrames{false};
+
             /** Instance Id for a specific instance. */
             int32_t                             m_instId;
 
@@ -842,6 +1099,21 @@ namespace ti::edgeai::common
             /** Destructor. */
             ~DemoConfig();
 
+            /**
+             * Initializes the given models. On the DSP target with more
+             * than one C7x core, the models are then spread over the cores
+             * by their load, the inference time times the number of
+             * sub-flows running the model. The inference time is measured
+             * unless given in the configuration. Replicas of a model are
+             * kept on separate cores. Only the models to be timed get an
+             * inference object before they are placed.
+             *
+             * @param modelIds Names of the models used by the flows
+             *
+             * @returns 0, if successful. A negative value, otherwise.
+             */
+            int32_t initializeModels(const set<string> &modelIds);
+
             /** Dump configuration. */
             void dumpInfo() const;
 
@@ -858,9 +1130,19 @@ namespace ti::edgeai::common
             /** Map of all flows defined. */
             map<string, FlowInfo*>      m_flowMap;
 
+            /** Inference schedulers, per accelerator core or shared model. */
+            map<string, InferScheduler*> m_schedulerMap;
+
+            /** Report the latency of every GST element. */
+            bool                        m_elementLatency{false};
+
         private:
             /** Vector of input order. */
             vector<string>              m_inputOrder;
+
+            /** Model names mapped to the first equivalent model entry. */
+            map<string, string>         m_modelAlias;
+
             /** Function for parsing the flow information.
              */
             int32_t parseFlowInfo(const YAML::Node &config);
@@ -0,0 +1,338 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_FRAME_EXPORT_H_
+#define _TI_EDGEAI_FRAME_EXPORT_H_
+
+/* Standard headers. */
+#include <string>
+#include <vector>
+
+/* Third-party headers. */
+#include <gst/gst.h>
+
+/**
+ * \defgroup group_edgeai_frame_export Frame export
+ *
+ * \brief Shares the output frames with other processes on the same host,
+ *        through a shared memory ring, without encoding them.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+#define FRAME_EXPORT_MAGIC      (0x46494145) /* "EAIF" */
+#define FRAME_EXPORT_VERSION    (1)
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief First message sent to a reader after it connects. It carries
+     *        the memfd of the ring as SCM_RIGHTS ancillary data. The ring
+     *        holds numSlots slots of slotSize bytes, mapped read-only by
+     *        the reader. All the fields are in the host byte order.
+     *
+     * \ingroup group_edgeai_frame_export
+     */
+    struct FrameExportHello
+    {
+        /** FRAME_EXPORT_MAGIC. */
+        uint32_t    magic;
+
+        /** FRAME_EXPORT_VERSION. */
+        uint16_t    version;
+
+        /** Number of slots in the ring. */
+        uint16_t    numSlots;
+
+        /** Size of a slot in bytes. */
+        uint32_t    slotSize;
+
+        /** Pixel format as a fourcc, NV12. */
+        uint32_t    format;
+
+        /** Frame width. */
+        uint16_t    width;
+
+        /** Frame height. */
+        uint16_t    height;
+
+        /** Reserved. */
+        uint32_t    reserved;
+    };
+
+    /**
+     * \brief Message announcing a frame written to a slot. It is followed
+     *        by resultSize bytes holding the result record of the frame
+     *        (see edgeai_result_export.h), if the frame carries results.
+     *
+     *        The reader owns the slot until it sends the slot index back,
+     *        as a uint32_t message. The slot is not reused before every
+     *        reader it was sent to has released it.
+     *
+     * \ingroup group_edgeai_frame_export
+     */
+    struct FrameExportRecord
+    {
+        /** FRAME_EXPORT_MAGIC. */
+        uint32_t    magic;
+
+        /** Index of the slot holding the frame. */
+        uint16_t    slot;
+
+        /** Reserved. */
+        uint16_t    reserved;
+
+        /** Size of the frame in bytes. */
+        uint32_t    size;
+
+        /** Size of the result record following the message, 0 if none. */
+        uint32_t    resultSize;
+
+        /** Frame number. */
+        uint64_t    frameId;
+
+        /** Presentation timestamp of the frame in nanoseconds. */
+        uint64_t    timestamp;
+    };
+
+    static_assert(sizeof(FrameExportHello) == 24, "Unexpected message layout");
+    static_assert(sizeof(FrameExportRecord) == 32, "Unexpected message layout");
+
+    /**
+     * \brief Configuration of a frame exporter.
+     *
+     * \ingroup group_edgeai_frame_export
+     */
+    struct FrameExportConfig
+    {
+        /** Path of the seqpacket socket the readers connect to. */
+        string      path{"/tmp/edgeai_frames.sock"};
+
+        /** Number of slots in the ring. */
+        int32_t     numSlots{4};
+
+        /** Wait for a slot to be released instead of dropping the frame
+         * when all of them are held by the readers.
+         */
+        bool        block{false};
+
+        /** Longest wait for a slot in milliseconds when blocking, the
+         * frame is dropped after that.
+         */
+        int32_t     blockTimeout{100};
+
+        /** Frame width. */
+        int32_t     width{0};
+
+        /** Frame height. */
+        int32_t     height{0};
+
+        /**
+         * Helper function to dump the configuration information.
+         */
+        void dumpInfo() const;
+    };
+
+    /**
+     * \brief Exports the frames reaching an "edgeaishmsink" element to the
+     *        processes connected to a Unix seqpacket socket.
+     *
+     *        Each frame is copied once into a free slot of a memfd backed
+     *        ring, shared with every reader when it connects, and announced
+     *        to the readers with a FrameExportRecord. The results attached
+     *        to the frame as a ResultMeta travel with it.
+     *
+     *        A reader holds at most all the slots but one. Frames are not
+     *        sent to a reader at that limit or with a full socket, and are
+     *        dropped altogether if no slot is free, unless blocking is
+     *        configured. The socket is only created when the pipeline
+     *        starts.
+     *
+     * \ingroup group_edgeai_frame_export
+     */
+    class FrameExporter
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Exporter configuration
+             * @param name Name of the element
+             */
+            FrameExporter(const FrameExportConfig  &config,
+                          const string             &name);
+
+            /** Returns the sink element, to be added to the pipeline. */
+            GstElement *getElement();
+
+            /**
+             * Creates the listening socket. Called when the element
+             * starts.
+             *
+             * @returns 0 on success, a negative value otherwise.
+             */
+            int32_t start();
+
+            /**
+             * Disconnects the readers and releases the ring. Called when
+             * the element stops.
+             */
+            void stop();
+
+            /**
+             * Exports a frame. Called from the streaming thread.
+             *
+             * @param buffer Frame
+             *
+             * @returns 0 if the frame was exported or dropped, a negative
+             *          value on failure.
+             */
+            int32_t render(GstBuffer *buffer);
+
+            /** Registers the "edgeaishmsink" element type, once. */
+            static int32_t registerElement();
+
+            /** Destructor. */
+            ~FrameExporter();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            FrameExporter(const FrameExporter& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            FrameExporter & operator=(const FrameExporter& rhs) = delete;
+
+            /** Reader connection. */
+            struct Reader
+            {
+                /** Socket descriptor. */
+                int32_t         socket;
+
+                /** Slots sent to the reader and not released yet. */
+                vector<bool>    held;
+
+                /** Number of slots held. */
+                int32_t         numHeld;
+            };
+
+            /**
+             * Creates the ring, sized for the given frame.
+             *
+             * @param size Frame size in bytes
+             */
+            int32_t createRing(uint64_t size);
+
+            /** Unmaps and closes the ring. */
+            void releaseRing();
+
+            /** Accepts the pending readers and sends them the ring. */
+            void acceptReaders();
+
+            /**
+             * Processes the slots released by the readers.
+             *
+             * @param timeout Longest wait for a release in milliseconds,
+             *                0 to only process the pending ones
+             */
+            void collectReleases(int32_t timeout);
+
+            /**
+             * Closes a reader connection and releases its slots.
+             *
+             * @param idx Index of the reader
+             */
+            void dropReader(uint64_t idx);
+
+            /** Returns a free slot, or -1 if all of them are held. */
+            int32_t findFreeSlot() const;
+
+        private:
+            /** Configuration. */
+            FrameExportConfig   m_config;
+
+            /** Sink element. */
+            GstElement         *m_element{nullptr};
+
+            /** Listening socket descriptor. */
+            int32_t             m_socket{-1};
+
+            /** Ring memfd. */
+            int32_t             m_ringFd{-1};
+
+            /** Ring mapping. */
+            uint8_t            *m_ring{nullptr};
+
+            /** Size of a slot in bytes, 0 until the ring is created. */
+            uint64_t            m_slotSize{0};
+
+            /** Number of readers holding each slot. */
+            vector<int32_t>     m_slotRefs;
+
+            /** Slot to start looking for a free one from. */
+            int32_t             m_nextSlot{0};
+
+            /** Connected readers. */
+            vector<Reader>      m_readers;
+
+            /** Result record of the frame being exported. */
+            vector<uint8_t>     m_record;
+
+            /** Number of frames rendered. */
+            uint64_t            m_frameCnt{0};
+
+            /** Number of frames exported. */
+            uint64_t            m_sentCnt{0};
+
+            /** Number of frames dropped for lack of a free slot. */
+            uint64_t            m_dropCnt{0};
+
+            /** Number of frames not sent to a reader lagging behind. */
+            uint64_t            m_readerDropCnt{0};
+
+            /** Number of frames dropped for not fitting a slot. */
+            uint64_t            m_oversizeCnt{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_FRAME_EXPORT_H_ */
@@ -35,8 +35,18 @@
 
 #define EOS 1
 
+/** Number of frames an output appsrc queues before it reports being full. */
+#define GST_PIPE_SINK_QUEUE_DEPTH 2
+
+/** Default period of the queue telemetry, in milliseconds. */
+#define GST_PIPE_TELEMETRY_PERIOD_MS 1000
+
 /* Standard headers. */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
 #include <string>
+#include <thread>
 #include <vector>
 #include <map>
 #include <mutex>
@@ -129,6 +139,157 @@ namespace ti::edgeai::common
             int32_t     height{0};
     };
 
+    /**
+     * \brief Snapshot of the buffer counters of an appsink.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeBufferCount
+    {
+        /** Buffers that reached the appsink. */
+        uint64_t    received{0};
+
+        /** Buffers pulled from the appsink through getBuffer(). */
+        uint64_t    pulled{0};
+    };
+
+    /**
+     * \brief Live buffer counters of an appsink.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeCounter
+    {
+        /** Buffers that reached the appsink. */
+        atomic<uint64_t>    received{0};
+
+        /** Buffers pulled from the appsink through getBuffer(). */
+        atomic<uint64_t>    pulled{0};
+    };
+
+    /**
+     * \brief Snapshot of the counters of a queue element.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeQueueStat
+    {
+        /** Buffers in the queue. */
+        uint32_t    level{0};
+
+        /** Set if the queue drops buffers when full. */
+        bool        leaky{false};
+
+        /** Buffers dropped by the queue. Only counted for leaky queues. */
+        uint64_t    dropped{0};
+    };
+
+    /**
+     * \brief Live counters of a queue element.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeQueueCounter
+    {
+        /** The queue element. */
+        GstElement         *elem{nullptr};
+
+        /** Set if the queue drops buffers when full. */
+        bool                leaky{false};
+
+        /** Buffers dropped by the queue, counted from its overrun signal. */
+        atomic<uint64_t>    dropped{0};
+    };
+
+    /**
+     * \brief Latency probe state of a GST element. The buffers entering
+     *        the element are matched by PTS with the ones leaving it.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeElemProbe
+    {
+        /** Name of the element instance. */
+        string                              name;
+
+        /** PTS and arrival time in nanoseconds of the buffers inside the
+         * element, oldest first.
+         */
+        deque<pair<GstClockTime, int64_t>>  pending;
+
+        /** Time spent in the element by the buffers matched since the
+         * last report, in nanoseconds.
+         */
+        int64_t                             totalNs{0};
+
+        /** Number of buffers matched since the last report. */
+        uint64_t                            count{0};
+
+        /** Lock for the above, the pads may be served by different threads. */
+        mutex                               lock;
+    };
+
+    /**
+     * \brief Handle bound to an appsink of the source pipelines. Returned
+     *        by GstPipe::getSrcHandle() at setup and passed to getBuffer()
+     *        for every frame, avoiding the element lookup by name. The caps
+     *        of the frames are only parsed again when they change.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeSrcHandle
+    {
+        /** Name of the appsink element. */
+        string              name;
+
+        /** The appsink element. */
+        GstElement         *elem{nullptr};
+
+        /** Buffer counters of the appsink. */
+        GstPipeCounter     *counter{nullptr};
+
+        /** Caps of the last frame pulled from the appsink. */
+        GstCaps            *inCaps{nullptr};
+
+        /** Caps attached to the frames returned, derived from inCaps. */
+        GstCaps            *caps{nullptr};
+
+        /** Width of the frames. */
+        int32_t             width{0};
+
+        /** Height of the frames. */
+        int32_t             height{0};
+
+        /** Format of the frames. */
+        string              format;
+    };
+
+    /**
+     * \brief Handle bound to an output appsrc. Returned by
+     *        GstPipe::getSinkHandle() at setup and passed to putBuffer()
+     *        for every frame. The queue state is updated from the need-data
+     *        and enough-data signals of the appsrc.
+     *
+     * \ingroup group_edgeai_common
+     */
+    struct GstPipeSinkHandle
+    {
+        /** Name of the appsrc element. */
+        string              name;
+
+        /** The appsrc element. */
+        GstElement         *elem{nullptr};
+
+        /** Set if the caps are fixed on the appsrc. */
+        bool                fixedCaps{false};
+
+        /** Set once the queue is bounded to GST_PIPE_SINK_QUEUE_DEPTH frames. */
+        bool                bounded{false};
+
+        /** Set while the queue is full, cleared when it asks for data. */
+        atomic<bool>        full{false};
+    };
+
     /**
      * \brief Main class that wraps the gstreamer functionality.
      *
@@ -149,11 +310,16 @@ namespace ti::edgeai::common
              *        elements based on the information in the sinkCmd string.
              *        It is the responsibility of the caller to make sure that
              *        the information in sinkCmd and sinkElemNames is consistent.
+             * @param srcLoop Optional vector, parallel to srcPipelines, marking
+             *        the source pipelines that should be looped using segment
+             *        seeks. Such pipelines wrap around at the end of the stream
+             *        without an EOS and without flushing the pipeline.
              */
             GstPipe(vector<GstElement*>      &srcPipelines,
                     GstElement*              &sinkPipeline,
                     vector<vector<string>>   &srcElemNames,
-                    vector<string>           &sinkElemNames);
+                    vector<string>           &sinkElemNames,
+                    const vector<bool>       &srcLoop = {});
 
             /**
              * Start all the GST pipelines by setting the state to playing
@@ -177,7 +343,27 @@ namespace ti::edgeai::common
                               bool             readonly);
 
             /**
-             * Try to push a buffer to the appsrc element
+             * Same as above, for an appsink bound at setup.
+             *
+             * @param handle Handle returned by getSrcHandle()
+             * @param buff Pointer to GstWrapperBuffer which holds the address at which the
+             *          buffer is mapped, widh, height and reference to Gstreamer objects.
+             * @param loop Seek the input to start after receiving EOS
+             * @param readonly Map the buffer as readonly
+             * @returns 0 if successful
+             */
+            int32_t getBuffer(GstPipeSrcHandle *handle,
+                              GstWrapperBuffer &buff,
+                              bool             loop,
+                              bool             readonly);
+
+            /**
+             * Try to push a buffer to the appsrc element. If the appsrc has
+             * fixed caps, only the GstBuffer is pushed and the caps of the
+             * sample are ignored. The queue of the appsrc is bounded to
+             * GST_PIPE_SINK_QUEUE_DEPTH frames of the size of the first
+             * buffer pushed.
+             *
              * @param name Name of the appsrc element
              * @param buff Pointer to GstWrapperBuffer which holds the address at which the
              *          buffer is mapped, widh, height and reference to Gstreamer objects.
@@ -186,6 +372,17 @@ namespace ti::edgeai::common
             int32_t putBuffer(const string     &name,
                               GstWrapperBuffer &buff);
 
+            /**
+             * Same as above, for an appsrc bound at setup.
+             *
+             * @param handle Handle returned by getSinkHandle()
+             * @param buff Pointer to GstWrapperBuffer which holds the address at which the
+             *          buffer is mapped, widh, height and reference to Gstreamer objects.
+             * @returns 0 if successful
+             */
+            int32_t putBuffer(GstPipeSinkHandle    *handle,
+                              GstWrapperBuffer     &buff);
+
             /**
              * Try to send EOS signal to the appsrc element
              * @param name Name of the appsrc element
@@ -193,6 +390,54 @@ namespace ti::edgeai::common
              */
             int32_t sendEOS(const string     &name);
 
+            /**
+             * Same as above, for an appsrc bound at setup.
+             *
+             * @param handle Handle returned by getSinkHandle()
+             * @returns 0 if successful
+             */
+            int32_t sendEOS(GstPipeSinkHandle  *handle);
+
+            /**
+             * Check if the appsrc element can take a buffer without growing
+             * its queue beyond the bound, ie. if the downstream elements
+             * (ex:- display, encoder) keep up.
+             *
+             * @param name Name of the appsrc element
+             * @returns false if the queue of the appsrc is full, true
+             *          otherwise or if the element is not known
+             */
+            bool isSinkReady(const string &name);
+
+            /**
+             * Same as above, for an appsrc bound at setup.
+             *
+             * @param handle Handle returned by getSinkHandle()
+             * @returns false if the queue of the appsrc is full
+             */
+            bool isSinkReady(const GstPipeSinkHandle *handle)
+            {
+                return !handle->full;
+            }
+
+            /**
+             * Bind an appsink of the source pipelines. The handle is owned
+             * by the GstPipe object and valid until it is destroyed.
+             *
+             * @param name Name of the appsink element
+             * @returns Handle or nullptr if the element is not known
+             */
+            GstPipeSrcHandle *getSrcHandle(const string &name);
+
+            /**
+             * Bind an output appsrc. The handle is owned by the GstPipe
+             * object and valid until it is destroyed.
+             *
+             * @param name Name of the appsrc element
+             * @returns Handle or nullptr if the element is not known
+             */
+            GstPipeSinkHandle *getSinkHandle(const string &name);
+
             /**
              * Create a new GstBuffer with backing memory allocation as well.
              * This will calculate the memory size in bytes and allocate storage for it.
@@ -227,6 +472,50 @@ namespace ti::edgeai::common
             /* Dump m_srcPipe and m_sinkPipe as dot files */
             void dumpDot();
 
+            /**
+             * Returns the buffer counters of every appsink in the source
+             * pipelines. The difference between the buffers received and
+             * pulled, beyond the appsink queue depth, is the number of
+             * frames dropped at the appsink.
+             *
+             * @param counts Map of appsink names to counters, filled in
+             */
+            void getBufferCounts(map<string, GstPipeBufferCount> &counts);
+
+            /**
+             * Install buffer probes on the pads of every element of the
+             * pipelines, except the sources and sinks, and accumulate the
+             * time each buffer spends in the element. The mean over each
+             * telemetry period is reported by the thread started with
+             * startTelemetry(), through Statistics::reportElementTime(),
+             * so that the streaming threads take no shared lock. The time
+             * is reported as
+             * queueing for the queue elements and as processing for the
+             * others. Buffers are matched by PTS, so that nothing is
+             * reported for the elements which change it (ex:- encoders).
+             * Must be called before the pipelines are started.
+             */
+            void enableLatencyProbes();
+
+            /**
+             * Returns the counters of every queue element of the pipelines.
+             * The queues serving a single flow are named "flowN/<queue>",
+             * the ones shared by several flows keep their element name.
+             *
+             * @param stats Map of queue names to counters, filled in
+             */
+            void getQueueStats(map<string, GstPipeQueueStat> &stats);
+
+            /**
+             * Start sampling the level of every queue element and the
+             * buffers the leaky ones drop, in a thread of its own. The
+             * samples are reported through Statistics::reportElementMetric().
+             * The sampling stops when the object is destroyed.
+             *
+             * @param periodMs Sampling period in milliseconds
+             */
+            void startTelemetry(uint32_t periodMs = GST_PIPE_TELEMETRY_PERIOD_MS);
+
             /** Destructor. */
             ~GstPipe();
 
@@ -246,17 +535,67 @@ namespace ti::edgeai::common
             /** A map of sink element names to GST elements. */
             map<string,GstElement*> m_sinkElemMap;
 
+            /** A map of source element names to buffer counters. */
+            map<string,GstPipeCounter*> m_srcCounters;
+
+            /** A map of queue names, prefixed by their flow, to counters. */
+            map<string,GstPipeQueueCounter*> m_queueCounters;
+
+            /** Queue telemetry thread. */
+            thread                  m_telemetryThread;
+
+            /** Set while the queue telemetry runs. */
+            bool                    m_telemetryRunning{false};
+
+            /** Lock and condition for stopping the queue telemetry. */
+            mutex                   m_telemetryMutex;
+            condition_variable      m_telemetryCv;
+
+            /** Latency probe states, if enabled. */
+            vector<GstPipeElemProbe*>   m_elemProbes;
+
+            /** A map of source element names to appsink handles. */
+            map<string,GstPipeSrcHandle*> m_srcHandles;
+
+            /** A map of sink element names to appsrc handles. */
+            map<string,GstPipeSinkHandle*> m_sinkHandles;
+
             /** Reference to the gstreamer pipeline responsible for the input
              * (ex:- sensor, file).
              */
             vector<GstElement *>    m_srcPipe;
 
+            /** Flags marking the source pipelines in m_srcPipe that loop
+             * using segment seeks.
+             */
+            vector<bool>            m_srcLoop;
+
             /** Reference to the gstreamer pipeline responsible for the output
              * (ex:- display).
              */
             GstElement             *m_sinkPipe{nullptr};
 
         private:
+            /**
+             * Pre-roll a source pipeline and issue the initial flushing
+             * segment seek. From then on, the pipeline posts a SEGMENT_DONE
+             * message instead of EOS at the end of the stream and a
+             * non-flushing segment seek back to the start is issued from the
+             * bus sync handler. The frames keep flowing across the wrap
+             * without draining or flushing the downstream elements.
+             *
+             * @param pipeline Source pipeline to loop
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t startSegmentLoop(GstElement *pipeline);
+
+            /**
+             * Queue telemetry loop, see startTelemetry().
+             *
+             * @param periodMs Sampling period in milliseconds
+             */
+            void telemetryLoop(uint32_t periodMs);
+
             /**
              * From an Gstreamer pipeline, find a reference to a named element
              * Note that the pipeline should have specified a name for the desired element
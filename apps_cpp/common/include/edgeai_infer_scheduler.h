@@ -0,0 +1,157 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_INFER_SCHEDULER_H_
+#define _TI_EDGEAI_INFER_SCHEDULER_H_
+
+/* Standard headers. */
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <set>
+
+/* Module headers. */
+#include <edgeai_dl_inferer/ti_dl_inferer.h>
+
+/** Returned by InferScheduler::run() when the request was shed. */
+#define INFER_SCHED_SHED        1
+
+/**
+ * \defgroup group_edgeai_infer_scheduler Inference scheduling
+ *
+ * \brief Priority based admission of the inference requests of the flows
+ *        sharing an accelerator.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+    using namespace ti::dl_inferer;
+
+    /**
+     * \brief Schedules the inference requests of the flows sharing an
+     *        accelerator. A request runs as soon as one of the slots is
+     *        free and no request of a higher priority is waiting. Under
+     *        contention, a sheddable request is dropped right away if a
+     *        request of a higher priority is running or waiting, instead
+     *        of adding to the latency of the more important flows.
+     *
+     *        If all the users have the same priority the requests go
+     *        straight to the inferer.
+     *
+     * \ingroup group_edgeai_infer_scheduler
+     */
+    class InferScheduler
+    {
+        public:
+            /** Constructor.
+             *
+             * @param numSlots Number of requests the accelerator runs at
+             *                 the same time
+             */
+            InferScheduler(int32_t numSlots);
+
+            /**
+             * Register a user of the scheduler. All the users must be
+             * registered before the first request.
+             *
+             * @param priority Priority of the user, higher is more important
+             */
+            void addUser(int32_t priority);
+
+            /**
+             * Run an inference request, waiting for its turn.
+             *
+             * @param inferer Inference context to run
+             * @param priority Priority of the request
+             * @param sheddable Flag to allow dropping the request
+             * @param inputs Input tensors
+             * @param outputs Output tensors
+             *
+             * @returns The inferer status, or INFER_SCHED_SHED if the request
+             *          was dropped without running.
+             */
+            int32_t run(DLInferer             *inferer,
+                        int32_t                priority,
+                        bool                   sheddable,
+                        const VecDlTensorPtr  &inputs,
+                        VecDlTensorPtr        &outputs);
+
+            /** Destructor. */
+            ~InferScheduler();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            InferScheduler(const InferScheduler& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            InferScheduler & operator=(const InferScheduler& rhs) = delete;
+
+        private:
+            /** Number of requests run at the same time. */
+            uint32_t                                m_numSlots;
+
+            /** Lowest priority of the users. */
+            int32_t                                 m_minPriority;
+
+            /** Highest priority of the users. */
+            int32_t                                 m_maxPriority;
+
+            /** Priorities of the running requests. */
+            multiset<int32_t, greater<int32_t>>     m_running;
+
+            /** Number of waiting requests, per priority. */
+            map<int32_t, int32_t, greater<int32_t>> m_waiting;
+
+            /** Lock for the request state. */
+            mutex                                   m_mutex;
+
+            /** Signalled when a request completes. */
+            condition_variable                      m_cv;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_INFER_SCHEDULER_H_ */
@@ -41,6 +41,11 @@
 #include <common/include/pre_process_image.h>
 #include <common/include/post_process_image.h>
 #include <common/include/edgeai_gst_wrapper.h>
+#include <common/include/edgeai_tensor_capture.h>
+#include <common/include/edgeai_infer_scheduler.h>
+#include <common/include/edgeai_motion_detect.h>
+#include <common/include/edgeai_postproc_element.h>
+#include <common/include/edgeai_result_export.h>
 
 /**
  * \defgroup group_edgeai_common Master demo code
@@ -94,6 +99,82 @@ namespace ti::edgeai::common
         /** Optional debugging control configuration. */
         DebugDumpConfig     debugConfig;
 
+        /** Path to the tensor capture file. The inference inputs and
+         * outputs of the frames between debugConfig.startFrame and
+         * debugConfig.endFrame are recorded to it. Capture is disabled if
+         * empty.
+         */
+        string              captureFile;
+
+        /** Scheduler arbitrating the accelerator with the other flows.
+         * The inferer is run directly if not set.
+         */
+        InferScheduler     *scheduler{nullptr};
+
+        /** Scheduling priority, higher is more important. */
+        int32_t             priority{0};
+
+        /** Inference rate in frames per second below which the frames of
+         * this flow are not shed by the scheduler. 0 to always allow
+         * shedding if the priority is not the highest.
+         */
+        float               targetFps{0.0f};
+
+        /** Only every n-th input frame is inferred. The other frames are
+         * displayed with the results of the last inferred frame.
+         */
+        int32_t             everyNthFrame{1};
+
+        /** Only every n-th input frame reaches the pre-processing appsink,
+         * the others are dropped upstream. Must divide everyNthFrame.
+         */
+        int32_t             preProcInterval{1};
+
+        /** Mean absolute luma difference, in the 0-255 range, to the last
+         * inferred frame below which a frame is not inferred and displayed
+         * with the last results. Motion gating is disabled if 0.
+         */
+        float               motionThreshold{0.0f};
+
+        /** Maximum number of consecutive frames skipped by motion gating. */
+        int32_t             motionRefresh{30};
+
+        /** Set if the inference and the post-processing run inside the
+         * GST pipeline. The frames from the sensor appsink are then
+         * already post-processed and are only forwarded to the output.
+         */
+        bool                inPipeline{false};
+
+        /** Post-processing element drawing the results in the source
+         * pipeline. The frames from the sensor appsink are then only
+         * forwarded to the output, while the inference thread hands the
+         * results over to the element. The post-processing runs in the
+         * inference thread if not set.
+         */
+        PostprocElement    *postProcElement{nullptr};
+
+        /** Path of the Unix socket the decoded results of every frame are
+         * published to. Publishing is disabled if empty.
+         */
+        string              resultSocket;
+
+        /** Set if an output reads the decoded results from the buffer
+         * meta. The meta is not attached otherwise.
+         */
+        bool                exportResults{false};
+
+        /** Set if only the decoded results are used. The sensor frames are
+         * then neither pulled, drawn on nor sent to an output.
+         */
+        bool                metadataOnly{false};
+
+        /** Set if the frames the output is too slow to take are dropped.
+         * The results of such frames are still decoded and published, but
+         * not drawn. The output blocks the flow until it takes the frame
+         * otherwise.
+         */
+        bool                dropLateFrames{false};
+
         /**
          * Helper function to dump the configuration information.
          */
@@ -129,12 +210,15 @@ namespace ti::edgeai::common
                           const string                 &sinkElemName);
 
             /** Function to register the gstPipe with the inference pipe and
-             * start the execution.
+             * start the execution. The appsink and appsrc elements used are
+             * bound once here.
              *
              * @param gstPipe GST pipe context containing the full set of the
              *        source and sink command string completely specified.
+             *
+             * @returns 0, if successful. A negative value, otherwise.
              */
-            void start(GstPipe   *gstPipe);
+            int32_t start(GstPipe   *gstPipe);
 
             /**
              * Sets a flag for the threads to exit at the next opportunity.
@@ -196,7 +280,8 @@ namespace ti::edgeai::common
              *
              * @param inVecVar A vector of input buffers.
              * @param outVecVar vector of output buffers.
-             * @returns zero on success, non-zero on failure
+             * @returns zero on success, INFER_SCHED_SHED if the scheduler
+             *          dropped the frame, non-zero on failure
              */
             int runModel(const VecDlTensorPtr &inVecVar, VecDlTensorPtr &outVecVar);
 
@@ -207,6 +292,19 @@ namespace ti::edgeai::common
              */
             void inferenceThread();
 
+            /**
+             * Function which forwards the post-processed frames of an
+             * in-pipeline sub-flow, or of a sub-flow post-processed by a
+             * GST element, from the source to the sink pipeline.
+             */
+            void forwardThread();
+
+            /**
+             * Report the rate of the frames dropped at the appsinks of the
+             * flow, at most once per second. Called for every frame.
+             */
+            void reportInputDrops();
+
             /**
              * Function which runs the capture -> display pipeline in a loop
              * Get the original camera buffer from Gstreamer, perform post processing with
@@ -245,6 +343,15 @@ namespace ti::edgeai::common
             /** Name for gstreamer appsrc on the sink side. */
             const string            m_sinkElemName;
 
+            /** Handle of the sensor appsink, m_srcElemNames[0]. */
+            GstPipeSrcHandle       *m_sensorSrc{nullptr};
+
+            /** Handle of the pre-processing appsink, m_srcElemNames[1]. */
+            GstPipeSrcHandle       *m_preProcSrc{nullptr};
+
+            /** Handle of the appsrc on the sink side. */
+            GstPipeSinkHandle      *m_sink{nullptr};
+
             /** Number of inputs from the inference processing. */
             int32_t                 m_numInputs;
 
@@ -254,12 +361,22 @@ namespace ti::edgeai::common
             /** Inference thread identifier. */
             thread                  m_inferThreadId;
 
+            /** Forwarding thread identifier. Only used if the
+             * post-processing runs in a GST element.
+             */
+            thread                  m_forwardThreadId;
+
             /** Input buffers to the inference. */
             VecDlTensorPtr          m_inferInputBuff;
 
             /** Output buffers to the inference. */
             VecDlTensorPtr          m_inferOutputBuff;
 
+            /** Second set of output buffers, exchanged with the
+             * post-processing element.
+             */
+            VecDlTensorPtr          m_spareOutputBuff;
+
             /** Frame rate of the input data. */
             uint32_t                m_frameRate;
 
@@ -274,6 +391,45 @@ namespace ti::edgeai::common
 
             /** Support for debugging and testing. */
             DebugDump               m_debugObj;
+
+            /** Tensor capture context. Only valid if capture is enabled. */
+            TensorCaptureWriter    *m_capture{nullptr};
+
+            /** Scene change detector. Only valid if motion gating is
+             * enabled.
+             */
+            MotionDetector         *m_motionDetector{nullptr};
+
+            /** Result publisher. Only valid if publishing is enabled. */
+            ResultPublisher        *m_publisher{nullptr};
+
+            /** Number of frames inferred so far. Only used for the
+             * inference rate, the debug window counts the input frames.
+             */
+            uint64_t                m_inferCnt{0};
+
+            /** Number of input frames received so far. */
+            uint64_t                m_inputCnt{0};
+
+            /** Number of frames shed by the scheduler. */
+            uint64_t                m_shedCnt{0};
+
+            /** Number of frames skipped by motion gating. */
+            uint64_t                m_staticCnt{0};
+
+            /** Number of frames dropped because the output was behind. */
+            uint64_t                m_lateCnt{0};
+
+            /** Frames dropped at the appsinks at the last report. */
+            uint64_t                m_inputDropCnt{0};
+
+            /** Time of the last report of the frames dropped at the
+             * appsinks.
+             */
+            chrono::system_clock::time_point    m_inputDropTime{};
+
+            /** Smoothed inference rate in frames per second. */
+            float                   m_inferFps{0.0f};
     };
 
 } // namespace ti::edgeai::common
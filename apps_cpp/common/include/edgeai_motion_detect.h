@@ -0,0 +1,152 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_MOTION_DETECT_H_
+#define _TI_EDGEAI_MOTION_DETECT_H_
+
+/* Standard headers. */
+#include <cstdint>
+#include <vector>
+
+/**
+ * \defgroup group_edgeai_motion_detect Motion gating
+ *
+ * \brief Cheap scene change detection used to skip the inference of static
+ *        frames.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Configuration of the scene change detection.
+     *
+     * \ingroup group_edgeai_motion_detect
+     */
+    struct MotionDetectConfig
+    {
+        /** Mean absolute luma difference, in the 0-255 range, above which
+         *  the scene is considered changed. Detection is disabled if 0.
+         */
+        float       threshold{0.0f};
+
+        /** A frame is reported as changed after this many unchanged
+         *  frames, to refresh the results.
+         */
+        int32_t     refreshInterval{30};
+
+        /** Width of the sampled luma plane. */
+        int32_t     gridWidth{64};
+
+        /** Height of the sampled luma plane. */
+        int32_t     gridHeight{36};
+    };
+
+    /**
+     * \brief Detects scene changes between RGB frames. Each frame is reduced
+     *        to a tiny luma plane by averaging a small block of pixels per
+     *        grid cell, which is compared against the plane of the last
+     *        changed frame.
+     *
+     * \ingroup group_edgeai_motion_detect
+     */
+    class MotionDetector
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Detection configuration
+             */
+            MotionDetector(const MotionDetectConfig &config);
+
+            /**
+             * Check if the frame differs enough from the reference frame,
+             * or if the refresh interval has elapsed.
+             *
+             * @param frame Packed RGB frame
+             * @param width Frame width in pixels
+             * @param height Frame height in pixels
+             * @param stride Bytes per row, width * 3 if smaller
+             *
+             * @returns true if the frame is to be treated as changed.
+             */
+            bool isChanged(const uint8_t   *frame,
+                           int32_t          width,
+                           int32_t          height,
+                           int32_t          stride = 0);
+
+            /**
+             * Make the frame last given to isChanged() the reference. Only
+             * called once the frame has actually been inferred.
+             */
+            void updateReference();
+
+            /** Destructor. */
+            ~MotionDetector();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            MotionDetector(const MotionDetector& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            MotionDetector & operator=(const MotionDetector& rhs) = delete;
+
+        private:
+            /** Configuration. */
+            MotionDetectConfig  m_config;
+
+            /** Luma plane of the last inferred frame. */
+            vector<uint8_t>     m_reference;
+
+            /** Luma plane of the current frame. */
+            vector<uint8_t>     m_current;
+
+            /** Number of frames checked since the last inferred one. */
+            int32_t             m_unchangedCnt{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_MOTION_DETECT_H_ */
@@ -0,0 +1,301 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_OBJECT_TRACKER_H_
+#define _TI_EDGEAI_OBJECT_TRACKER_H_
+
+/* Standard headers. */
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * \defgroup group_edgeai_object_tracker Object tracking
+ *
+ * \brief Multi-object tracking of the detections across frames.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Configuration of the object tracker.
+     *
+     * \ingroup group_edgeai_object_tracker
+     */
+    struct TrackerConfig
+    {
+        /** Minimum overlap of a detection with the predicted box of a
+         *  track for them to be associated.
+         */
+        float       iouThreshold{0.3f};
+
+        /** Detections scoring at least this can start new tracks and are
+         *  associated first. The weaker ones only extend existing tracks.
+         */
+        float       highScore{0.5f};
+
+        /** Detections scoring less than this are ignored. */
+        float       lowScore{0.1f};
+
+        /** Number of input frames a track is kept without being
+         *  associated, the skipped frames included.
+         */
+        int32_t     maxAge{30};
+
+        /** Number of associations before a track is reported. */
+        int32_t     minHits{1};
+
+        /** Maximum number of simultaneous tracks. */
+        int32_t     maxTracks{256};
+
+        /**
+         * Helper function to dump the configuration information.
+         */
+        void dumpInfo() const;
+    };
+
+    /**
+     * \brief Detection fed to the tracker.
+     *
+     * \ingroup group_edgeai_object_tracker
+     */
+    struct TrackerDetection
+    {
+        /** Box as x1, y1, x2, y2. */
+        float       box[4];
+
+        /** Detection score. */
+        float       score;
+
+        /** Class identifier. Only detections of the same class are
+         *  associated with a track.
+         */
+        int32_t     classId;
+    };
+
+    /**
+     * \brief One coordinate of the constant velocity Kalman filter.
+     *
+     * \ingroup group_edgeai_object_tracker
+     */
+    struct TrackerAxis
+    {
+        /** Position. */
+        float       pos;
+
+        /** Velocity, per input frame. */
+        float       vel;
+
+        /** Position variance. */
+        float       p00;
+
+        /** Position/velocity covariance. */
+        float       p01;
+
+        /** Velocity variance. */
+        float       p11;
+    };
+
+    /**
+     * \brief Tracked object.
+     *
+     * \ingroup group_edgeai_object_tracker
+     */
+    struct Track
+    {
+        /** Track identifier, unique over the life of the tracker. */
+        int64_t     id;
+
+        /** Class identifier. */
+        int32_t     classId;
+
+        /** Score of the last associated detection. */
+        float       score;
+
+        /** Current box as x1, y1, x2, y2. */
+        float       box[4];
+
+        /** Filters on the centre x, centre y, width and height. */
+        TrackerAxis axis[4];
+
+        /** Number of associations. */
+        int32_t     hits;
+
+        /** Number of frames since the last association. */
+        int32_t     age;
+
+        /** Set if the track was not associated on the last update. */
+        bool        missed;
+
+        /** Set if the slot holds a track. */
+        bool        active;
+
+        /** Set if the track is to be reported. */
+        bool        visible;
+    };
+
+    /**
+     * \brief Tracks the detections of a stream, SORT style. Each track
+     *        follows a constant velocity Kalman filter on its box. On
+     *        frames with detections the tracks are associated with them
+     *        greedily by overlap, the high scoring detections first, as in
+     *        ByteTrack. On frames without detections the tracks are only
+     *        predicted, which interpolates the boxes between inferences.
+     *
+     *        All the storage is allocated up front so the tracker does not
+     *        allocate once running.
+     *
+     * \ingroup group_edgeai_object_tracker
+     */
+    class ObjectTracker
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Tracker configuration
+             */
+            ObjectTracker(const TrackerConfig &config);
+
+            /**
+             * Clear the detections of the current frame.
+             */
+            void clearDetections();
+
+            /**
+             * Add a detection of the current frame. Detections scoring
+             * below the low score are ignored.
+             *
+             * @param det Detection
+             */
+            void addDetection(const TrackerDetection &det);
+
+            /**
+             * Advance the tracks and associate them with the detections
+             * added since clearDetections().
+             *
+             * @param numFrames Input frames since the last update or
+             *                  prediction, including the skipped ones
+             */
+            void update(int32_t numFrames = 1);
+
+            /**
+             * Advance the tracks without detections.
+             *
+             * @param numFrames Input frames since the last update or
+             *                  prediction, including the skipped ones
+             */
+            void predict(int32_t numFrames = 1);
+
+            /**
+             * Returns the track slots. Only the visible ones are to be
+             * reported.
+             */
+            const vector<Track> &getTracks() const
+            {
+                return m_tracks;
+            }
+
+            /** Destructor. */
+            ~ObjectTracker();
+
+        private:
+            /**
+             * Predict all the tracks to the current frame and drop the ones
+             * that have not been associated for too long.
+             *
+             * @param numFrames Input frames to predict over
+             */
+            void advance(int32_t numFrames);
+
+            /**
+             * Associate the unmatched tracks with the unmatched detections
+             * scoring in the given range.
+             *
+             * @param minScore Minimum detection score, inclusive
+             * @param maxScore Maximum detection score, exclusive
+             */
+            void associate(float    minScore,
+                           float    maxScore);
+
+            /**
+             * Start a track from a detection.
+             *
+             * @param det Detection
+             */
+            void startTrack(const TrackerDetection &det);
+
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            ObjectTracker(const ObjectTracker& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            ObjectTracker & operator=(const ObjectTracker& rhs) = delete;
+
+        private:
+            /** Configuration. */
+            TrackerConfig               m_config;
+
+            /** Track slots. */
+            vector<Track>               m_tracks;
+
+            /** Detections of the current frame. */
+            vector<TrackerDetection>    m_detections;
+
+            /** Set for the detections associated with a track. */
+            vector<bool>                m_detMatched;
+
+            /** Set for the tracks associated on the current frame. */
+            vector<bool>                m_trackMatched;
+
+            /** Candidate associations as overlap, track and detection. */
+            vector<pair<float, pair<int32_t, int32_t>>> m_candidates;
+
+            /** Identifier of the next track. */
+            int64_t                     m_nextId{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_OBJECT_TRACKER_H_ */
@@ -0,0 +1,194 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_POSTPROC_ELEMENT_H_
+#define _TI_EDGEAI_POSTPROC_ELEMENT_H_
+
+/* Standard headers. */
+#include <mutex>
+#include <string>
+
+/* Third-party headers. */
+#include <gst/gst.h>
+
+/* Module headers. */
+#include <common/include/post_process_image.h>
+#include <common/include/edgeai_result_export.h>
+
+/**
+ * \defgroup group_edgeai_postproc_element Post-processing element
+ *
+ * \brief In-place GStreamer transform running the post-processing on the
+ *        sensor frames, in the streaming thread of the source pipeline.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Wraps a post-processing object as an "edgeaipostproc" element.
+     *
+     *        The element draws the latest results handed over by the
+     *        inference thread on every frame going through it. Frames
+     *        passing before the first results are left untouched. The
+     *        result tensors are exchanged, not copied, so the inference
+     *        thread needs a second set of output buffers.
+     *
+     * \ingroup group_edgeai_postproc_element
+     */
+    class PostprocElement
+    {
+        public:
+            /** Constructor.
+             *
+             * @param postProcObj Post-processing object, not owned
+             * @param width Width of the frames to process
+             * @param height Height of the frames to process
+             * @param name Name of the element
+             */
+            PostprocElement(PostprocessImage   *postProcObj,
+                            int32_t             width,
+                            int32_t             height,
+                            const string       &name);
+
+            /** Returns the element. It belongs to the pipeline once added
+             * to it.
+             */
+            GstElement *getElement();
+
+            /** Sets the statistics entry the post-processing time is
+             * reported to.
+             *
+             * @param instId Statistics key
+             */
+            void setStatsKey(int32_t instId);
+
+            /** Sets the publisher the results of every frame are sent to.
+             *
+             * @param publisher Result publisher, not owned
+             */
+            void setPublisher(ResultPublisher *publisher);
+
+            /** Sets if the decoded results are attached to the frames.
+             *
+             * @param exportResults true if an output reads the buffer meta
+             */
+            void setExportResults(bool exportResults);
+
+            /**
+             * Hands over new results. The given vector receives the
+             * previously held buffers, which is empty on the first call.
+             *
+             * @param results Output tensors of the inference
+             */
+            void exchangeResults(VecDlTensorPtr &results);
+
+            /**
+             * Runs the post-processing on a frame, with the latest results,
+             * and attaches the decoded results to it if exporting. Called
+             * from the streaming thread.
+             *
+             * @param buffer Packed RGB frame, writable
+             *
+             * @returns 0 on success, a negative value otherwise.
+             */
+            int32_t process(GstBuffer *buffer);
+
+            /**
+             * Registers the element type with GStreamer. Only the first
+             * call has an effect.
+             *
+             * @returns 0 on success, a negative value otherwise.
+             */
+            static int32_t registerElement();
+
+            /** Destructor. */
+            ~PostprocElement();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            PostprocElement(const PostprocElement& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            PostprocElement & operator=(const PostprocElement& rhs) = delete;
+
+        private:
+            /** Post-processing context. */
+            PostprocessImage   *m_postProcObj{nullptr};
+
+            /** Element instance. */
+            GstElement         *m_element{nullptr};
+
+            /** Width of the frames. */
+            int32_t             m_width{0};
+
+            /** Height of the frames. */
+            int32_t             m_height{0};
+
+            /** Statistics key, -1 if not reporting. */
+            int32_t             m_statsKey{-1};
+
+            /** Result publisher. Only valid if publishing. */
+            ResultPublisher    *m_publisher{nullptr};
+
+            /** Set if the results are attached to the frames. */
+            bool                m_exportResults{false};
+
+            /** Number of frames processed. */
+            uint64_t            m_frameCnt{0};
+
+            /** Latest results. */
+            VecDlTensorPtr      m_results;
+
+            /** Set if the results have not been drawn yet. */
+            bool                m_updated{false};
+
+            /** Lock for the results exchange. */
+            mutex               m_mutex;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_POSTPROC_ELEMENT_H_ */
@@ -0,0 +1,129 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_POSTPROC_RESULT_H_
+#define _TI_EDGEAI_POSTPROC_RESULT_H_
+
+/* Standard headers. */
+#include <cstdint>
+#include <vector>
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Task type of the decoded results.
+     *
+     * \ingroup group_edgeai_cpp_apps_post_proc
+     */
+    enum PostprocResultType : uint16_t
+    {
+        /** No results. */
+        POSTPROC_RESULT_NONE            = 0,
+
+        /** Top classes of the frame. */
+        POSTPROC_RESULT_CLASSIFICATION  = 1,
+
+        /** Detected objects. */
+        POSTPROC_RESULT_DETECTION       = 2,
+
+        /** Class of every pixel. */
+        POSTPROC_RESULT_SEGMENTATION    = 3,
+
+        /** Detected objects with their keypoints. */
+        POSTPROC_RESULT_KEYPOINTS       = 4
+    };
+
+    /**
+     * \brief Decoded object, or class for the classification.
+     *
+     * \ingroup group_edgeai_cpp_apps_post_proc
+     */
+    struct PostprocObject
+    {
+        /** Class identifier, with the label offset applied. */
+        int32_t         classId{-1};
+
+        /** Track identifier, -1 without tracking. */
+        int32_t         trackId{-1};
+
+        /** Class found by the second stage classifier, -1 if none. */
+        int32_t         subClassId{-1};
+
+        /** Detection or class score. */
+        float           score{0.0f};
+
+        /** Box as x1, y1, x2, y2 in frame pixels. Unused for the
+         * classification.
+         */
+        int32_t         box[4]{0, 0, 0, 0};
+
+        /** Keypoints as x, y, confidence triplets, x and y in frame
+         * pixels.
+         */
+        vector<float>   keypoints;
+    };
+
+    /**
+     * \brief Results of the last post-processed frame, as decoded before
+     *        they are drawn.
+     *
+     * \ingroup group_edgeai_cpp_apps_post_proc
+     */
+    struct PostprocResult
+    {
+        /** Task type. */
+        PostprocResultType  type{POSTPROC_RESULT_NONE};
+
+        /** Width of the frame the coordinates refer to. */
+        int32_t             width{0};
+
+        /** Height of the frame the coordinates refer to. */
+        int32_t             height{0};
+
+        /** Objects or classes. */
+        vector<PostprocObject> objects;
+
+        /** Width of the segmentation mask. */
+        int32_t             maskWidth{0};
+
+        /** Height of the segmentation mask. */
+        int32_t             maskHeight{0};
+
+        /** Class of every pixel of the segmentation mask, row major. */
+        vector<uint8_t>     mask;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_POSTPROC_RESULT_H_ */
@@ -0,0 +1,199 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_PRELOAD_SOURCE_H_
+#define _TI_EDGEAI_PRELOAD_SOURCE_H_
+
+/* Standard headers. */
+#include <string>
+#include <vector>
+
+/* Third-party headers. */
+#include <gst/gst.h>
+#include <gst/app/gstappsrc.h>
+
+/**
+ * \defgroup group_edgeai_preload_source Pre-loaded image sequence source
+ *
+ * \brief Decodes an image sequence once and replays the decoded frames
+ *        from memory through an appsrc element.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+/** Format of the frames replayed by PreloadedImageSource. */
+#define PRELOAD_SOURCE_FORMAT   "NV12"
+
+    using namespace std;
+
+    /**
+     * \brief Image sequence source which decodes all the frames once into a
+     *        single memory region and then feeds them to an appsrc element
+     *        in a ring. Disk access and image decoding are taken out of the
+     *        steady state, which keeps the throughput measurements of the
+     *        rest of the pipeline free from their noise.
+     *
+     *        The decoded frames can optionally be stored in a raw cache file.
+     *        When a matching cache file exists, it is memory mapped and the
+     *        decode step is skipped entirely.
+     *
+     * \ingroup group_edgeai_preload_source
+     */
+    class PreloadedImageSource
+    {
+        public:
+            /** Constructor.
+             *
+             * @param location Image file or multifilesrc style pattern
+             * @param index Start index for the pattern
+             * @param width Width of the decoded frames
+             * @param height Height of the decoded frames
+             * @param framerate Replay rate as a fraction string (ex:- 30/1).
+             *        A rate of 0 replays the frames without timestamps, i.e.
+             *        as fast as the downstream elements consume them.
+             * @param loop Wrap around at the end of the sequence
+             * @param cacheFile Optional raw cache file. Empty to disable.
+             */
+            PreloadedImageSource(const string  &location,
+                                 int32_t        index,
+                                 int32_t        width,
+                                 int32_t        height,
+                                 const string  &framerate,
+                                 bool           loop,
+                                 const string  &cacheFile);
+
+            /**
+             * Populate the frame ring, either by mapping the cache file or by
+             * decoding the whole sequence.
+             *
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t load();
+
+            /**
+             * Set the caps and the data callbacks on the appsrc element which
+             * will replay the frames. Must be called after load().
+             *
+             * @param appsrc appsrc element to feed
+             */
+            void attach(GstElement *appsrc);
+
+            /** Destructor. */
+            ~PreloadedImageSource();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            PreloadedImageSource(const PreloadedImageSource& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            PreloadedImageSource & operator=(const PreloadedImageSource& rhs) = delete;
+
+            /** Map the cache file, if it exists and matches the config. */
+            int32_t mapCache();
+
+            /** Decode the image sequence into memory. */
+            int32_t decode();
+
+            /** Write the decoded frames to the cache file. */
+            int32_t writeCache();
+
+            /** Wrap the decoded data into one GstMemory per frame. */
+            void wrapFrames();
+
+            /** appsrc need-data callback. */
+            static void needData(GstAppSrc *src, guint length, gpointer userData);
+
+        private:
+            /** Image file or pattern. */
+            string                  m_location;
+
+            /** Start index for the pattern. */
+            int32_t                 m_index;
+
+            /** Frame width. */
+            int32_t                 m_width;
+
+            /** Frame height. */
+            int32_t                 m_height;
+
+            /** Replay frame rate numerator. */
+            int32_t                 m_fpsN{30};
+
+            /** Replay frame rate denominator. */
+            int32_t                 m_fpsD{1};
+
+            /** Wrap around at the end of the sequence. */
+            bool                    m_loop;
+
+            /** Raw cache file. */
+            string                  m_cacheFile;
+
+            /** Start of the decoded frames. */
+            uint8_t                *m_data{nullptr};
+
+            /** Size of the region pointed to by m_data. */
+            size_t                  m_dataSize{0};
+
+            /** Offset of the first frame in m_data. */
+            size_t                  m_dataOffset{0};
+
+            /** Set if m_data is a mapping of the cache file. */
+            bool                    m_mapped{false};
+
+            /** Size of one decoded frame. */
+            size_t                  m_frameSize{0};
+
+            /** Number of decoded frames. */
+            uint32_t                m_numFrames{0};
+
+            /** Read-only memory wrappers, one per frame. */
+            vector<GstMemory *>     m_frames;
+
+            /** Number of buffers pushed so far. */
+            uint64_t                m_pushCount{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_PRELOAD_SOURCE_H_ */
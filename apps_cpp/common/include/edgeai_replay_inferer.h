@@ -0,0 +1,214 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_REPLAY_INFERER_H_
+#define _TI_EDGEAI_REPLAY_INFERER_H_
+
+/* Standard headers. */
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <edgeai_dl_inferer/ti_dl_inferer.h>
+#include <common/include/edgeai_tensor_capture.h>
+
+/**
+ * \defgroup group_edgeai_replay_inferer Replay inference backend
+ *
+ * \brief Inference backend returning previously recorded output tensors.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+    using namespace ti::dl_inferer;
+
+    /**
+     * \brief Configuration for the replay inference backend.
+     *
+     * \ingroup group_edgeai_replay_inferer
+     */
+    struct ReplayInfererConfig
+    {
+        /** Directory holding the recording. It must contain a replay.yaml
+         *  file describing the input and output tensors as below, along
+         *  with one raw file per output holding the recorded frames back to
+         *  back.
+         *
+         *  inputs:
+         *      - name: input
+         *        type: uint8
+         *        shape: [1, 3, 320, 320]
+         *  outputs:
+         *      - name: detections
+         *        type: float32
+         *        shape: [1, 200, 6]
+         *        file: detections.bin
+         *
+         *  Alternatively, the path to a tensor capture file recorded with
+         *  the EDGEAI_ENABLE_TENSOR_CAPTURE debug flag.
+         */
+        string      path;
+
+        /** Mean of the synthetic inference latency in milliseconds. */
+        float       latency{0.0f};
+
+        /** Spread of the synthetic inference latency in milliseconds. This
+         *  is the standard deviation for the normal and lognormal
+         *  distributions and the half width for the uniform distribution.
+         */
+        float       jitter{0.0f};
+
+        /** Latency distribution. One of fixed, uniform, normal, lognormal. */
+        string      distribution{"fixed"};
+
+        /** Seed for the latency generator, for reproducible runs. */
+        uint32_t    seed{0};
+
+        /**
+         * Helper function to dump the configuration information.
+         *
+         * @param prefix Prefix to be added to the log outputs.
+         */
+        void dumpInfo(const char *prefix="") const;
+    };
+
+    /**
+     * \brief Inference backend that does not run any model. Each run()
+     *        copies the next recorded frame of every output tensor from
+     *        memory mapped files and then waits for a latency sampled from
+     *        the configured distribution. The rest of the application,
+     *        from the pre-processing to the display, can then be exercised
+     *        and profiled on machines without the TI inference runtime.
+     *
+     * \ingroup group_edgeai_replay_inferer
+     */
+    class ReplayInferer : public DLInferer
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Replay configuration
+             */
+            ReplayInferer(const ReplayInfererConfig &config);
+
+            /**
+             * Copy the next recorded frame into the output tensors. The
+             * recording wraps around at the end. The input tensors are not
+             * looked at.
+             *
+             * @param inputs Input tensors
+             * @param outputs Output tensors
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t run(const VecDlTensorPtr &inputs, VecDlTensorPtr &outputs);
+
+            /** Dump the recording information. */
+            void dumpInfo();
+
+            /** Returns the recorded input tensor information. */
+            const VecDlTensor *getInputInfo();
+
+            /** Returns the recorded output tensor information. */
+            const VecDlTensor *getOutputInfo();
+
+            /** Allocate a tensor data buffer.
+             *
+             * @param size Size of the buffer in bytes
+             */
+            void *allocate(int64_t size);
+
+            /** Destructor. */
+            ~ReplayInferer();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            ReplayInferer(const ReplayInferer& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            ReplayInferer & operator=(const ReplayInferer& rhs) = delete;
+
+            /** Sample the latency of the next run, in microseconds. */
+            int64_t sampleLatency();
+
+        private:
+            /** Configuration. */
+            ReplayInfererConfig         m_config;
+
+            /** Recorded input tensor information. */
+            VecDlTensor                 m_inputInfo;
+
+            /** Recorded output tensor information. */
+            VecDlTensor                 m_outputInfo;
+
+            /** Mapped output recordings, one per output tensor. */
+            vector<uint8_t *>           m_outputData;
+
+            /** Size of each mapping in m_outputData. */
+            vector<size_t>              m_outputDataSize;
+
+            /** Tensor capture reader. Only valid if replaying a capture
+             * file.
+             */
+            TensorCaptureReader        *m_capture{nullptr};
+
+            /** Number of recorded frames. */
+            uint64_t                    m_numFrames{0};
+
+            /** Number of runs so far. Selects the frame to return. */
+            atomic<uint64_t>            m_runCount{0};
+
+            /** Latency generator. */
+            mt19937                     m_rng;
+
+            /** Lock for the latency generator. */
+            mutex                       m_rngMutex;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_REPLAY_INFERER_H_ */
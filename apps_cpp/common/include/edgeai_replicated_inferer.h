@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_REPLICATED_INFERER_H_
+#define _TI_EDGEAI_REPLICATED_INFERER_H_
+
+/* Standard headers. */
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/* Module headers. */
+#include <edgeai_dl_inferer/ti_dl_inferer.h>
+
+/**
+ * \defgroup group_edgeai_replicated_inferer Replicated inference backend
+ *
+ * \brief Inference backend spreading the runs over copies of one model.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+    using namespace ti::dl_inferer;
+
+    /**
+     * \brief Inference backend holding several instances of the same model,
+     *        typically loaded on different C7x cores. Each run() is handed
+     *        to the replica with the fewest runs in progress, so that the
+     *        sub-flows sharing the model do not queue up on a single core.
+     *
+     * \ingroup group_edgeai_replicated_inferer
+     */
+    class ReplicatedInferer : public DLInferer
+    {
+        public:
+            /** Constructor. Takes the ownership of the replicas.
+             *
+             * @param replicas Instances of the same model
+             */
+            ReplicatedInferer(const vector<DLInferer*> &replicas);
+
+            /**
+             * Run the model on the least busy replica. Blocks while the
+             * chosen replica finishes an earlier run.
+             *
+             * @param inputs Input tensors
+             * @param outputs Output tensors
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t run(const VecDlTensorPtr &inputs, VecDlTensorPtr &outputs);
+
+            /** Dump the information of the first replica. */
+            void dumpInfo();
+
+            /** Returns the input tensor information. */
+            const VecDlTensor *getInputInfo();
+
+            /** Returns the output tensor information. */
+            const VecDlTensor *getOutputInfo();
+
+            /** Allocate a tensor data buffer usable by all the replicas.
+             *
+             * @param size Size of the buffer in bytes
+             */
+            void *allocate(int64_t size);
+
+            /** Destructor. */
+            ~ReplicatedInferer();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            ReplicatedInferer(const ReplicatedInferer& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            ReplicatedInferer & operator=(const ReplicatedInferer& rhs) = delete;
+
+        private:
+            /** Model instances. */
+            vector<DLInferer*>          m_replicas;
+
+            /** Number of runs in progress or waiting, per replica. */
+            vector<int32_t>             m_pending;
+
+            /** Per replica lock, serializing the runs on it. */
+            vector<unique_ptr<mutex>>   m_runMutex;
+
+            /** Lock for m_pending. */
+            mutex                       m_mutex;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_REPLICATED_INFERER_H_ */
@@ -0,0 +1,270 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_RESULT_EXPORT_H_
+#define _TI_EDGEAI_RESULT_EXPORT_H_
+
+/* Standard headers. */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Third-party headers. */
+#include <gst/gst.h>
+#include <sys/un.h>
+
+/* Module headers. */
+#include <common/include/edgeai_postproc_result.h>
+
+/**
+ * \defgroup group_edgeai_result_export Result export
+ *
+ * \brief Hands the decoded post-processing results over to the rest of the
+ *        pipeline, as a buffer meta, and to other processes, as binary
+ *        records on a Unix socket.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+#define RESULT_RECORD_MAGIC     (0x52494145) /* "EAIR" */
+#define RESULT_RECORD_VERSION   (1)
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Header of a result record. A record is sent as one datagram
+     *        and holds the header, numObjects ResultRecordObject entries,
+     *        each followed by its keypoints as numKeypoints x, y, confidence
+     *        float triplets, then the maskWidth x maskHeight class bytes.
+     *        All the fields are in the host byte order.
+     *
+     * \ingroup group_edgeai_result_export
+     */
+    struct ResultRecordHeader
+    {
+        /** RESULT_RECORD_MAGIC. */
+        uint32_t    magic;
+
+        /** RESULT_RECORD_VERSION. */
+        uint16_t    version;
+
+        /** PostprocResultType. */
+        uint16_t    type;
+
+        /** Identifier of the flow producing the results. */
+        uint32_t    flowId;
+
+        /** Number of objects. */
+        uint32_t    numObjects;
+
+        /** Frame number within the flow. */
+        uint64_t    frameId;
+
+        /** Presentation timestamp of the frame in nanoseconds. */
+        uint64_t    timestamp;
+
+        /** Width of the frame the coordinates refer to. */
+        uint16_t    width;
+
+        /** Height of the frame the coordinates refer to. */
+        uint16_t    height;
+
+        /** Width of the segmentation mask, 0 if none. */
+        uint16_t    maskWidth;
+
+        /** Height of the segmentation mask, 0 if none. */
+        uint16_t    maskHeight;
+    };
+
+    /**
+     * \brief Object entry of a result record.
+     *
+     * \ingroup group_edgeai_result_export
+     */
+    struct ResultRecordObject
+    {
+        /** Class identifier. */
+        int32_t     classId;
+
+        /** Track identifier, -1 without tracking. */
+        int32_t     trackId;
+
+        /** Second stage class, -1 if none. */
+        int32_t     subClassId;
+
+        /** Score. */
+        float       score;
+
+        /** Box as x1, y1, x2, y2 in frame pixels. */
+        int32_t     box[4];
+
+        /** Number of keypoint triplets following the entry. */
+        uint32_t    numKeypoints;
+    };
+
+    static_assert(sizeof(ResultRecordHeader) == 40, "Unexpected record layout");
+    static_assert(sizeof(ResultRecordObject) == 36, "Unexpected record layout");
+
+    /**
+     * \brief Buffer meta sharing the decoded results of the frame. The
+     *        results are not modified once attached.
+     *
+     * \ingroup group_edgeai_result_export
+     */
+    struct ResultMeta
+    {
+        /** Parent meta. */
+        GstMeta                             meta;
+
+        /** Results of the frame. */
+        shared_ptr<const PostprocResult>    result;
+    };
+
+    /** Returns the API type of the result meta. */
+    GType getResultMetaApiType();
+
+    /**
+     * Attaches the results to a buffer. The results are shared, not
+     * copied.
+     *
+     * @param buffer Writable buffer
+     * @param result Results to attach
+     *
+     * @returns 0 on success, a negative value otherwise.
+     */
+    int32_t addResultMeta(GstBuffer                               *buffer,
+                          const shared_ptr<const PostprocResult>  &result);
+
+    /**
+     * Returns the results attached to a buffer.
+     *
+     * @param buffer Buffer
+     *
+     * @returns the results, or nullptr if none are attached.
+     */
+    const PostprocResult *getResultMeta(GstBuffer *buffer);
+
+    /**
+     * Serializes the results of a frame as a result record.
+     *
+     * @param result Results
+     * @param flowId Identifier of the flow
+     * @param frameId Frame number
+     * @param timestamp Presentation timestamp in nanoseconds
+     * @param record Buffer receiving the record, resized to fit it
+     *
+     * @returns the size of the record in bytes.
+     */
+    uint64_t serializeResult(const PostprocResult   &result,
+                             uint32_t                flowId,
+                             uint64_t                frameId,
+                             uint64_t                timestamp,
+                             vector<uint8_t>        &record);
+
+    /**
+     * \brief Publishes the results as binary records on a Unix datagram
+     *        socket. The records are sent without blocking and are dropped
+     *        if no reader is bound to the socket path or if the reader is
+     *        not keeping up.
+     *
+     * \ingroup group_edgeai_result_export
+     */
+    class ResultPublisher
+    {
+        public:
+            /** Constructor.
+             *
+             * @param path Path of the socket the reader is bound to
+             */
+            ResultPublisher(const string &path);
+
+            /**
+             * Sends the results of a frame.
+             *
+             * @param result Results
+             * @param flowId Identifier of the flow
+             * @param frameId Frame number
+             * @param timestamp Presentation timestamp in nanoseconds
+             *
+             * @returns 0 if sent or dropped, a negative value on failure.
+             *          Only the first failure is logged.
+             */
+            int32_t publish(const PostprocResult   &result,
+                            uint32_t                flowId,
+                            uint64_t                frameId,
+                            uint64_t                timestamp);
+
+            /** Destructor. */
+            ~ResultPublisher();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            ResultPublisher(const ResultPublisher& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            ResultPublisher & operator=(const ResultPublisher& rhs) = delete;
+
+        private:
+            /** Socket descriptor. */
+            int32_t             m_socket{-1};
+
+            /** Reader address. */
+            struct sockaddr_un  m_addr{};
+
+            /** Record being serialized. */
+            vector<uint8_t>     m_record;
+
+            /** Number of records dropped. */
+            uint64_t            m_dropCnt{0};
+
+            /** Number of records sent. */
+            uint64_t            m_sentCnt{0};
+
+            /** Number of records that failed to be sent. */
+            uint64_t            m_errorCnt{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_RESULT_EXPORT_H_ */
@@ -0,0 +1,197 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef _TI_EDGEAI_RTSP_SERVER_H_
+#define _TI_EDGEAI_RTSP_SERVER_H_
+
+/* Standard headers. */
+#include <mutex>
+#include <string>
+#include <thread>
+
+/* Third-party headers. */
+#include <gst/gst.h>
+#include <gst/app/gstappsink.h>
+#include <gst/rtsp-server/rtsp-server.h>
+
+/**
+ * \defgroup group_edgeai_rtsp_server RTSP server
+ *
+ * \brief Serves an encoded output to RTSP clients.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+
+    /**
+     * \brief Configuration of an RTSP server.
+     *
+     * \ingroup group_edgeai_rtsp_server
+     */
+    struct RtspServerConfig
+    {
+        /** Port the server listens on. */
+        int32_t     port{8554};
+
+        /** Path of the stream, rtsp://<host>:<port><path>. */
+        string      path{"/stream"};
+
+        /**
+         * Helper function to dump the configuration information.
+         */
+        void dumpInfo() const;
+    };
+
+    /**
+     * \brief Serves the H.264 stream reaching an appsink to any number of
+     *        RTSP clients.
+     *
+     *        The stream is encoded once in the output pipeline. Every
+     *        client shares a single media, which payloads the access units
+     *        handed over by the appsink. Access units arriving while no
+     *        client is connected are dropped. The server runs its own main
+     *        loop and starts listening with the first access unit, so that
+     *        an output only built for checking does not open the port.
+     *
+     * \ingroup group_edgeai_rtsp_server
+     */
+    class RtspServer
+    {
+        public:
+            /** Constructor.
+             *
+             * @param config Server configuration
+             * @param name Name of the appsink
+             */
+            RtspServer(const RtspServerConfig  &config,
+                       const string            &name);
+
+            /** Returns the appsink, to be added to the output pipeline. */
+            GstElement *getElement();
+
+            /** Destructor. */
+            ~RtspServer();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            RtspServer(const RtspServer& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            RtspServer & operator=(const RtspServer& rhs) = delete;
+
+            /**
+             * Creates the server and starts its main loop.
+             *
+             * @returns 0 on success, a negative value otherwise.
+             */
+            int32_t start();
+
+            /**
+             * Hands an access unit over to the media, if any.
+             *
+             * @param sample Sample pulled from the appsink
+             */
+            void forward(GstSample *sample);
+
+            /** Appsink callback. */
+            static GstFlowReturn onNewSample(GstAppSink    *appsink,
+                                             gpointer       data);
+
+            /** Factory callback, called when the shared media is created. */
+            static void onMediaConfigure(GstRTSPMediaFactory   *factory,
+                                         GstRTSPMedia          *media,
+                                         gpointer               data);
+
+            /** Media callback, called when the last client leaves. */
+            static void onMediaUnprepared(GstRTSPMedia     *media,
+                                          gpointer          data);
+
+        private:
+            /** Configuration. */
+            RtspServerConfig    m_config;
+
+            /** Appsink of the output pipeline. */
+            GstElement         *m_appsink{nullptr};
+
+            /** Appsrc of the shared media, nullptr without clients. */
+            GstElement         *m_appsrc{nullptr};
+
+            /** Set once the caps were set on the appsrc. */
+            bool                m_capsSet{false};
+
+            /** Set after dropping an access unit, until the next key frame. */
+            bool                m_waitKeyFrame{false};
+
+            /** Lock for the appsrc. */
+            mutex               m_mutex;
+
+            /** Server. */
+            GstRTSPServer      *m_server{nullptr};
+
+            /** Main context of the server. */
+            GMainContext       *m_context{nullptr};
+
+            /** Main loop of the server. */
+            GMainLoop          *m_loop{nullptr};
+
+            /** Main loop thread. */
+            thread              m_loopThread;
+
+            /** Server source identifier in the main context. */
+            guint               m_sourceId{0};
+
+            /** Set once start() was attempted. */
+            bool                m_started{false};
+
+            /** Number of access units served. */
+            uint64_t            m_sentCnt{0};
+
+            /** Number of access units dropped with the appsrc queue full. */
+            uint64_t            m_droppedCnt{0};
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_RTSP_SERVER_H_ */
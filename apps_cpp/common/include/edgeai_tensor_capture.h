@@ -0,0 +1,310 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef _TI_EDGEAI_TENSOR_CAPTURE_H_
+#define _TI_EDGEAI_TENSOR_CAPTURE_H_
+
+/* Standard headers. */
+#include <string>
+#include <vector>
+
+/* Module headers. */
+#include <edgeai_dl_inferer/ti_dl_inferer.h>
+
+/**
+ * \defgroup group_edgeai_tensor_capture Tensor capture and replay.
+ *
+ * \brief Recording of the inference input and output tensors to a file,
+ *        and reading them back for offline post-processing.
+ *
+ *        File layout, all integers in host byte order:
+ *        - A TensorCaptureFileHeader padded to TENSOR_CAPTURE_ALIGN bytes,
+ *          describing every input and output tensor.
+ *        - Fixed size records, back to back. Each record starts with a
+ *          TensorCaptureRecordHeader padded to TENSOR_CAPTURE_ALIGN bytes,
+ *          followed by the tensor payloads in descriptor order, each one
+ *          padded to TENSOR_CAPTURE_ALIGN bytes.
+ *
+ *        Every payload therefore starts on a page boundary and record N is
+ *        found without scanning the file. A record cut short by an
+ *        interrupted run is ignored by the reader.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+#define TENSOR_CAPTURE_MAGIC        "EAITCAP"
+#define TENSOR_CAPTURE_VERSION      (1)
+#define TENSOR_CAPTURE_ALIGN        (4096)
+#define TENSOR_CAPTURE_MAX_TENSORS  (16)
+#define TENSOR_CAPTURE_MAX_DIMS     (8)
+#define TENSOR_CAPTURE_NAME_LEN     (64)
+
+namespace ti::edgeai::common
+{
+    using namespace std;
+    using namespace ti::dl_inferer;
+
+    /**
+     * \brief Description of a captured tensor.
+     *
+     * \ingroup group_edgeai_tensor_capture
+     */
+    struct TensorCaptureDesc
+    {
+        /** Tensor name, truncated and NUL terminated. */
+        char        name[TENSOR_CAPTURE_NAME_LEN];
+
+        /** DlInferType of the tensor. */
+        int32_t     type;
+
+        /** Element size in bytes. */
+        int32_t     elemSize;
+
+        /** Number of valid entries in shape. */
+        int32_t     dim;
+
+        /** Padding. */
+        int32_t     reserved;
+
+        /** Tensor shape. */
+        int64_t     shape[TENSOR_CAPTURE_MAX_DIMS];
+
+        /** Payload size in bytes. */
+        int64_t     size;
+
+        /** Payload offset from the start of a record. */
+        int64_t     offset;
+    };
+
+    /**
+     * \brief Capture file header.
+     *
+     * \ingroup group_edgeai_tensor_capture
+     */
+    struct TensorCaptureFileHeader
+    {
+        /** Set to TENSOR_CAPTURE_MAGIC. */
+        char                magic[8];
+
+        /** Set to TENSOR_CAPTURE_VERSION. */
+        uint32_t            version;
+
+        /** Number of input tensors. */
+        uint32_t            numInputs;
+
+        /** Number of output tensors. */
+        uint32_t            numOutputs;
+
+        /** Alignment of the records and payloads. */
+        uint32_t            align;
+
+        /** Size of one record, including the padding. */
+        int64_t             recordSize;
+
+        /** Input descriptors first, then the output descriptors. */
+        TensorCaptureDesc   tensors[TENSOR_CAPTURE_MAX_TENSORS];
+    };
+
+    /**
+     * \brief Per record header.
+     *
+     * \ingroup group_edgeai_tensor_capture
+     */
+    struct TensorCaptureRecordHeader
+    {
+        /** Frame number, counted from 0 by the capturing pipe. */
+        uint64_t            frameId;
+
+        /** Monotonic clock time of the capture in nanoseconds. */
+        int64_t             timestamp;
+
+        /** Inference time of this frame in nanoseconds. */
+        int64_t             inferTime;
+    };
+
+    /**
+     * \brief Append-only writer for the capture file.
+     *
+     * \ingroup group_edgeai_tensor_capture
+     */
+    class TensorCaptureWriter
+    {
+        public:
+            /** Constructor. Creates, or truncates, the file and writes the
+             * file header. Throws on failure.
+             *
+             * @param file Path to the capture file
+             * @param inputInfo Input tensor information from the inferer
+             * @param outputInfo Output tensor information from the inferer
+             */
+            TensorCaptureWriter(const string       &file,
+                                const VecDlTensor  &inputInfo,
+                                const VecDlTensor  &outputInfo);
+
+            /** Append one record.
+             *
+             * @param frameId Frame number
+             * @param inferTime Inference time of this frame in nanoseconds
+             * @param inputs Input tensors, as passed to the inferer
+             * @param outputs Output tensors, as returned by the inferer
+             *
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t write(uint64_t              frameId,
+                          int64_t               inferTime,
+                          const VecDlTensorPtr &inputs,
+                          const VecDlTensorPtr &outputs);
+
+            /** Destructor. */
+            ~TensorCaptureWriter();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            TensorCaptureWriter(const TensorCaptureWriter& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            TensorCaptureWriter & operator=(const TensorCaptureWriter& rhs) = delete;
+
+        private:
+            /** File header. */
+            TensorCaptureFileHeader m_header{};
+
+            /** File descriptor. */
+            int                     m_fd{-1};
+
+            /** Path to the capture file. */
+            string                  m_file;
+    };
+
+    /**
+     * \brief Reader for the capture file. The whole file is memory mapped
+     *        and the tensors are handed out without copying.
+     *
+     * \ingroup group_edgeai_tensor_capture
+     */
+    class TensorCaptureReader
+    {
+        public:
+            /** Constructor. Maps and validates the file. Throws on failure.
+             *
+             * @param file Path to the capture file
+             */
+            TensorCaptureReader(const string &file);
+
+            /** Returns the number of complete records. */
+            uint64_t getNumRecords() const;
+
+            /** Returns the captured input tensor information. */
+            const VecDlTensor *getInputInfo() const;
+
+            /** Returns the captured output tensor information. */
+            const VecDlTensor *getOutputInfo() const;
+
+            /** Returns the header of the given record. */
+            const TensorCaptureRecordHeader *getRecord(uint64_t index) const;
+
+            /** Returns the payload of an input tensor in the given record. */
+            const uint8_t *getInputData(uint64_t index, uint32_t tensor) const;
+
+            /** Returns the payload of an output tensor in the given record. */
+            const uint8_t *getOutputData(uint64_t index, uint32_t tensor) const;
+
+            /** Point the data of the given tensors at the payloads of a
+             * record. The tensors must have been created from
+             * getInputInfo() and getOutputInfo() and must not own their
+             * data. Either vector may be empty.
+             *
+             * @param index Record number
+             * @param inputs Input tensors to update
+             * @param outputs Output tensors to update
+             *
+             * @returns 0 if successful, a negative value otherwise.
+             */
+            int32_t bind(uint64_t           index,
+                         VecDlTensorPtr    &inputs,
+                         VecDlTensorPtr    &outputs) const;
+
+            /** Destructor. */
+            ~TensorCaptureReader();
+
+        private:
+            /**
+             * Copy constructor.
+             *
+             * Copy constructor is not required and allowed and hence prevent
+             * the compiler from generating a default constructor.
+             */
+            TensorCaptureReader(const TensorCaptureReader& rhs) = delete;
+
+            /**
+             * Assignment operator.
+             *
+             * Assignment is not required and allowed and hence prevent
+             * the compiler from generating a default assignment operator.
+             */
+            TensorCaptureReader & operator=(const TensorCaptureReader& rhs) = delete;
+
+            /** Returns the start of the given record. */
+            const uint8_t *recordBase(uint64_t index) const;
+
+        private:
+            /** Start of the mapping. */
+            const uint8_t          *m_base{nullptr};
+
+            /** Size of the mapping. */
+            size_t                  m_size{0};
+
+            /** File header, within the mapping. */
+            const TensorCaptureFileHeader *m_header{nullptr};
+
+            /** Number of complete records. */
+            uint64_t                m_numRecords{0};
+
+            /** Input tensor information. */
+            VecDlTensor             m_inputInfo;
+
+            /** Output tensor information. */
+            VecDlTensor             m_outputInfo;
+    };
+
+} // namespace ti::edgeai::common
+
+#endif /* _TI_EDGEAI_TENSOR_CAPTURE_H_ */
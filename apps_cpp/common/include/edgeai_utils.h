@@ -34,6 +34,8 @@
 #define _TI_EDGEAI_UTILS_H_
 
 /* Standard headers. */
+#include <atomic>
+#include <mutex>
 #include <string>
 #include <thread>
 
@@ -48,6 +50,7 @@
 #include <common/include/edgeai_gstelementmap.h>
 
 #define MAX_SCALE_FACTOR           4
+#define MAX_SCALER_OUTPUTS         5
 
 using namespace std;
 
@@ -57,8 +60,10 @@ namespace ti::edgeai::common
 
     /* Forward declaration. */
     struct StatEntry;
+    struct ElementStatEntry;
 
     using MapStatEntry   = map<uint32_t, StatEntry>;
+    using MapElementStat = map<string, ElementStatEntry>;
 
     /** Statistics database. */
     /**
@@ -73,6 +78,9 @@ namespace ti::edgeai::common
             /** Vector of ststistics objects. */
             static MapStatEntry m_stats;
 
+            /** Latencies of the GST elements, by element name. */
+            static MapElementStat m_elemStats;
+
             /** Flag to control curses report thread */
             static bool m_printCurses;
 
@@ -82,8 +90,16 @@ namespace ti::edgeai::common
             /** Reporting thread identifier. */
             static thread m_reportingThread;
 
+            /** Flag to keep every reported sample, for percentiles. */
+            static atomic<bool> m_collectSamples;
+
+            /** Lock for adding the entries and for the element statistics.
+             * The values of an entry are guarded by a lock of the entry.
+             */
+            static mutex m_mutex;
+
             /** Function for registering the model to track statistics specific
-             * to this model.
+             * to this model. Must be called before the reporting starts.
              *
              * @param key Identifier for retrieving the appropriate record.
              * @param inputName Name String representation of the input
@@ -121,6 +137,44 @@ namespace ti::edgeai::common
                                         const string   &tag,
                                         const string   &unit,
                                         float           value);
+
+            /**
+             * Function for registering a GST element to track the latency
+             * and metrics of. Must be called before the reporting starts.
+             * Registering an element again keeps the existing entry.
+             *
+             * @param name Name of the element instance
+             * @param tag Kind of latency measured, ex:- processing, queueing
+             */
+            static int32_t addElementEntry(const string    &name,
+                                           const string    &tag);
+
+            /**
+             * Utility Function for reporting the latency of buffers through
+             * a GST element. It will update the last average with the new
+             * sample values
+             *
+             * @param name Name of the element instance
+             * @param value mean latency of the buffers in milliseconds
+             * @param numSamples number of buffers the mean is taken over
+             */
+            static int32_t reportElementTime(const string  &name,
+                                             float          value,
+                                             uint64_t       numSamples = 1);
+
+            /**
+             * Utility Function for reporting a metric of a GST element.
+             * It will update the last average with the new sample value
+             *
+             * @param name Name of the element instance
+             * @param tag unique string to represent each metric
+             * @param unit unit of measurment
+             * @param value measured value
+             */
+            static int32_t reportElementMetric(const string    &name,
+                                               const string    &tag,
+                                               const string    &unit,
+                                               float            value);
             /**
              * Thread callback function which prints a table of reported processing times
              * using ncurses library.
@@ -148,6 +202,37 @@ namespace ti::edgeai::common
              * Disables the curses process printing to the output, if enabled.
              */
             static void disableCursesReport();
+
+            /**
+             * Start or stop keeping the individual samples reported through
+             * reportProcTime() and reportMetric(). Starting discards the
+             * samples kept so far.
+             *
+             * @param state passing true starts the collection
+             */
+            static void enableSampleCollection(bool state);
+
+            /**
+             * Returns the smallest number of collected samples for the given
+             * tag across all the entries. Used to wait for every flow to
+             * have processed a number of frames.
+             *
+             * @param tag Processing time or metric tag
+             */
+            static uint64_t getMinSampleCount(const string &tag);
+
+            /**
+             * Write the collected samples as a JSON array with one object
+             * per entry, holding the frame and inference counts, the frame rate
+             * over the given duration and the mean and percentiles of every tag.
+             *
+             * @param fp File to write to
+             * @param duration Collection duration in seconds
+             * @param indent Indentation of the array
+             */
+            static void writeJson(FILE         *fp,
+                                  double        duration,
+                                  const string &indent);
     };
 
     /**
@@ -173,6 +258,18 @@ namespace ti::edgeai::common
     void getPreProcElements(const PreprocessImageConfig *preProcCfg,
                             std::vector<GstElement *>   &preProcElements);
 
+    /**
+     * Returns a string identifying the GST pre-processing branch that
+     * getPreProcScalerElements() and getPreProcElements() generate for the
+     * given configuration. Two configurations with the same key produce
+     * identical buffers at the pre-processing appsink, for the same input.
+     *
+     * @param preProcCfg        PreProcessImage Config Struct
+     *
+     * @return key string
+     */
+    std::string getPreProcKey(const PreprocessImageConfig *preProcCfg);
+
     /**
      * Helper function to convert string to fraction
      *
@@ -182,6 +279,16 @@ namespace ti::edgeai::common
      */
     const std::string to_fraction(std::string& num);
 
+    /**
+     * Helper function to escape a string for a JSON string literal
+     *
+     * @param s string to be escaped
+     *
+     * @return string with the quotes, backslashes and control characters
+     *         escaped, without the enclosing quotes
+     */
+    std::string jsonEscape(const std::string& s);
+
     /**
      * Helper function to check if string is numeric
      *
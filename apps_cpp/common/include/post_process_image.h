@@ -33,10 +33,17 @@
 #ifndef _POST_PROCESS_IMAGE_H_
 #define _POST_PROCESS_IMAGE_H_
 
+/* Standard headers. */
+#include <memory>
+#include <vector>
+
 /* Module headers. */
 #include <edgeai_dl_inferer/ti_dl_inferer.h>
 #include <edgeai_dl_inferer/ti_post_process_config.h>
 #include <common/include/edgeai_debug.h>
+#include <common/include/edgeai_object_tracker.h>
+#include <common/include/edgeai_cascade.h>
+#include <common/include/edgeai_postproc_result.h>
 
 /**
  * \defgroup group_edgeai_cpp_apps_post_proc Image Post-processing
@@ -78,10 +85,77 @@ namespace ti::edgeai::common
              *
              * This is the heart of the class. The application uses this
              * interface to execute the functionality provided by this class.
+             * A null frameData only decodes the results into getResult(),
+             * without drawing anything.
              */
             virtual void *operator()(void              *frameData,
                                      VecDlTensorPtr    &results) = 0;
 
+            /**
+             * Enable the tracking of the results across frames. Only
+             * supported by the detection post-processing.
+             *
+             * @param config Tracker configuration
+             * @returns 0 on success, -1 if tracking is not supported.
+             */
+            virtual int32_t enableTracking(const TrackerConfig &config);
+
+            /**
+             * Enable the classification of the results by a second model.
+             * Only supported by the detection post-processing.
+             *
+             * @param cascade Second stage classifier. Owned by this object
+             *                on success.
+             * @returns 0 on success, -1 if not supported.
+             */
+            virtual int32_t enableCascade(CascadeClassifier *cascade);
+
+            /**
+             * Tell if the results passed to the next call of the function
+             * operator come from a new inference, or are the results of an
+             * earlier frame.
+             *
+             * @param updated true if the results are new
+             */
+            void setResultsUpdated(bool updated)
+            {
+                m_resultsUpdated = updated;
+            }
+
+            /**
+             * Tell the index of the input frame passed to the next call of
+             * the function operator. The tracking accounts for the frames
+             * skipped since the last call with it.
+             *
+             * @param index Input frame index
+             */
+            void setFrameIndex(uint64_t index)
+            {
+                m_frameIndex = index;
+            }
+
+            /**
+             * Tell if the decoded results are used, by a publisher or by
+             * the consumers of the buffer meta. The segmentation mask is
+             * not filled otherwise.
+             *
+             * @param required true if the results are used
+             */
+            void setResultsRequired(bool required)
+            {
+                m_resultsRequired = required;
+            }
+
+            /**
+             * Returns the results decoded by the last call of the function
+             * operator. They are not modified by the later calls, and can
+             * be shared with the buffers.
+             */
+            shared_ptr<const PostprocResult> getResult() const
+            {
+                return m_result;
+            }
+
             /** Debug object. */
             DebugDump &getDebugObj()
             {
@@ -108,12 +182,34 @@ namespace ti::edgeai::common
             std::string                     m_title;
 
         protected:
+            /**
+             * Makes m_result writable for the decoding of a new frame.
+             * The results still shared with earlier buffers are left
+             * untouched, and a set no longer shared is reused instead.
+             */
+            void nextResult();
+
             /** Configuration information. */
             const PostprocessImageConfig    m_config{};
 
             /** Support for debugging and testing. */
             DebugDump                       m_debugObj;
 
+            /** Set if the results are from a new inference. */
+            bool                            m_resultsUpdated{true};
+
+            /** Index of the input frame being processed. */
+            uint64_t                        m_frameIndex{0};
+
+            /** Set if the decoded results are used. */
+            bool                            m_resultsRequired{true};
+
+            /** Results decoded from the last frame. */
+            shared_ptr<PostprocResult>      m_result;
+
+            /** All the result sets, m_result being one of them. */
+            vector<shared_ptr<PostprocResult>>  m_resultPool;
+
         private:
             /**
              * Assignment operator.
@@ -73,10 +73,75 @@ namespace ti::edgeai::common
             void *operator()(void              *frameData,
                              VecDlTensorPtr    &results);
 
+            /**
+             * Enable tracking. The detections are fed to a tracker and the
+             * tracks are drawn instead, with their identifier. On frames
+             * without new results the tracks are predicted.
+             *
+             * @param config Tracker configuration. The high score is set to
+             *               the visualization threshold of the model.
+             * @returns 0 on success.
+             */
+            int32_t enableTracking(const TrackerConfig &config);
+
+            /**
+             * Enable the classification of the detected regions by a
+             * second model. The class found is appended to the label of
+             * the box.
+             *
+             * @param cascade Second stage classifier. Owned by this object
+             *                from then on.
+             * @returns 0 on success.
+             */
+            int32_t enableCascade(CascadeClassifier *cascade);
+
             /** Destructor. */
             ~PostprocessImageObjDetect();
 
         private:
+            /**
+             * Get the name and the drawing color of a class.
+             *
+             * @param classId Class identifier, with the label offset applied
+             * @param name Class name
+             * @param color RGB color
+             */
+            void getClassInfo(int32_t       classId,
+                              std::string  &name,
+                              uint8_t      *color);
+
+        private:
+            /** Box to draw. */
+            struct DetectDrawItem
+            {
+                /** Box as x1, y1, x2, y2. */
+                int                 box[4];
+
+                /** Class identifier, with the label offset applied. */
+                int32_t             classId;
+
+                /** Detection score. */
+                float               score;
+
+                /** Track identifier if tracking, index otherwise. */
+                int64_t             key;
+            };
+
+            /** Tracker. Only valid if tracking is enabled. */
+            ObjectTracker          *m_tracker{nullptr};
+
+            /** Input frame the tracks were last advanced to, -1 if none. */
+            int64_t                 m_trackedFrame{-1};
+
+            /** Second stage classifier. Only valid if enabled. */
+            CascadeClassifier      *m_cascade{nullptr};
+
+            /** Boxes to draw on the current frame. */
+            std::vector<DetectDrawItem> m_drawItems;
+
+            /** Second stage classes, by box key, of the last detections. */
+            std::vector<std::pair<int64_t, int32_t>> m_cascadeResults;
+
             /** Multiplicative factor to be applied to X co-ordinates. */
             float                   m_scaleX{1.0f};
 
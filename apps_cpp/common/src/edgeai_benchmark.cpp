@@ -0,0 +1,273 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <stdio.h>
+#include <string.h>
+#include <sys/resource.h>
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_utils.h>
+#include <common/include/edgeai_benchmark.h>
+
+/**
+ * \defgroup group_edgeai_benchmark Headless benchmark mode
+ *
+ * \brief Runs a demo without display output and writes a JSON summary.
+ *
+ * \ingroup group_edgeai_common
+ */
+
+namespace ti::edgeai::common
+{
+using namespace std;
+using namespace ti::utils;
+
+using Clock = chrono::steady_clock;
+
+/* Interval for polling the frame counts. */
+#define BENCHMARK_POLL_INTERVAL     chrono::milliseconds(10)
+
+/* Metric reported once per output frame by every flow, including the ones
+ * running in the pipeline or skipping inferences.
+ */
+#define BENCHMARK_FRAME_TAG         "total time"
+
+/**
+ * CPU and buffer counters sampled at the start and the end of the
+ * measurement.
+ */
+struct BenchmarkSnapshot
+{
+    /** Wall clock. */
+    Clock::time_point               time;
+
+    /** CPU time consumed by the process, in seconds. */
+    double                          procTime{0};
+
+    /** Busy and total jiffies of all the CPUs, from /proc/stat. */
+    uint64_t                        sysBusy{0};
+    uint64_t                        sysTotal{0};
+
+    /** Appsink buffer counters. */
+    map<string, GstPipeBufferCount> buffers;
+};
+
+static void takeSnapshot(EdgeAIDemo        &demo,
+                         BenchmarkSnapshot &snap)
+{
+    struct rusage   usage;
+    ifstream        stat("/proc/stat");
+    string          cpu;
+
+    snap.time = Clock::now();
+
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        snap.procTime = usage.ru_utime.tv_sec + usage.ru_stime.tv_sec +
+                        (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec)/1e6;
+    }
+
+    /* cpu user nice system idle iowait irq softirq steal ... */
+    if (stat >> cpu && cpu == "cpu")
+    {
+        uint64_t    val;
+
+        for (int32_t i = 0; i < 8 && stat >> val; i++)
+        {
+            snap.sysTotal += val;
+
+            if (i != 3 && i != 4)
+            {
+                snap.sysBusy += val;
+            }
+        }
+    }
+
+    demo.getBufferCounts(snap.buffers);
+}
+
+Benchmark::Benchmark(const BenchmarkConfig &config):
+    m_config(config)
+{
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+void Benchmark::applyOverrides(YAML::Node  &yaml,
+                               bool         unthrottle)
+{
+    for (auto n : yaml["outputs"])
+    {
+        n.second["sink"] = "fakesink";
+        n.second.remove("overlay-perf-type");
+    }
+
+    if (unthrottle)
+    {
+        for (auto n : yaml["inputs"])
+        {
+            n.second["throttle"] = false;
+        }
+    }
+}
+
+int32_t Benchmark::run(EdgeAIDemo      &demo,
+                       const string    &title)
+{
+    BenchmarkSnapshot   start;
+    BenchmarkSnapshot   end;
+    atomic<bool>        finished{false};
+    FILE               *fp = stdout;
+    int32_t             status = 0;
+    double              duration;
+    thread              waitThread([&demo, &finished]
+                                   {
+                                       demo.waitForExit();
+                                       finished = true;
+                                   });
+
+    /* Wait for every flow to process the warm-up frames. */
+    Statistics::enableSampleCollection(true);
+
+    while (!finished &&
+           Statistics::getMinSampleCount(BENCHMARK_FRAME_TAG) < m_config.warmup)
+    {
+        this_thread::sleep_for(BENCHMARK_POLL_INTERVAL);
+    }
+
+    /* Restarting the collection drops the warm-up samples. */
+    Statistics::enableSampleCollection(true);
+    takeSnapshot(demo, start);
+
+    while (!finished)
+    {
+        auto    elapsed = chrono::duration<float>(Clock::now() - start.time);
+
+        if (m_config.frames &&
+            Statistics::getMinSampleCount(BENCHMARK_FRAME_TAG) >= m_config.frames)
+        {
+            break;
+        }
+
+        if (m_config.duration > 0 && elapsed.count() >= m_config.duration)
+        {
+            break;
+        }
+
+        this_thread::sleep_for(BENCHMARK_POLL_INTERVAL);
+    }
+
+    takeSnapshot(demo, end);
+    Statistics::enableSampleCollection(false);
+
+    demo.sendExitSignal();
+    waitThread.join();
+
+    duration = chrono::duration<double>(end.time - start.time).count();
+
+    if (m_config.output != "")
+    {
+        fp = fopen(m_config.output.c_str(), "w");
+
+        if (fp == nullptr)
+        {
+            LOG_ERROR("Could not open [%s]: %s\n",
+                      m_config.output.c_str(), strerror(errno));
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        uint64_t    cnt = 0;
+
+        fprintf(fp, "{\n");
+        fprintf(fp, "  \"version\": 1,\n");
+        fprintf(fp, "  \"title\": \"%s\",\n", jsonEscape(title).c_str());
+        fprintf(fp, "  \"warmup_frames\": %ld,\n", m_config.warmup);
+        fprintf(fp, "  \"duration_s\": %.3f,\n", duration);
+
+        /* The process load is relative to one CPU, the system load to all. */
+        fprintf(fp, "  \"cpu\": {\"process_percent\": %.1f, "
+                "\"system_percent\": %.1f},\n",
+                duration > 0 ? 100 * (end.procTime - start.procTime)/duration : 0,
+                end.sysTotal > start.sysTotal ?
+                    100.0 * (end.sysBusy - start.sysBusy)/
+                            (end.sysTotal - start.sysTotal) : 0);
+
+        fprintf(fp, "  \"flows\": ");
+        Statistics::writeJson(fp, duration, "  ");
+        fprintf(fp, ",\n");
+
+        /* Buffers that reached an appsink but were never pulled got
+         * dropped.
+         */
+        fprintf(fp, "  \"dropped_frames\": {");
+
+        for (auto const &[name, c] : end.buffers)
+        {
+            auto const &s = start.buffers[name];
+            int64_t     dropped = (c.received - s.received) -
+                                  (c.pulled - s.pulled);
+
+            fprintf(fp, "%s\n    \"%s\": %ld", cnt++ ? "," : "",
+                    jsonEscape(name).c_str(), max<int64_t>(dropped, 0));
+        }
+
+        fprintf(fp, "\n  }\n");
+        fprintf(fp, "}\n");
+
+        if (fp != stdout)
+        {
+            fclose(fp);
+        }
+        else
+        {
+            fflush(fp);
+        }
+    }
+
+    return status;
+}
+
+Benchmark::~Benchmark()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+}
+
+} // namespace ti::edgeai::common
+
@@ -0,0 +1,328 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <utils/include/ti_stl_helpers.h>
+#include <common/include/edgeai_cascade.h>
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+template <typename T>
+static T saturate(float v)
+{
+    if constexpr (is_integral<T>::value)
+    {
+        v = roundf(v);
+        v = max(v, static_cast<float>(numeric_limits<T>::min()));
+        v = min(v, static_cast<float>(numeric_limits<T>::max()));
+    }
+
+    return static_cast<T>(v);
+}
+
+template <typename T>
+static int32_t argmax(const void   *data,
+                      int64_t       numElem)
+{
+    const T    *p = reinterpret_cast<const T*>(data);
+
+    return max_element(p, p + numElem) - p;
+}
+
+void CascadeConfig::dumpInfo() const
+{
+    LOG_INFO_RAW("\n");
+    LOG_INFO("CascadeConfig::model   = %s\n", model.c_str());
+    LOG_INFO("CascadeConfig::maxRois = %d\n", maxRois);
+    LOG_INFO("CascadeConfig::classes = [ ");
+
+    for (auto const &c : classes)
+    {
+        LOG_INFO_RAW("%d ", c);
+    }
+
+    LOG_INFO_RAW("]\n");
+    LOG_INFO_RAW("\n");
+}
+
+CascadeClassifier::CascadeClassifier(const CascadeConfig          &config,
+                                     DLInferer                    *inferer,
+                                     const PreprocessImageConfig  &preProcCfg,
+                                     const PostprocessImageConfig &postProcCfg,
+                                     InferScheduler               *scheduler,
+                                     int32_t                       priority):
+    m_config(config),
+    m_inferer(inferer),
+    m_preProcCfg(preProcCfg),
+    m_postProcCfg(postProcCfg),
+    m_scheduler(scheduler),
+    m_priority(priority)
+{
+    const VecDlTensor  *inInfo = m_inferer->getInputInfo();
+    const VecDlTensor  *outInfo = m_inferer->getOutputInfo();
+
+    if (inInfo->size() != 1 || outInfo->empty())
+    {
+        LOG_ERROR("Expected a model with one input, got %ld.\n",
+                  inInfo->size());
+        throw runtime_error("CascadeClassifier object creation failed.");
+    }
+
+    const DlTensor &in = inInfo->at(0);
+
+    m_planar = m_preProcCfg.dataLayout == "NCHW";
+
+    if (in.dim < 3 ||
+        in.shape[in.dim - (m_planar ? 3 : 1)] != 3)
+    {
+        LOG_ERROR("Expected a 3 channel input tensor.\n");
+        throw runtime_error("CascadeClassifier object creation failed.");
+    }
+
+    m_inWidth  = in.shape[in.dim - (m_planar ? 1 : 2)];
+    m_inHeight = in.shape[in.dim - (m_planar ? 2 : 3)];
+
+    for (auto const &info : *inInfo)
+    {
+        DlTensor *obj = new DlTensor(info);
+        obj->allocateDataBuffer(*m_inferer);
+        m_inputs.push_back(obj);
+    }
+
+    for (auto const &info : *outInfo)
+    {
+        DlTensor *obj = new DlTensor(info);
+        obj->allocateDataBuffer(*m_inferer);
+        m_outputs.push_back(obj);
+    }
+
+    if (m_scheduler != nullptr)
+    {
+        m_scheduler->addUser(m_priority);
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+bool CascadeClassifier::isCandidate(int32_t classId) const
+{
+    return m_config.classes.empty() ||
+           find(m_config.classes.begin(),
+                m_config.classes.end(),
+                classId) != m_config.classes.end();
+}
+
+template <typename T>
+void CascadeClassifier::cropResize(const uint8_t   *frame,
+                                   int32_t          width,
+                                   int32_t          height,
+                                   const int32_t   *box,
+                                   T               *out)
+{
+    float   x1 = clamp(box[0], 0, width - 1);
+    float   y1 = clamp(box[1], 0, height - 1);
+    float   x2 = clamp(box[2], 0, width - 1);
+    float   y2 = clamp(box[3], 0, height - 1);
+    float   sx = (x2 - x1) / m_inWidth;
+    float   sy = (y2 - y1) / m_inHeight;
+    bool    norm = m_preProcCfg.mean.size() == 3 &&
+                   m_preProcCfg.scale.size() == 3;
+    int64_t plane = m_inWidth * m_inHeight;
+
+    for (int32_t y = 0; y < m_inHeight; y++)
+    {
+        /* Bilinear sampling at the pixel centres. */
+        float   fy = max(y1 + (y + 0.5f) * sy - 0.5f, 0.0f);
+        int32_t iy = min(static_cast<int32_t>(fy), height - 1);
+        int32_t iy1 = min(iy + 1, height - 1);
+        float   wy = fy - iy;
+
+        for (int32_t x = 0; x < m_inWidth; x++)
+        {
+            float   fx = max(x1 + (x + 0.5f) * sx - 0.5f, 0.0f);
+            int32_t ix = min(static_cast<int32_t>(fx), width - 1);
+            int32_t ix1 = min(ix + 1, width - 1);
+            float   wx = fx - ix;
+
+            const uint8_t *p00 = frame + (iy * width + ix) * 3;
+            const uint8_t *p01 = frame + (iy * width + ix1) * 3;
+            const uint8_t *p10 = frame + (iy1 * width + ix) * 3;
+            const uint8_t *p11 = frame + (iy1 * width + ix1) * 3;
+
+            for (int32_t c = 0; c < 3; c++)
+            {
+                int32_t sc = m_preProcCfg.reverseChannel ? 2 - c : c;
+                float   v = (1 - wy) * ((1 - wx) * p00[sc] + wx * p01[sc]) +
+                            wy * ((1 - wx) * p10[sc] + wx * p11[sc]);
+
+                if (norm)
+                {
+                    v = (v - m_preProcCfg.mean[c]) * m_preProcCfg.scale[c];
+                }
+
+                if (m_planar)
+                {
+                    out[c * plane + y * m_inWidth + x] = saturate<T>(v);
+                }
+                else
+                {
+                    out[(y * m_inWidth + x) * 3 + c] = saturate<T>(v);
+                }
+            }
+        }
+    }
+}
+
+int32_t CascadeClassifier::run(const uint8_t   *frame,
+                               int32_t          width,
+                               int32_t          height,
+                               const int32_t   *box)
+{
+    DlTensor   *in = m_inputs[0];
+    DlTensor   *out = m_outputs[0];
+    int32_t     classId = -1;
+    int32_t     status = 0;
+
+    if (in->type == DlInferType_UInt8)
+    {
+        cropResize(frame, width, height, box, reinterpret_cast<uint8_t*>(in->data));
+    }
+    else if (in->type == DlInferType_Int8)
+    {
+        cropResize(frame, width, height, box, reinterpret_cast<int8_t*>(in->data));
+    }
+    else if (in->type == DlInferType_UInt16)
+    {
+        cropResize(frame, width, height, box, reinterpret_cast<uint16_t*>(in->data));
+    }
+    else if (in->type == DlInferType_Int16)
+    {
+        cropResize(frame, width, height, box, reinterpret_cast<int16_t*>(in->data));
+    }
+    else if (in->type == DlInferType_Float32)
+    {
+        cropResize(frame, width, height, box, reinterpret_cast<float*>(in->data));
+    }
+    else
+    {
+        LOG_ERROR("Unsupported input tensor type.\n");
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        if (m_scheduler != nullptr)
+        {
+            status = m_scheduler->run(m_inferer, m_priority, false,
+                                      m_inputs, m_outputs);
+        }
+        else
+        {
+            status = m_inferer->run(m_inputs, m_outputs);
+        }
+
+        if (status != 0)
+        {
+            LOG_ERROR("Failed to run the model.\n");
+        }
+    }
+
+    if (status == 0)
+    {
+        if (out->type == DlInferType_Int8)
+        {
+            classId = argmax<int8_t>(out->data, out->numElem);
+        }
+        else if (out->type == DlInferType_UInt8)
+        {
+            classId = argmax<uint8_t>(out->data, out->numElem);
+        }
+        else if (out->type == DlInferType_Int16)
+        {
+            classId = argmax<int16_t>(out->data, out->numElem);
+        }
+        else if (out->type == DlInferType_UInt16)
+        {
+            classId = argmax<uint16_t>(out->data, out->numElem);
+        }
+        else if (out->type == DlInferType_Int32)
+        {
+            classId = argmax<int32_t>(out->data, out->numElem);
+        }
+        else if (out->type == DlInferType_Float32)
+        {
+            classId = argmax<float>(out->data, out->numElem);
+        }
+        else
+        {
+            LOG_ERROR("Unsupported output tensor type.\n");
+        }
+    }
+
+    if (classId >= 0)
+    {
+        classId += m_postProcCfg.labelOffsetMap.at(0);
+    }
+
+    return classId;
+}
+
+string CascadeClassifier::getClassName(int32_t classId) const
+{
+    string name = "UNDEFINED";
+
+    if (m_postProcCfg.datasetInfo.find(classId) != m_postProcCfg.datasetInfo.end())
+    {
+        name = m_postProcCfg.datasetInfo.at(classId).name;
+    }
+
+    return name;
+}
+
+CascadeClassifier::~CascadeClassifier()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+    DeleteVec(m_inputs);
+    DeleteVec(m_outputs);
+}
+
+} // namespace ti::edgeai::common
+
@@ -42,6 +42,16 @@
 
 namespace ti::edgeai::common
 {
+/* Long only options. */
+enum
+{
+    OPT_BENCH_FRAMES = 256,
+    OPT_BENCH_TIME,
+    OPT_BENCH_WARMUP,
+    OPT_BENCH_OUTPUT,
+    OPT_BENCH_UNTHROTTLE
+};
+
 static void showUsage(const char *name)
 {
     printf("# \n");
@@ -53,6 +63,12 @@ static void showUsage(const char *name)
     printf("#  [--log-level  |-l Logging level to enable. [0: DEBUG 1:INFO 2:WARN 3:ERROR]. Default is 2.\n");
     printf("#  [--dump-dot   |-d Dump Gstreamer Pipeline as dot file.]\n");
     printf("#  [--verbose    |-v]\n");
+    printf("#  [--benchmark  |-b Run headless and print a JSON summary.]\n");
+    printf("#  [--bench-frames N      Measured frames per flow.]\n");
+    printf("#  [--bench-time SECONDS  Measured duration.]\n");
+    printf("#  [--bench-warmup N      Frames skipped before measuring. Default is 30.]\n");
+    printf("#  [--bench-output FILE   Write the summary to FILE instead of stdout.]\n");
+    printf("#  [--bench-unthrottle    Let the inputs run as fast as possible.]\n");
     printf("#  [--help       |-h]\n");
     printf("# \n");
     printf("# (C) Texas Instruments 2021\n");
@@ -75,10 +91,16 @@ CmdlineArgs::parse(int32_t        argc,
         {"no-curses", no_argument,       0, 'n' },
         {"dump-dot",  no_argument,       0, 'd' },
         {"log-level", required_argument, 0, 'l' },
+        {"benchmark", no_argument,       0, 'b' },
+        {"bench-frames",     required_argument, 0, OPT_BENCH_FRAMES     },
+        {"bench-time",       required_argument, 0, OPT_BENCH_TIME       },
+        {"bench-warmup",     required_argument, 0, OPT_BENCH_WARMUP     },
+        {"bench-output",     required_argument, 0, OPT_BENCH_OUTPUT     },
+        {"bench-unthrottle", no_argument,       0, OPT_BENCH_UNTHROTTLE },
         {0,           0,                 0,  0  }
     };
 
-    while ((opt = getopt_long(argc, argv,"-hdvnl:",
+    while ((opt = getopt_long(argc, argv,"-hdvnbl:",
                    long_options, &longIndex )) != -1)
     {
         switch (opt)
@@ -103,6 +125,35 @@ CmdlineArgs::parse(int32_t        argc,
                 dumpDot = true;
                 break;
 
+            case 'b' :
+                benchmark = true;
+                break;
+
+            case OPT_BENCH_FRAMES :
+                benchmark = true;
+                benchConfig.frames = strtoul(optarg, NULL, 0);
+                break;
+
+            case OPT_BENCH_TIME :
+                benchmark = true;
+                benchConfig.duration = strtof(optarg, NULL);
+                break;
+
+            case OPT_BENCH_WARMUP :
+                benchmark = true;
+                benchConfig.warmup = strtoul(optarg, NULL, 0);
+                break;
+
+            case OPT_BENCH_OUTPUT :
+                benchmark = true;
+                benchConfig.output = optarg;
+                break;
+
+            case OPT_BENCH_UNTHROTTLE :
+                benchmark = true;
+                benchConfig.unthrottle = true;
+                break;
+
             case 'h' :
             default:
                 showUsage(argv[0]);
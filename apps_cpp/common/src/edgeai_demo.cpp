@@ -79,6 +79,11 @@ class EdgeAIDemoImpl
          */
         void waitForExit();
 
+        /**
+         * Returns the buffer counters of the input appsinks.
+         */
+        void getBufferCounts(map<string, GstPipeBufferCount> &counts);
+
         /** Destructor. */
         ~EdgeAIDemoImpl();
 
@@ -145,12 +150,15 @@ int32_t EdgeAIDemoImpl::setupFlows()
         modelSet.insert(modelIds.begin(), modelIds.end());
     }
 
-    /* Create the instances of the set of models. */
-    for (auto const &mId: modelSet)
-    {
-        ModelInfo  *model = m_config.m_modelMap[mId];
+    /* Create the instances of the set of models and place them on the
+     * available cores.
+     */
+    status = m_config.initializeModels(modelSet);
 
-        model->initialize();
+    if (status < 0)
+    {
+        LOG_ERROR("initializeModels() failed.\n");
+        return status;
     }
 
     /* Setup the flows. By this time all the relavant model contexts have been
@@ -160,19 +168,29 @@ int32_t EdgeAIDemoImpl::setupFlows()
     GstElement *            sinkPipeline{nullptr};
     vector<vector<string>>  srcElemNames;
     vector<string>          sinkElemNames;
+    vector<bool>            srcLoop;
     set<string>             outputSet;
 
     for (auto &[name,flow] : m_config.m_flowMap)
     {
-        flow->initialize(m_config.m_modelMap,
-                         m_config.m_inputMap,
-                         m_config.m_outputMap);
+        status = flow->initialize(m_config.m_modelMap,
+                                  m_config.m_inputMap,
+                                  m_config.m_outputMap,
+                                  m_config.m_schedulerMap);
+
+        /* A half-built flow would leave appsinks nothing pulls from. */
+        if (status < 0)
+        {
+            LOG_ERROR("[%s] Flow initialization failed.\n", name.c_str());
+            return status;
+        }
 
         /* Collect the GST strings from each flow, concatenate them, and create
          * the toplevel GST string.
          */
         auto const &input = m_config.m_inputMap[flow->m_inputId];
         input->getSrcPipelines(srcPipelines, srcElemNames);
+        srcLoop.push_back(input->m_segmentLoop);
 
         /* Update the output set. */
         auto const &outputIds = flow->m_outputIds;
@@ -240,11 +258,26 @@ int32_t EdgeAIDemoImpl::setupFlows()
     }
          
     /* Instantiate the GST pipe. */
-    m_gstPipe = new GstPipe(srcPipelines, sinkPipeline, srcElemNames, sinkElemNames);
+    m_gstPipe = new GstPipe(srcPipelines,
+                            sinkPipeline,
+                            srcElemNames,
+                            sinkElemNames,
+                            srcLoop);
+
+    if (m_config.m_elementLatency)
+    {
+        m_gstPipe->enableLatencyProbes();
+    }
 
     /* Start GST Pipelines. */
     status = m_gstPipe->startPipeline();
 
+    if (status == 0)
+    {
+        /* Sample the queue levels and drops. */
+        m_gstPipe->startTelemetry();
+    }
+
     if (status < 0)
     {
          LOG_ERROR("Failed to start GST pipelines.\n");
@@ -320,6 +353,11 @@ void EdgeAIDemoImpl::waitForExit()
     }
 }
 
+void EdgeAIDemoImpl::getBufferCounts(map<string, GstPipeBufferCount> &counts)
+{
+    m_gstPipe->getBufferCounts(counts);
+}
+
 /** Destructor. */
 EdgeAIDemoImpl::~EdgeAIDemoImpl()
 {
@@ -367,5 +405,9 @@ void EdgeAIDemo::waitForExit()
     m_impl->waitForExit();
 }
 
-} // namespace ti::edgeai::common
+void EdgeAIDemo::getBufferCounts(map<string, GstPipeBufferCount> &counts)
+{
+    m_impl->getBufferCounts(counts);
+}
 
+} // namespace ti::edgeai::common
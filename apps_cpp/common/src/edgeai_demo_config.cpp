@@ -30,16 +30,22 @@
  *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 /* Standard headers. */
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 /* Module headers. */
 #include <utils/include/ti_stl_helpers.h>
 #include <common/include/edgeai_utils.h>
 #include <common/include/edgeai_demo_config.h>
+#include <common/include/edgeai_replicated_inferer.h>
 
 #define TI_DEFAULT_LDC_WIDTH       1920
 #define TI_DEFAULT_LDC_HEIGHT      1080
 
+/* Timed inference runs per model when measuring the load for placement. */
+#define MODEL_PLACEMENT_RUNS       10
+
 namespace ti::edgeai::common
 {
 using namespace std;
@@ -88,6 +94,197 @@ static map<string, vector<string>> gVideoEncMap =
     {".mkv", {"h264parse","matroskamux"}}
 };
 
+/* Buffer dropping state of a pre-processing branch. */
+struct BranchDropCtx
+{
+    uint64_t    count{0};
+    int32_t     interval{1};
+};
+
+/* Only lets every interval-th buffer into the pre-processing branch. */
+static GstPadProbeReturn dropBranchBuffer(GstPad            *pad,
+                                          GstPadProbeInfo   *info,
+                                          gpointer           userData)
+{
+    auto *ctx = reinterpret_cast<BranchDropCtx*>(userData);
+
+    (void)pad;
+    (void)info;
+
+    return (ctx->count++ % ctx->interval) == 0 ? GST_PAD_PROBE_OK :
+                                                 GST_PAD_PROBE_DROP;
+}
+
+static void freeBranchDropCtx(gpointer userData)
+{
+    delete reinterpret_cast<BranchDropCtx*>(userData);
+}
+
+/* Frame rate from a "num/den" fraction string. */
+static float fractionToFloat(const string &fraction)
+{
+    auto    pos = fraction.find('/');
+    float   num = stof(fraction.substr(0, pos));
+    float   den = 1.0f;
+
+    if (pos != string::npos)
+    {
+        den = stof(fraction.substr(pos + 1));
+    }
+
+    return den > 0 ? num / den : 0.0f;
+}
+
+/* Scheduler of the inference requests to the model. Requests to one C7x
+ * core, or to a model spread over several, are scheduled together.
+ */
+static InferScheduler *getInferScheduler(const string                   &modelId,
+                                         const ModelInfo                *model,
+                                         map<string, InferScheduler*>   &schedulerMap)
+{
+    string  schedKey = modelId;
+    int32_t numSlots = max((int32_t)model->m_coreIds.size(), 1);
+
+    if (model->m_coreIds.size() == 1)
+    {
+        schedKey = "core" + to_string(model->m_coreIds[0]);
+    }
+
+    if (schedulerMap.find(schedKey) == schedulerMap.end())
+    {
+        schedulerMap[schedKey] = new InferScheduler(numSlots);
+    }
+
+    return schedulerMap[schedKey];
+}
+
+/* Drops the elements made for a sub-flow that could not be set up. They
+ * were never added to a pipeline.
+ */
+static void releaseElements(vector<GstElement *> &elements)
+{
+    for (auto &e : elements)
+    {
+        gst_object_unref(e);
+    }
+
+    elements.clear();
+}
+
+/* Appends the inferer and the post-process elements that run a sub-flow
+ * inside the pipeline, like the optiflow Python application does.
+ */
+static int32_t makeInPipelineElements(const ModelInfo          *model,
+                                      const string             &postProcName,
+                                      vector<GstElement *>     &elements)
+{
+    vector<vector<const gchar*>>    elemProperty;
+    string                          target;
+    string                          alpha = to_string(model->m_alpha);
+    string                          vizThreshold = to_string(model->m_vizThreshold);
+    string                          topN = to_string(model->m_topN);
+
+    if (!gstElementMap["dlpreproc"]["element"])
+    {
+        LOG_ERROR("In-pipeline inference needs the dlpreproc element.\n");
+        return -1;
+    }
+
+    /* Use the core the model was placed on by initializeModels(), else
+     * the first configured core.
+     */
+    if (!model->m_coreIds.empty())
+    {
+        target = to_string(model->m_coreIds[0]);
+    }
+    else if (gstElementMap["inferer"]["core-id"])
+    {
+        target = gstElementMap["inferer"]["core-id"][0].as<string>();
+    }
+
+    elemProperty = {{"model", model->m_modelPath.c_str()}};
+
+    if (!target.empty())
+    {
+        elemProperty.push_back({"target", target.c_str()});
+    }
+
+    makeElement(elements, "tidlinferer", elemProperty, NULL);
+
+    elemProperty = {{"name", postProcName.c_str()},
+                    {"model", model->m_modelPath.c_str()},
+                    {"alpha", alpha.c_str()},
+                    {"viz-threshold", vizThreshold.c_str()},
+                    {"top-N", topN.c_str()},
+                    {"display-model", "true"}};
+
+    makeElement(elements, "tidlpostproc", elemProperty, NULL);
+
+    return 0;
+}
+
+/* Cascade options, either a model name or a map of options. */
+static void parseCascadeConfig(const YAML::Node     &node,
+                               CascadeConfig        &config)
+{
+    if (!node.IsMap())
+    {
+        config.model = node.as<string>();
+        return;
+    }
+
+    config.model = node["model"].as<string>();
+
+    if (node["max_rois"])
+    {
+        config.maxRois = max(node["max_rois"].as<int32_t>(), 1);
+    }
+
+    if (node["classes"])
+    {
+        config.classes = node["classes"].as<vector<int32_t>>();
+    }
+}
+
+/* Tracker options, either a flag or a map of options. Returns true if
+ * tracking is enabled.
+ */
+static bool parseTrackerConfig(const YAML::Node    &node,
+                               TrackerConfig       &config)
+{
+    if (!node.IsMap())
+    {
+        return node.as<bool>();
+    }
+
+    if (node["iou_threshold"])
+    {
+        config.iouThreshold = node["iou_threshold"].as<float>();
+    }
+
+    if (node["low_score"])
+    {
+        config.lowScore = node["low_score"].as<float>();
+    }
+
+    if (node["max_age"])
+    {
+        config.maxAge = node["max_age"].as<int32_t>();
+    }
+
+    if (node["min_hits"])
+    {
+        config.minHits = node["min_hits"].as<int32_t>();
+    }
+
+    if (node["max_tracks"])
+    {
+        config.maxTracks = node["max_tracks"].as<int32_t>();
+    }
+
+    return true;
+}
+
 int32_t InputInfo::m_numInstances = 0;
 
 InputInfo::InputInfo(const YAML::Node &node)
@@ -122,6 +319,11 @@ InputInfo::InputInfo(const YAML::Node &node)
         m_loop = node["loop"].as<bool>();
     }
 
+    if (node["throttle"])
+    {
+        m_throttle = node["throttle"].as<bool>();
+    }
+
     if (node["pattern"])
     {
         m_pattern = node["pattern"].as<string>();
@@ -142,6 +344,16 @@ InputInfo::InputInfo(const YAML::Node &node)
         m_sen_id = node["sen-id"].as<string>();
     }
 
+    if (node["preload"])
+    {
+        m_preload = node["preload"].as<bool>();
+    }
+
+    if (node["preload-cache"])
+    {
+        m_preloadCache = node["preload-cache"].as<string>();
+    }
+
     GstStaticPadTemplate*   padtemplate;
     GstElementFactory*      factory;
     string                  scaler;
@@ -166,6 +378,8 @@ void InputInfo::dumpInfo(const char *prefix) const
     LOG_INFO("%sInputInfo::height        = %d\n", prefix, m_height);
     LOG_INFO("%sInputInfo::framerate     = %s\n", prefix, m_framerate.c_str());
     LOG_INFO("%sInputInfo::index         = %d\n", prefix, m_index);
+    LOG_INFO("%sInputInfo::throttle      = %d\n", prefix, m_throttle);
+    LOG_INFO("%sInputInfo::preload       = %d\n", prefix, m_preload);
 
     LOG_INFO("%sInputInfo::srcElemNames  =\n", prefix);
     for (auto const &s: m_srcElemNames)
@@ -177,6 +391,11 @@ void InputInfo::dumpInfo(const char *prefix) const
 
 int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementVec,
                                   vector<vector<GstElement*>>   &preProcScalerElementVec,
+                                  const vector<int32_t>         &preProcShareVec,
+                                  const vector<int32_t>         &preProcDropVec,
+                                  const vector<bool>            &inPipelineVec,
+                                  const vector<GstElement*>     &postProcElemVec,
+                                  const vector<bool>            &metadataOnlyVec,
                                   const vector<string>          &srcElemNames,
                                   const vector<vector<int32_t>> &sensorDimVec)
 {
@@ -407,6 +626,33 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
                 makeElement(m_inputElements,"v4l2src",m_gstElementProperty,caps.c_str());
             }
         }
+        else if (m_srcType == "image" && m_preload)
+        {
+            m_preloadSrc = new PreloadedImageSource(m_source,
+                                                    m_index,
+                                                    m_width,
+                                                    m_height,
+                                                    m_framerate,
+                                                    m_loop,
+                                                    m_preloadCache);
+
+            if (m_preloadSrc->load() < 0)
+            {
+                LOG_ERROR("Failed to pre-load the images from %s.\n",
+                          m_source.c_str());
+                throw runtime_error("Failed to create Gstreamer Pipeline.");
+            }
+
+            /* The caps filter added after appsrc lets the input format be
+             * determined without running the source.
+             */
+            m_gstElementProperty = {{"name",srcName.c_str()}};
+            string caps = "video/x-raw, format=" PRELOAD_SOURCE_FORMAT ", " +
+                          whStr;
+            makeElement(m_inputElements,"appsrc",m_gstElementProperty,caps.c_str());
+
+            m_preloadSrc->attach(m_inputElements.front());
+        }
         else if (m_srcType == "image")
         {   
             string multifile_caps = "image/" +
@@ -496,6 +742,11 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
             {
                 m_format = "auto";
             }
+            /* Container files are looped with segment seeks so that the
+             * decoder is not flushed at every wrap.
+             */
+            m_segmentLoop = m_loop;
+
             m_gstElementProperty = {{"location",m_source.c_str()},
                                     {"name",srcName.c_str()}};
             makeElement(m_inputElements,"filesrc",m_gstElementProperty,NULL);
@@ -678,6 +929,20 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
                         caps.c_str());
         }
 
+        /* Outputs of tiovxmultiscaler are packed onto as few instances
+         * as possible, each sub-flow needing one output for the sensor
+         * path and one for its own pre-processing branch.
+         */
+        GstElement *multiScaler = nullptr;
+        int32_t     multiScalerOutputs = 0;
+        int32_t     numMultiScalers = 0;
+
+        m_preProcShareVec = preProcShareVec;
+        m_preProcDropVec  = preProcDropVec;
+        m_inPipelineVec   = inPipelineVec;
+        m_metadataOnlyVec = metadataOnlyVec;
+        m_preProcTeeVec.assign(preProcElementVec.size(), nullptr);
+
         /* NOTE: The assumption of the srcElemNames vector layout is as follows:
          * - srcElemNames[0]: direct input from the sensor (ex:- camera)
          * - srcElemNames[1]: pre-processed input
@@ -688,26 +953,46 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
 
             //Pre-Proc
             string drop = "false";
-            if (m_drop)
+            if (m_drop && m_throttle)
             {
                 drop = "true";
             }
 
+            /* Without throttling every frame is consumed, back pressure
+             * paces the source instead of the clock.
+             */
+            string sync = m_throttle ? "true" : "false";
+
             string appSinkBuffDepth = to_string(m_appSinkBuffDepth);
-            m_gstElementProperty = {{"drop",drop.c_str()},
-                                    {"max-buffers",appSinkBuffDepth.c_str()},
-                                    {"name",srcElemNames[j+1].c_str()}
-                                    };
-            makeElement(preProcElementVec[i],"appsink",m_gstElementProperty,NULL);
+            /* In-pipeline sub-flows end with the post-process element,
+             * named srcElemNames[j+1], instead.
+             */
+            if (!inPipelineVec[i])
+            {
+                m_gstElementProperty = {{"drop",drop.c_str()},
+                                        {"max-buffers",appSinkBuffDepth.c_str()},
+                                        {"sync",sync.c_str()},
+                                        {"name",srcElemNames[j+1].c_str()}
+                                        };
+                makeElement(preProcElementVec[i],"appsink",m_gstElementProperty,NULL);
+            }
             m_preProcElementVec.push_back(preProcElementVec[i]);
 
             m_gstElementProperty = {{"drop",drop.c_str()},
                                     {"max-buffers",appSinkBuffDepth.c_str()},
+                                    {"sync",sync.c_str()},
                                     {"name",srcElemNames[j].c_str()}
                                     };
-            //Sensor
+            //Sensor, absent if only the results are used
             vector<GstElement *> sensorElements;
-            makeElement(sensorElements,"appsink",m_gstElementProperty,NULL);
+            if (postProcElemVec[i] != nullptr)
+            {
+                sensorElements.push_back(postProcElemVec[i]);
+            }
+            if (!metadataOnlyVec[i])
+            {
+                makeElement(sensorElements,"appsink",m_gstElementProperty,NULL);
+            }
             m_sensorElementVec.push_back(sensorElements);
 
             //Scaler
@@ -724,35 +1009,53 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
                 subflowScalerElementVec.push_back({nullptr});
                 //Scaler Part
                 vector<GstElement *> sensorElement;
-                makeElement(sensorElement,"queue", m_gstElementProperty, NULL);
-                makeElement(sensorElement,
-                            gstElementMap["scaler"]["element"].as<string>().c_str(),
-                            m_gstElementProperty,
-                            sensorCaps.c_str());
+                if (!metadataOnlyVec[i])
+                {
+                    makeElement(sensorElement,"queue", m_gstElementProperty, NULL);
+                    makeElement(sensorElement,
+                                gstElementMap["scaler"]["element"].as<string>().c_str(),
+                                m_gstElementProperty,
+                                sensorCaps.c_str());
+                }
                 subflowScalerElementVec.push_back(sensorElement);
                 //Dl Part
                 subflowScalerElementVec.push_back(preProcScalerElementVec[i]);
             }
             else
             {
-                vector<GstElement *> scalerElement;
-                const string splitName = "multiscaler_split_" +
-                                         to_string(m_instId) +
-                                         to_string(i);
-                m_gstElementProperty = {{"name",splitName.c_str()}};
-                makeElement(scalerElement,
-                            gstElementMap["scaler"]["element"].as<string>().c_str(),
-                            m_gstElementProperty,
-                            NULL);
-                m_gstElementProperty.clear();
-                subflowScalerElementVec.push_back(scalerElement);
+                int32_t numOutputs = (preProcShareVec[i] < 0 ? 1 : 0) +
+                                     (metadataOnlyVec[i] ? 0 : 1);
+
+                if (multiScaler == nullptr ||
+                    multiScalerOutputs + numOutputs > MAX_SCALER_OUTPUTS)
+                {
+                    vector<GstElement *> scalerElement;
+                    const string splitName = "multiscaler_split_" +
+                                             to_string(m_instId) +
+                                             to_string(numMultiScalers);
+                    m_gstElementProperty = {{"name",splitName.c_str()}};
+                    makeElement(scalerElement,
+                                gstElementMap["scaler"]["element"].as<string>().c_str(),
+                                m_gstElementProperty,
+                                NULL);
+                    m_gstElementProperty.clear();
+                    multiScaler = scalerElement.back();
+                    multiScalerOutputs = 0;
+                    numMultiScalers++;
+                }
+
+                multiScalerOutputs += numOutputs;
+                subflowScalerElementVec.push_back({multiScaler});
 
                 //Scaler Part
                 vector<GstElement *> sensorElement;
-                makeElement(sensorElement,
-                            "queue",
-                            m_gstElementProperty,
-                            sensorCaps.c_str());
+                if (!metadataOnlyVec[i])
+                {
+                    makeElement(sensorElement,
+                                "queue",
+                                m_gstElementProperty,
+                                sensorCaps.c_str());
+                }
                 subflowScalerElementVec.push_back(sensorElement);
                 //Dl Part
                 subflowScalerElementVec.push_back(preProcScalerElementVec[i]);
@@ -760,17 +1063,24 @@ int32_t InputInfo::addGstPipeline(vector<vector<GstElement*>>   &preProcElementV
             m_scalerElementVec.push_back(subflowScalerElementVec);
         }
         
-        //Add tee element if not multiscaler or subflow size > 1
-        if (!m_scalerIsMulltiSrc || preProcElementVec.size() > 1)
+        //Add tee element if not multiscaler or more than one multiscaler
+        if (!m_scalerIsMulltiSrc || numMultiScalers > 1)
         {   
             string splitStr = "input" + to_string(m_instId) + "_split";
             m_gstElementProperty = {{"name",splitStr.c_str()}};
             makeElement(m_teeElement,"tee", m_gstElementProperty, NULL);
         }
 
-        m_srcElemNames.insert(m_srcElemNames.end(),
-                              srcElemNames.begin(),
-                              srcElemNames.end());
+        /* The sensor appsink of a metadata-only sub-flow does not exist. */
+        for (uint64_t j = 0; j < srcElemNames.size(); j++)
+        {
+            if (j % 2 == 0 && metadataOnlyVec[j / 2])
+            {
+                continue;
+            }
+
+            m_srcElemNames.push_back(srcElemNames[j]);
+        }
     }
     return status;
 }
@@ -882,6 +1192,8 @@ int32_t InputInfo::getSrcPipelines(vector<GstElement *>    &srcPipelines,
         lastInputElement = m_teeElement.back();
     }
 
+    GstElement *prevScaler = nullptr;
+
     //Iterate over each subflow
     for (unsigned i=0; i<m_scalerElementVec.size(); i++)
     {
@@ -889,143 +1201,186 @@ int32_t InputInfo::getSrcPipelines(vector<GstElement *>    &srcPipelines,
         vector<GstElement*> dl;
         vector<GstElement*> pre_proc_elements;
         vector<string>      firstPreProcFormatList;
+        bool                sharedPreProc = m_preProcShareVec[i] >= 0;
 
         dl = m_scalerElementVec[i].back();
         m_scalerElementVec[i].pop_back();
         pre_proc_elements = m_preProcElementVec[i];
 
-        factory = gst_element_get_factory(pre_proc_elements[0]);
-        firstPreProcFormatList = get_format_list(GST_OBJECT_NAME(factory),GST_PAD_SINK);
-
-        //If caps is any (like appsik) and the input_format is not rgb
-        if (firstPreProcFormatList[0] == "ANY" && subflow_format != "RGB")
+        if (sharedPreProc)
         {
-            YAML::Node colorConvertConfig;
-            colorConvertConfig = getColorConvertConfig(subflow_format,"RGB");
-
-            string pool_size;
-            string caps = "video/x-raw, format=RGB";
-            if(colorConvertConfig["property"] &&
-               colorConvertConfig["property"]["out-pool-size"])
-            {
-                pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
-                m_gstElementProperty = {{"out-pool-size",pool_size.c_str()}};
-            }
-            makeElement(dl,
-                        colorConvertConfig["element"].as<string>().c_str(),
-                        m_gstElementProperty,
-                        caps.c_str());
-            subflow_format = "RGB";
+            //Tap the branch of the sub-flow with the same pre-processing
+            makeElement(dl,"queue", m_gstElementProperty, NULL);
+            dl.push_back(pre_proc_elements.back());
+            addAndLink(pipeline,dl);
+            link(m_preProcTeeVec[m_preProcShareVec[i]],dl.front());
         }
-        //If caps is not any and the input_format is not supported by first element in pre_proc_element_list
-        else if(firstPreProcFormatList[0] != "ANY" &&
-                find(firstPreProcFormatList.begin(),
-                     firstPreProcFormatList.end(),
-                     subflow_format) == firstPreProcFormatList.end())
+        else
         {
-            YAML::Node colorConvertConfig;
+            factory = gst_element_get_factory(pre_proc_elements[0]);
+            firstPreProcFormatList = get_format_list(GST_OBJECT_NAME(factory),GST_PAD_SINK);
 
-            vector<string> best_guess = {"RGB","NV12","NV21","I420"};
-            string flag_format = "";
-            for(unsigned j=0; j<best_guess.size(); j++)
+            //If caps is any (like appsik) and the input_format is not rgb
+            if (firstPreProcFormatList[0] == "ANY" && subflow_format != "RGB")
             {
-                if(find(firstPreProcFormatList.begin(),
-                        firstPreProcFormatList.end(),
-                        best_guess[j]) != firstPreProcFormatList.end())
+                YAML::Node colorConvertConfig;
+                colorConvertConfig = getColorConvertConfig(subflow_format,"RGB");
+
+                string pool_size;
+                string caps = "video/x-raw, format=RGB";
+                if(colorConvertConfig["property"] &&
+                   colorConvertConfig["property"]["out-pool-size"])
                 {
-                    flag_format = best_guess[j];
-                    break;
+                    pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
+                    m_gstElementProperty = {{"out-pool-size",pool_size.c_str()}};
                 }
+                makeElement(dl,
+                            colorConvertConfig["element"].as<string>().c_str(),
+                            m_gstElementProperty,
+                            caps.c_str());
+                subflow_format = "RGB";
             }
-            if (flag_format == "")
-            {
-                LOG_ERROR("%s does not support any of ['RGB','NV12','NV21','I420'].\n",
-                          gst_element_get_name(pre_proc_elements[0]));
-                throw runtime_error("Failed to create Gstreamer Pipeline.");
-            }
-
-            colorConvertConfig = getColorConvertConfig(subflow_format,flag_format);
-
-            string caps = "video/x-raw, format=" + flag_format;
-            string out_pool_size;
-            if(colorConvertConfig["property"] &&
-               colorConvertConfig["property"]["out-pool-size"])
+            //If caps is not any and the input_format is not supported by first element in pre_proc_element_list
+            else if(firstPreProcFormatList[0] != "ANY" &&
+                    find(firstPreProcFormatList.begin(),
+                         firstPreProcFormatList.end(),
+                         subflow_format) == firstPreProcFormatList.end())
             {
-                out_pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
-                m_gstElementProperty = {{"out-pool-size",out_pool_size.c_str()}};
-            }
-            makeElement(dl,
-                        colorConvertConfig["element"].as<string>().c_str(),
-                        m_gstElementProperty,
-                        caps.c_str());
-            subflow_format = flag_format;
-        }
+                YAML::Node colorConvertConfig;
 
-        dl.insert(dl.end(),pre_proc_elements.begin(),pre_proc_elements.end()-1);
+                vector<string> best_guess = {"RGB","NV12","NV21","I420"};
+                string flag_format = "";
+                for(unsigned j=0; j<best_guess.size(); j++)
+                {
+                    if(find(firstPreProcFormatList.begin(),
+                            firstPreProcFormatList.end(),
+                            best_guess[j]) != firstPreProcFormatList.end())
+                    {
+                        flag_format = best_guess[j];
+                        break;
+                    }
+                }
+                if (flag_format == "")
+                {
+                    LOG_ERROR("%s does not support any of ['RGB','NV12','NV21','I420'].\n",
+                              gst_element_get_name(pre_proc_elements[0]));
+                    throw runtime_error("Failed to create Gstreamer Pipeline.");
+                }
 
-        const gchar* struct_name = get_structure_name(dl.back(), "sink");
-        //If name isnt "application/x-tensor-tiovx"
-        if(g_strcmp0(struct_name,"application/x-tensor-tiovx") != 0 )
-        {
-            if(subflow_format != "RGB")
-            {
-                YAML::Node colorConvertConfig;
-                colorConvertConfig = getColorConvertConfig(subflow_format, "RGB");
+                colorConvertConfig = getColorConvertConfig(subflow_format,flag_format);
 
-                string caps = "video/x-raw, format=RGB";
-                string pool_size;
+                string caps = "video/x-raw, format=" + flag_format;
+                string out_pool_size;
                 if(colorConvertConfig["property"] &&
                    colorConvertConfig["property"]["out-pool-size"])
                 {
-                    pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
-                    m_gstElementProperty = {{"out-pool-size",pool_size.c_str()}};
+                    out_pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
+                    m_gstElementProperty = {{"out-pool-size",out_pool_size.c_str()}};
                 }
                 makeElement(dl,
                             colorConvertConfig["element"].as<string>().c_str(),
                             m_gstElementProperty,
                             caps.c_str());
-                subflow_format = "RGB";
+                subflow_format = flag_format;
             }
-        }
 
-        addAndLink(pipeline,dl);
+            dl.insert(dl.end(),pre_proc_elements.begin(),pre_proc_elements.end()-1);
 
-        GstElement *DlAppsink = pre_proc_elements.back();
-        pre_proc_elements.clear();
-        gst_bin_add (GST_BIN(pipeline), DlAppsink);
+            const gchar* struct_name = get_structure_name(dl.back(), "sink");
+            //If name isnt "application/x-tensor-tiovx"
+            if(g_strcmp0(struct_name,"application/x-tensor-tiovx") != 0 )
+            {
+                if(subflow_format != "RGB")
+                {
+                    YAML::Node colorConvertConfig;
+                    colorConvertConfig = getColorConvertConfig(subflow_format, "RGB");
 
-        if (!gstElementMap["dlpreproc"]["element"])
-        {
-            /*Workaround for issue where dl inferer expects aligned buffer but
-            * videoconvert not able to give.
-            */
-            /* Check if tiovxmemalloc is present. */
-            GstElementFactory *tiovxmemalloc_factory;
-            tiovxmemalloc_factory = gst_element_factory_find("tiovxmemalloc");
-            if (tiovxmemalloc_factory != NULL)
+                    string caps = "video/x-raw, format=RGB";
+                    string pool_size;
+                    if(colorConvertConfig["property"] &&
+                       colorConvertConfig["property"]["out-pool-size"])
+                    {
+                        pool_size = colorConvertConfig["property"]["out-pool-size"].as<string>();
+                        m_gstElementProperty = {{"out-pool-size",pool_size.c_str()}};
+                    }
+                    makeElement(dl,
+                                colorConvertConfig["element"].as<string>().c_str(),
+                                m_gstElementProperty,
+                                caps.c_str());
+                    subflow_format = "RGB";
+                }
+            }
+
+            //Split the branch to the sub-flows sharing it
+            if (find(m_preProcShareVec.begin(),
+                     m_preProcShareVec.end(),
+                     static_cast<int32_t>(i)) != m_preProcShareVec.end())
+            {
+                makeElement(dl,"tee", m_gstElementProperty, NULL);
+                m_preProcTeeVec[i] = dl.back();
+                makeElement(dl,"queue", m_gstElementProperty, NULL);
+            }
+
+            addAndLink(pipeline,dl);
+
+            //Drop the frames that will not be inferred
+            if (m_preProcDropVec[i] > 1)
+            {
+                GstPad        *pad = gst_element_get_static_pad(dl.front(), "sink");
+                BranchDropCtx *ctx = new BranchDropCtx();
+
+                ctx->interval = m_preProcDropVec[i];
+                gst_pad_add_probe(pad,
+                                  GST_PAD_PROBE_TYPE_BUFFER,
+                                  dropBranchBuffer,
+                                  ctx,
+                                  freeBranchDropCtx);
+                gst_object_unref(pad);
+            }
+
+            GstElement *DlAppsink = pre_proc_elements.back();
+            pre_proc_elements.clear();
+            gst_bin_add (GST_BIN(pipeline), DlAppsink);
+
+            if (!gstElementMap["dlpreproc"]["element"])
+            {
+                /*Workaround for issue where dl inferer expects aligned buffer but
+                * videoconvert not able to give.
+                */
+                /* Check if tiovxmemalloc is present. */
+                GstElementFactory *tiovxmemalloc_factory;
+                tiovxmemalloc_factory = gst_element_factory_find("tiovxmemalloc");
+                if (tiovxmemalloc_factory != NULL)
+                {
+                    vector<GstElement *> memAllocElement;
+                    m_gstElementProperty = {{"pool-size","4"}};
+                    makeElement(memAllocElement,"tiovxmemalloc",m_gstElementProperty,NULL);
+                    addAndLink(pipeline,memAllocElement);
+                    link(dl.back(),memAllocElement.front());
+                    link(memAllocElement.back(),DlAppsink);
+                    gst_object_unref(tiovxmemalloc_factory);
+                }
+                else
+                {
+                    link(dl.back(),DlAppsink);
+                }
+            }
+            else if (m_inPipelineVec[i])
             {
-                vector<GstElement *> memAllocElement;
-                m_gstElementProperty = {{"pool-size","4"}};
-                makeElement(memAllocElement,"tiovxmemalloc",m_gstElementProperty,NULL);
-                addAndLink(pipeline,memAllocElement);
-                link(dl.back(),memAllocElement.front());
-                link(memAllocElement.back(),DlAppsink);
-                gst_object_unref(tiovxmemalloc_factory);
+                //The inferer feeds the tensors of the post-process element
+                gst_element_link_pads(dl.back(), "src", DlAppsink, "tensor");
             }
             else
             {
                 link(dl.back(),DlAppsink);
             }
         }
-        else
-        {
-            link(dl.back(),DlAppsink);
-        }
 
         vector<GstElement*> sensor;
         sensor = m_scalerElementVec[i].back();
         m_scalerElementVec[i].pop_back();
-        if (input_format != "RGB")
+        bool hasSensor = !m_metadataOnlyVec[i];
+        if (hasSensor && input_format != "RGB")
         {
             YAML::Node colorConvertConfig;
             colorConvertConfig = getColorConvertConfig(input_format, "RGB");
@@ -1051,13 +1406,36 @@ int32_t InputInfo::getSrcPipelines(vector<GstElement *>    &srcPipelines,
                         m_gstElementProperty,
                         caps.c_str());
         }
-        sensor.insert(sensor.end(),m_sensorElementVec[i].begin(),m_sensorElementVec[i].end());
-        addAndLink(pipeline,sensor);
+        if (!hasSensor)
+        {
+            //Only the results are used, there is no sensor branch
+        }
+        else if (m_inPipelineVec[i])
+        {
+            //The frames go through the post-process element to the appsink
+            GstElement *postProc = m_preProcElementVec[i].back();
+
+            addAndLink(pipeline,sensor);
+            gst_element_link_pads(sensor.back(), "src", postProc, "sink");
+            addAndLink(pipeline,m_sensorElementVec[i]);
+            link(postProc,m_sensorElementVec[i].front());
+        }
+        else
+        {
+            sensor.insert(sensor.end(),m_sensorElementVec[i].begin(),m_sensorElementVec[i].end());
+            addAndLink(pipeline,sensor);
+        }
 
         if (!m_scalerIsMulltiSrc)
         {
-            link(lastInputElement,dl.front());
-            link(lastInputElement,sensor.front());
+            if (!sharedPreProc)
+            {
+                link(lastInputElement,dl.front());
+            }
+            if (hasSensor)
+            {
+                link(lastInputElement,sensor.front());
+            }
         }
 
         else
@@ -1066,24 +1444,36 @@ int32_t InputInfo::getSrcPipelines(vector<GstElement *>    &srcPipelines,
             scaler = m_scalerElementVec[i].back();
             m_scalerElementVec[i].pop_back();
 
-            if(m_scalerElementVec.size()>1)
+            //Consecutive sub-flows may be packed onto the same multiscaler
+            if (scaler.back() != prevScaler)
             {
-                /**
-                    Add queue before tiovxmultiscaler only when it connects
-                    to tee before it. Tee element will only be present when
-                    theres two multiscaler needed i.e when there are more
-                    than 2 subflows
-                */
-                vector<GstElement*> queue;
-                makeElement(queue,"queue", m_gstElementProperty, NULL);
-                scaler.insert(scaler.begin(),queue[0]);
+                prevScaler = scaler.back();
+
+                if(m_teeElement.size()>0)
+                {
+                    /**
+                        Add queue before tiovxmultiscaler only when it connects
+                        to tee before it. Tee element will only be present when
+                        the sub-flows need more outputs than one multiscaler
+                        provides.
+                    */
+                    vector<GstElement*> queue;
+                    makeElement(queue,"queue", m_gstElementProperty, NULL);
+                    scaler.insert(scaler.begin(),queue[0]);
+                }
+
+                addAndLink(pipeline,scaler);
+                link(lastInputElement,scaler.front());
             }
-            
-            addAndLink(pipeline,scaler);
 
-            link(lastInputElement,scaler.front());
-            link(scaler.back(),dl.front());
-            link(scaler.back(),sensor.front());
+            if (!sharedPreProc)
+            {
+                link(scaler.back(),dl.front());
+            }
+            if (hasSensor)
+            {
+                link(scaler.back(),sensor.front());
+            }
         }
 
     }
@@ -1166,6 +1556,7 @@ YAML::Node InputInfo::getColorConvertConfig(string inputFmt, string outputFmt)
 InputInfo::~InputInfo()
 {
     LOG_DEBUG("DESTRUCTOR\n");
+    delete m_preloadSrc;
 }
 
 int32_t OutputInfo::m_numInstances = 0;
@@ -1179,9 +1570,19 @@ OutputInfo::OutputInfo(const YAML::Node    &node,
     m_bkgndElemName = "background" + to_string(m_instId);
     m_mosaicElemName = "mosaic" + to_string(m_instId);
 
-    m_sink   = node["sink"].as<string>();
-    m_width  = node["width"].as<int32_t>();
-    m_height = node["height"].as<int32_t>();
+    /* Several sinks may share the output, and its encoders. */
+    if (node["sink"].IsSequence())
+    {
+        m_sinks = node["sink"].as<vector<string>>();
+    }
+    else
+    {
+        m_sinks = {node["sink"].as<string>()};
+    }
+
+    m_sink   = m_sinks.empty() ? "" : m_sinks[0];
+    m_width  = node["width"].as<int32_t>();
+    m_height = node["height"].as<int32_t>();
 
     if (node["connector"])
     {
@@ -1211,6 +1612,34 @@ OutputInfo::OutputInfo(const YAML::Node    &node,
     {
         m_overlayPerfType = node["overlay-perf-type"].as<string>();
     }
+    if (node["socket"])
+    {
+        m_frameExportConfig.path = node["socket"].as<string>();
+    }
+    if (node["slots"])
+    {
+        m_frameExportConfig.numSlots = node["slots"].as<int32_t>();
+    }
+    if (node["policy"])
+    {
+        m_frameExportConfig.block = node["policy"].as<string>() == "block";
+    }
+    if (node["block-timeout"])
+    {
+        m_frameExportConfig.blockTimeout = node["block-timeout"].as<int32_t>();
+    }
+#if defined(EDGEAI_ENABLE_RTSP_SERVER)
+    if (node["rtsp-port"])
+    {
+        m_rtspConfig.port = node["rtsp-port"].as<int32_t>();
+    }
+    if (node["rtsp-path"])
+    {
+        m_rtspConfig.path = node["rtsp-path"].as<string>();
+    }
+#endif // defined(EDGEAI_ENABLE_RTSP_SERVER)
+    m_frameExportConfig.width  = m_width;
+    m_frameExportConfig.height = m_height;
     LOG_DEBUG("CONSTRUCTOR\n");
 }
 
@@ -1256,63 +1685,132 @@ int32_t OutputInfo::appendGstPipeline()
         makeElement(m_dispElements,"tiperfoverlay",m_gstElementProperty,NULL);
     }
 
-    string  sinkType;
-    string  sinkExt;
-    sinkExt = filesystem::path(m_sink).extension();
-
-    if (gVideoEncMap.find(sinkExt) != gVideoEncMap.end())
+    if (m_sinks.empty())
     {
-        sinkType = "video";
+        LOG_ERROR("No sink defined for output [%d].\n", m_instId);
+        throw runtime_error("Failed to create Gstreamer Pipeline.");
     }
-    else if (sinkExt == ".jpg")
+
+    /* Sort the sinks by the stream they take, raw frames or one of the
+     * encodings.
+     */
+    map<string, vector<vector<GstElement *>>>  encodedSinks;
+    vector<vector<GstElement *>>                rawSinks;
+
+    for (uint32_t i = 0; i < m_sinks.size(); i++)
     {
-        sinkType = "image";
+        vector<GstElement *>    sinkElements;
+        string                  name = "sink" + to_string(m_instId);
+
+        if (i > 0)
+        {
+            name += "_" + to_string(i);
+        }
+
+        string codec = makeSinkElements(m_sinks[i], name, sinkElements);
+
+        if (codec.empty())
+        {
+            rawSinks.push_back(sinkElements);
+        }
+        else
+        {
+            encodedSinks[codec].push_back(sinkElements);
+        }
     }
-    else if (m_sink == "kmssink")
+
+    /* The frames are encoded once per encoding, the sinks sharing an
+     * encoding tap a tee after the encoder. A single sink is linked
+     * directly.
+     */
+    int32_t numTaps = rawSinks.size() + encodedSinks.size();
+
+    if (numTaps > 1)
     {
-        sinkType = "display";
+        m_gstElementProperty = {};
+        makeElement(m_dispElements,"tee",m_gstElementProperty,NULL);
     }
-    else if (m_sink == "remote")
+
+    for (auto &sinkElements : rawSinks)
     {
-        sinkType = "remote";
+        appendDispBranch(-1, numTaps > 1, sinkElements);
     }
-    else
+
+    for (auto &[codec, sinks] : encodedSinks)
     {
-        sinkType = "others";
-    }
+        vector<GstElement *>    encElements;
+        int32_t                 encBranch;
 
-    string name = "sink" + to_string(m_instId);
+        makeEncoderElements(codec, encElements);
 
-    if (sinkType == "display")
-    {
-        m_gstElementProperty = {{"sync","false"},
-                                {"driver-name","tidss"},
-                                {"force-modesetting","true"},
-                                {"name",name.c_str()}};
-        if (m_connector)
+        if (sinks.size() > 1)
         {
-            string conn_id = to_string(m_connector);
-            m_gstElementProperty.push_back({"connector-id",conn_id.c_str()});
+            m_gstElementProperty = {};
+            makeElement(encElements,"tee",m_gstElementProperty,NULL);
         }
-        makeElement(m_dispElements,"kmssink",m_gstElementProperty,NULL);
+
+        encBranch = appendDispBranch(-1, numTaps > 1, encElements);
+
+        for (auto &sinkElements : sinks)
+        {
+            appendDispBranch(encBranch, sinks.size() > 1, sinkElements);
+        }
+    }
+
+    return 0;
+
+}
+
+int32_t OutputInfo::appendDispBranch(int32_t                        parent,
+                                     bool                           tapped,
+                                     const vector<GstElement *>    &elements)
+{
+    if (!tapped)
+    {
+        auto &chain = parent < 0 ? m_dispElements : m_dispBranches[parent];
+
+        chain.insert(chain.end(), elements.begin(), elements.end());
+        return parent;
     }
 
-    else if (sinkType == "image")
+    vector<GstElement *> branch;
+
+    m_gstElementProperty = {};
+    makeElement(branch,"queue",m_gstElementProperty,NULL);
+    branch.insert(branch.end(), elements.begin(), elements.end());
+
+    m_dispBranches.push_back(branch);
+    m_dispBranchParents.push_back(parent);
+
+    return m_dispBranches.size() - 1;
+}
+
+void OutputInfo::addDispElements(GstElement *sinkPipeline)
+{
+    addAndLink(sinkPipeline,m_dispElements);
+
+    for (uint32_t i = 0; i < m_dispBranches.size(); i++)
     {
-        makeElement(m_dispElements,
-                    gstElementMap["jpegenc"]["element"].as<string>().c_str(),
-                    m_gstElementProperty,
-                    NULL);
+        int32_t     parent = m_dispBranchParents[i];
+        GstElement *tee = parent < 0 ? m_dispElements.back() :
+                                       m_dispBranches[parent].back();
 
-        m_gstElementProperty = {{"location",m_sink.c_str()},
-                                {"name",name.c_str()}};
-        makeElement(m_dispElements,"multifilesink",m_gstElementProperty,NULL);
+        addAndLink(sinkPipeline,m_dispBranches[i]);
+        link(tee,m_dispBranches[i].front());
     }
+}
 
-    else if (sinkType == "video")
+void OutputInfo::makeEncoderElements(const string          &codec,
+                                     vector<GstElement *>  &elements)
+{
+    if (codec == "h264")
     {
         string h264enc = gstElementMap["h264enc"]["element"].as<string>();
         string encoder_extra_ctrl = "";
+        string bitrate;
+        string gopSize;
+
+        m_gstElementProperty = {};
 
         if (h264enc == "v4l2h264enc")
         {
@@ -1323,66 +1821,107 @@ int32_t OutputInfo::appendGstPipeline()
 
             m_gstElementProperty = {{"extra-controls",encoder_extra_ctrl.c_str()}};
         }
+        else if (h264enc == "x264enc")
+        {
+            /* Software encoder of the host builds, bitrate is in kbit/s. */
+            bitrate = to_string(m_bitrate/1000);
+            gopSize = to_string(m_gopSize);
+
+            m_gstElementProperty = {{"bitrate",bitrate.c_str()},
+                                    {"key-int-max",gopSize.c_str()}};
+        }
 
-        makeElement(m_dispElements,h264enc.c_str(),m_gstElementProperty,NULL);
+        makeElement(elements,h264enc.c_str(),m_gstElementProperty,NULL);
+    }
+    else if (codec == "jpeg")
+    {
+        string jpegenc = gstElementMap["jpegenc"]["element"].as<string>();
+
+        m_gstElementProperty = {};
+        makeElement(elements,jpegenc.c_str(),m_gstElementProperty,NULL);
+    }
+}
 
+string OutputInfo::makeSinkElements(const string           &sink,
+                                    const string           &name,
+                                    vector<GstElement *>   &elements)
+{
+    string  sinkExt;
+    string  codec;
+
+    sinkExt = filesystem::path(sink).extension();
+    m_gstElementProperty = {};
+
+    if (gVideoEncMap.find(sinkExt) != gVideoEncMap.end())
+    {
         for(unsigned i=0;i<gVideoEncMap[sinkExt].size();i++)
         {
-            makeElement(m_dispElements,
+            makeElement(elements,
                         gVideoEncMap[sinkExt][i].c_str(),
                         m_gstElementProperty,
                         NULL);
         }
 
-        m_gstElementProperty = {{"location",m_sink.c_str()},
+        m_gstElementProperty = {{"location",sink.c_str()},
                                 {"name",name.c_str()}};
 
-        makeElement(m_dispElements,"filesink",m_gstElementProperty,NULL);
+        makeElement(elements,"filesink",m_gstElementProperty,NULL);
+        codec = "h264";
+    }
+
+    else if (sinkExt == ".jpg")
+    {
+        m_gstElementProperty = {{"location",sink.c_str()},
+                                {"name",name.c_str()}};
+        makeElement(elements,"multifilesink",m_gstElementProperty,NULL);
+        codec = "jpeg";
     }
-    else if (sinkType == "remote")
+
+    else if (sink == "kmssink")
     {
-        string h264enc = "";
-        string encoder_extra_ctrl = "";
-        string jpegenc = "";
+        string conn_id = to_string(m_connector);
 
-        if (m_encoding == "mp4" || m_encoding == "h264")
+        m_gstElementProperty = {{"sync","false"},
+                                {"driver-name","tidss"},
+                                {"force-modesetting","true"},
+                                {"name",name.c_str()}};
+        if (m_connector)
         {
-            h264enc = gstElementMap["h264enc"]["element"].as<string>();
-            if (h264enc == "v4l2h264enc")
-            {
-                encoder_extra_ctrl = "controls"
-                                    ",frame_level_rate_control_enable=1"
-                                    ",video_bitrate=" + to_string(m_bitrate) +
-                                    ",video_gop_size=" + to_string(m_gopSize);
+            m_gstElementProperty.push_back({"connector-id",conn_id.c_str()});
+        }
+        makeElement(elements,"kmssink",m_gstElementProperty,NULL);
+    }
 
-                m_gstElementProperty = {{"extra-controls",encoder_extra_ctrl.c_str()}};
-            }
+    else if (sink == "remote")
+    {
+        string port = to_string(m_port);
 
-            makeElement(m_dispElements,h264enc.c_str(),m_gstElementProperty,NULL);
-            makeElement(m_dispElements,"h264parse",m_gstElementProperty,NULL);
+        if (m_encoding == "mp4" || m_encoding == "h264")
+        {
+            makeElement(elements,"h264parse",m_gstElementProperty,NULL);
 
             if (m_encoding == "mp4")
             {
                 m_gstElementProperty = {{"fragment-duration","1"}};
-                makeElement(m_dispElements,"mp4mux",m_gstElementProperty,NULL);
+                makeElement(elements,"mp4mux",m_gstElementProperty,NULL);
             }
             else if (m_encoding == "h264")
             {
-                makeElement(m_dispElements,"rtph264pay",m_gstElementProperty,NULL);
+                makeElement(elements,"rtph264pay",m_gstElementProperty,NULL);
             }
 
+            codec = "h264";
         }
 
         else if (m_encoding == "jpeg")
         {
-            jpegenc = gstElementMap["jpegenc"]["element"].as<string>();
-            makeElement(m_dispElements,jpegenc.c_str(),m_gstElementProperty,NULL);
-
             m_gstElementProperty = {{"boundary","spionisto"}};
-            makeElement(m_dispElements,"multipartmux",m_gstElementProperty,NULL);
+            makeElement(elements,"multipartmux",m_gstElementProperty,NULL);
 
             m_gstElementProperty = {{"max","65000"}};
-            makeElement(m_dispElements,"rndbuffersize",m_gstElementProperty,NULL);
+            makeElement(elements,"rndbuffersize",m_gstElementProperty,NULL);
+
+            codec = "jpeg";
         }
 
         else
@@ -1393,20 +1932,61 @@ int32_t OutputInfo::appendGstPipeline()
 
         m_gstElementProperty = {{"sync","false"},
                                 {"host",m_host.c_str()},
-                                {"port",to_string(m_port).c_str()},
+                                {"port",port.c_str()},
                                 {"name",name.c_str()}};
 
-        makeElement(m_dispElements,"udpsink",m_gstElementProperty,NULL);
+        makeElement(elements,"udpsink",m_gstElementProperty,NULL);
 
     }
-    else if (sinkType == "others")
+    else if (sink == "rtsp")
     {
-        m_gstElementProperty = {{"name",name.c_str()}};
-        makeElement(m_dispElements,m_sink.c_str(),m_gstElementProperty,NULL);
+#if defined(EDGEAI_ENABLE_RTSP_SERVER)
+        /* Any number of clients are served from the single encode. */
+        if (m_rtspServer != nullptr)
+        {
+            LOG_ERROR("Only one rtsp sink is allowed per output.\n");
+            throw runtime_error("Failed to create Gstreamer Pipeline.");
+        }
+
+        m_rtspConfig.dumpInfo();
+        m_rtspServer = new RtspServer(m_rtspConfig, name);
+        elements.push_back(m_rtspServer->getElement());
+        codec = "h264";
+#else
+        LOG_ERROR("The rtsp sink is not supported by this build.\n");
+        throw runtime_error("Failed to create Gstreamer Pipeline.");
+#endif // defined(EDGEAI_ENABLE_RTSP_SERVER)
     }
+    else if (sink == "fakesink")
+    {
+        /* Discard the frames without waiting on the clock. Used for
+         * headless and benchmark runs.
+         */
+        m_gstElementProperty = {{"sync","false"},
+                                {"async","false"},
+                                {"name",name.c_str()}};
+        makeElement(elements,"fakesink",m_gstElementProperty,NULL);
+    }
+    else if (sink == "shm")
+    {
+        /* Share the raw frames with the local processes, no encoding. */
+        if (m_frameExporter != nullptr)
+        {
+            LOG_ERROR("Only one shm sink is allowed per output.\n");
+            throw runtime_error("Failed to create Gstreamer Pipeline.");
+        }
 
-    return 0;
+        m_frameExportConfig.dumpInfo();
+        m_frameExporter = new FrameExporter(m_frameExportConfig, name);
+        elements.push_back(m_frameExporter->getElement());
+    }
+    else
+    {
+        m_gstElementProperty = {{"name",name.c_str()}};
+        makeElement(elements,sink.c_str(),m_gstElementProperty,NULL);
+    }
 
+    return codec;
 }
 
 int32_t OutputInfo::getBgPipeline(GstElement*       &sinkPipeline,
@@ -1448,7 +2028,14 @@ int32_t OutputInfo::getBgPipeline(GstElement*       &sinkPipeline,
 
 void OutputInfo::dumpInfo(const char *prefix) const
 {
-    LOG_INFO("%sOutputInfo::sink         = %s\n", prefix, m_sink.c_str());
+    LOG_INFO("%sOutputInfo::sink         = [ ", prefix);
+
+    for (auto const &s : m_sinks)
+    {
+        LOG_INFO_RAW("%s ", s.c_str());
+    }
+
+    LOG_INFO_RAW("]\n");
     LOG_INFO("%sOutputInfo::width        = %d\n", prefix, m_width);
     LOG_INFO("%sOutputInfo::height       = %d\n", prefix, m_height);
     LOG_INFO("%sOutputInfo::connector    = %d\n", prefix, m_connector);
@@ -1561,6 +2148,11 @@ OutputInfo::~OutputInfo()
 
     /* Free the buffer. */
     m_gstPipe->freeBuffer(m_outBuff);
+
+    delete m_frameExporter;
+#if defined(EDGEAI_ENABLE_RTSP_SERVER)
+    delete m_rtspServer;
+#endif // defined(EDGEAI_ENABLE_RTSP_SERVER)
 }
 
 MosaicInfo::MosaicInfo(vector<int> data)
@@ -1623,16 +2215,49 @@ ModelInfo::ModelInfo(const YAML::Node &node)
         m_topN = node["topN"].as<int32_t>();
     }
 
+    if (node["replay_path"])
+    {
+        m_replay           = true;
+        m_replayCfg.path   = node["replay_path"].as<string>();
+
+        if (node["replay_latency"])
+        {
+            m_replayCfg.latency = node["replay_latency"].as<float>();
+        }
+
+        if (node["replay_jitter"])
+        {
+            m_replayCfg.jitter = node["replay_jitter"].as<float>();
+        }
+
+        if (node["replay_distribution"])
+        {
+            m_replayCfg.distribution = node["replay_distribution"].as<string>();
+        }
+
+        if (node["replay_seed"])
+        {
+            m_replayCfg.seed = node["replay_seed"].as<uint32_t>();
+        }
+    }
+
+    if (node["replicas"])
+    {
+        m_replicas = max(node["replicas"].as<int32_t>(), 1);
+    }
+
+    if (node["infer_time"])
+    {
+        m_inferTime = node["infer_time"].as<float>();
+    }
+
     LOG_DEBUG("CONSTRUCTOR\n");
 }
 
 int32_t ModelInfo::initialize()
 {
     YAML::Node          yaml;
-    InfererConfig       infConfig;
     int32_t             status = 0;
-    bool                enableTidl = false;
-    int                 coreId = 1;
     // Check if the specified configuration file exists
     if (!std::filesystem::exists(m_modelPath))
     {
@@ -1641,47 +2266,24 @@ int32_t ModelInfo::initialize()
         status = -1;
     }
 
-    if (status == 0)
+    if (status == 0 && m_replay)
     {
-        string infererTarget = gstElementMap["inferer"]["target"].as<string>();
-        if (infererTarget == "dsp")
-        {
-            enableTidl = true;
-            if (gstElementMap["inferer"]["core-id"])
-            {
-                vector<int> coreIds = gstElementMap["inferer"]["core-id"].as<vector<int>>();
-                coreId = coreIds[C7_CORE_ID_INDEX];
-                C7_CORE_ID_INDEX ++;
-                if(C7_CORE_ID_INDEX >= coreIds.size())
-                {
-                    C7_CORE_ID_INDEX = 0;
-                }
-            }
-        }
-
-        else if (infererTarget != "arm")
+        /* The model directory is still needed for the pre and post
+         * processing parameters, only the inference is replaced.
+         */
+        try
         {
-            LOG_ERROR("Invalid target specified for inferer. Defaulting to ARM.\n");
+            m_infererObj = new ReplayInferer(m_replayCfg);
         }
-
-        // Populate infConfig
-        status = infConfig.getConfig(m_modelPath, enableTidl, coreId);
-
-        if (status < 0)
+        catch (const runtime_error &e)
         {
-            LOG_ERROR("getConfig() failed.\n");
+            LOG_ERROR("%s\n", e.what());
+            status = -1;
         }
     }
-
-    if (status == 0)
+    else if (status == 0 && !m_inPipelineOnly)
     {
-        m_infererObj = DLInferer::makeInferer(infConfig);
-
-        if (m_infererObj == nullptr)
-        {
-            LOG_ERROR("DLInferer::makeInferer() failed.\n");
-            status = -1;
-        }
+        status = createInferer();
     }
 
     // Populate pre-process config from yaml
@@ -1709,17 +2311,24 @@ int32_t ModelInfo::initialize()
     // Populate post-process config from yaml
     if (status == 0)
     {
-        const VecDlTensor  *dlInfOutputs;
+        const VecDlTensor  *dlInfOutputs{nullptr};
         const VecDlTensor  *dlInfInputs;
         const DlTensor     *ifInfo;
 
-        /* Query the output information for setting up the output buffers. */
-        dlInfOutputs = m_infererObj->getOutputInfo();
+        /* A model only run in the pipeline has no inference object. The
+         * tensor information is only used by the processing done in the
+         * application.
+         */
+        if (m_infererObj != nullptr)
+        {
+            /* Query the output information for setting up the output buffers. */
+            dlInfOutputs = m_infererObj->getOutputInfo();
 
-        /* Query the input information for setting the tensor type in pre process. */
-        dlInfInputs = m_infererObj->getInputInfo();
-        ifInfo = &dlInfInputs->at(0);
-        m_preProcCfg.inputTensorTypes[0] = ifInfo->type;
+            /* Query the input information for setting the tensor type in pre process. */
+            dlInfInputs = m_infererObj->getInputInfo();
+            ifInfo = &dlInfInputs->at(0);
+            m_preProcCfg.inputTensorTypes[0] = ifInfo->type;
+        }
 
         /* Set input data width and height based on the infererence engine
          * information. This is only used for semantic segmentation models
@@ -1736,15 +2345,18 @@ int32_t ModelInfo::initialize()
          * For all other cases, the default values (set in the post-process
          * obhect are used.
          */
-        ifInfo = &dlInfOutputs->at(0);
-
         if (m_postProcCfg.taskType == "segmentation")
         {
             /* Either NCHW or CHW. Width is the last dimention and the height
              * is the previous to last.
              */
-            m_postProcCfg.inDataWidth  = ifInfo->shape[ifInfo->dim - 1];
-            m_postProcCfg.inDataHeight = ifInfo->shape[ifInfo->dim - 2];
+            if (dlInfOutputs != nullptr)
+            {
+                ifInfo = &dlInfOutputs->at(0);
+                m_postProcCfg.inDataWidth  = ifInfo->shape[ifInfo->dim - 1];
+                m_postProcCfg.inDataHeight = ifInfo->shape[ifInfo->dim - 2];
+            }
+
             m_postProcCfg.alpha        = m_alpha;
         }
         else
@@ -1779,11 +2391,181 @@ int32_t ModelInfo::initialize()
     return status;
 }
 
+int32_t ModelInfo::createInferer()
+{
+    vector<DLInferer *> replicas;
+    int32_t             status = 0;
+    bool                enableTidl = false;
+    string infererTarget = gstElementMap["inferer"]["target"].as<string>();
+
+    if (infererTarget == "dsp")
+    {
+        enableTidl = true;
+        if (m_coreIds.empty() && gstElementMap["inferer"]["core-id"])
+        {
+            vector<int> coreIds = gstElementMap["inferer"]["core-id"].as<vector<int>>();
+            int32_t     numReplicas = min(m_replicas, (int32_t)coreIds.size());
+
+            for (int32_t i = 0; i < numReplicas; i++)
+            {
+                m_coreIds.push_back(coreIds[C7_CORE_ID_INDEX]);
+                C7_CORE_ID_INDEX ++;
+                if(C7_CORE_ID_INDEX >= coreIds.size())
+                {
+                    C7_CORE_ID_INDEX = 0;
+                }
+            }
+        }
+    }
+
+    else if (infererTarget != "arm")
+    {
+        LOG_ERROR("Invalid target specified for inferer. Defaulting to ARM.\n");
+    }
+
+    /* Replicas are only created on separate DSP cores, a single instance
+     * is used otherwise.
+     */
+    vector<int32_t> coreIds(m_coreIds);
+    if (coreIds.empty())
+    {
+        coreIds.push_back(1);
+    }
+
+    for (auto const &coreId : coreIds)
+    {
+        InfererConfig   infConfig;
+        DLInferer      *inferer;
+
+        // Populate infConfig
+        status = infConfig.getConfig(m_modelPath, enableTidl, coreId);
+
+        if (status < 0)
+        {
+            LOG_ERROR("getConfig() failed.\n");
+            break;
+        }
+
+        inferer = DLInferer::makeInferer(infConfig);
+
+        if (inferer == nullptr)
+        {
+            LOG_ERROR("DLInferer::makeInferer() failed.\n");
+            status = -1;
+            break;
+        }
+
+        replicas.push_back(inferer);
+    }
+
+    if (status < 0)
+    {
+        for (auto &r : replicas)
+        {
+            delete r;
+        }
+    }
+    else if (replicas.size() == 1)
+    {
+        m_infererObj = replicas[0];
+    }
+    else
+    {
+        m_infererObj = new ReplicatedInferer(replicas);
+    }
+
+    return status;
+}
+
+int32_t ModelInfo::setCores(const vector<int32_t> &coreIds)
+{
+    int32_t status = 0;
+
+    /* The order of the cores does not matter. */
+    if (m_replay ||
+        set<int32_t>(coreIds.begin(), coreIds.end()) ==
+        set<int32_t>(m_coreIds.begin(), m_coreIds.end()))
+    {
+        return status;
+    }
+
+    delete m_infererObj;
+    m_infererObj = nullptr;
+    m_coreIds    = coreIds;
+
+    /* The tidlinferer element of the pipeline picks the core up. */
+    if (!m_inPipelineOnly)
+    {
+        status = createInferer();
+    }
+
+    if (status < 0)
+    {
+        LOG_ERROR("createInferer() failed.\n");
+    }
+
+    return status;
+}
+
+float ModelInfo::measureInferTime(int32_t numRuns)
+{
+    VecDlTensorPtr  inputs;
+    VecDlTensorPtr  outputs;
+    int32_t         status = 0;
+    float           inferTime = -1.0f;
+
+    for (auto const &info : *m_infererObj->getInputInfo())
+    {
+        DlTensor *obj = new DlTensor(info);
+        obj->allocateDataBuffer(*m_infererObj);
+        inputs.push_back(obj);
+    }
+
+    for (auto const &info : *m_infererObj->getOutputInfo())
+    {
+        DlTensor *obj = new DlTensor(info);
+        obj->allocateDataBuffer(*m_infererObj);
+        outputs.push_back(obj);
+    }
+
+    /* The first run includes one-time setup costs, do not time it. */
+    status = m_infererObj->run(inputs, outputs);
+
+    if (status == 0)
+    {
+        auto start = chrono::steady_clock::now();
+
+        for (int32_t i = 0; i < numRuns && status == 0; i++)
+        {
+            status = m_infererObj->run(inputs, outputs);
+        }
+
+        auto end = chrono::steady_clock::now();
+
+        if (status == 0)
+        {
+            chrono::duration<float, milli> elapsed = end - start;
+            inferTime = elapsed.count() / numRuns;
+        }
+    }
+
+    if (status < 0)
+    {
+        LOG_ERROR("Inference failed.\n");
+    }
+
+    DeleteVec(inputs);
+    DeleteVec(outputs);
+
+    return inferTime;
+}
+
 int32_t ModelInfo::createPreprocCntxt(const InputInfo          &inputInfo,
                                       const DebugDumpConfig    &debugConfig,
                                       vector<GstElement *>     &preProcElements,
                                       vector<GstElement *>     &preProcScalerElements,
-                                      PreprocessImage         *&preProcObj)
+                                      PreprocessImage         *&preProcObj,
+                                      bool                      makeGstElements)
 {
 
     m_preProcCfg.inDataWidth = inputInfo.m_width;
@@ -1793,10 +2575,13 @@ int32_t ModelInfo::createPreprocCntxt(const InputInfo          &inputInfo,
     PreprocessImageConfig   preProcCfg(m_preProcCfg);
     int32_t                 status = 0;
 
-    getPreProcElements(&preProcCfg,preProcElements);
-    getPreProcScalerElements(&preProcCfg,
-                             preProcScalerElements,
-                             inputInfo.m_scalerIsMulltiSrc);
+    if (makeGstElements)
+    {
+        getPreProcElements(&preProcCfg,preProcElements);
+        getPreProcScalerElements(&preProcCfg,
+                                 preProcScalerElements,
+                                 inputInfo.m_scalerIsMulltiSrc);
+    }
 
     /* Instantiate pre-processing object. */
     preProcObj = PreprocessImage::makePreprocessImageObj(preProcCfg,debugConfig);
@@ -1839,9 +2624,45 @@ void ModelInfo::dumpInfo(const char *prefix) const
     LOG_INFO("%sModelInfo::vizThreshold  = %f\n", prefix, m_vizThreshold);
     LOG_INFO("%sModelInfo::alpha         = %f\n", prefix, m_alpha);
     LOG_INFO("%sModelInfo::topN          = %d\n", prefix, m_topN);
+
+    if (m_replay)
+    {
+        m_replayCfg.dumpInfo(prefix);
+    }
+
     LOG_INFO_RAW("\n");
 }
 
+string ModelInfo::getPreProcKey(const InputInfo &inputInfo)
+{
+    m_preProcCfg.inDataWidth = inputInfo.m_width;
+    m_preProcCfg.inDataHeight  = inputInfo.m_height;
+    m_preProcCfg.getConfig(m_modelPath);
+
+    return ti::edgeai::common::getPreProcKey(&m_preProcCfg);
+}
+
+bool ModelInfo::isEquivalent(const ModelInfo &other) const
+{
+    std::error_code ec;
+    auto const     &path = filesystem::weakly_canonical(m_modelPath, ec);
+    auto const     &otherPath = filesystem::weakly_canonical(other.m_modelPath, ec);
+
+    return (path == otherPath) &&
+           (m_labelsPath == other.m_labelsPath) &&
+           (m_alpha == other.m_alpha) &&
+           (m_vizThreshold == other.m_vizThreshold) &&
+           (m_topN == other.m_topN) &&
+           (m_replay == other.m_replay) &&
+           (m_replicas == other.m_replicas) &&
+           (m_inferTime == other.m_inferTime) &&
+           (m_replayCfg.path == other.m_replayCfg.path) &&
+           (m_replayCfg.latency == other.m_replayCfg.latency) &&
+           (m_replayCfg.jitter == other.m_replayCfg.jitter) &&
+           (m_replayCfg.distribution == other.m_replayCfg.distribution) &&
+           (m_replayCfg.seed == other.m_replayCfg.seed);
+}
+
 ModelInfo::~ModelInfo()
 {
     LOG_DEBUG("DESTRUCTOR\n");
@@ -1850,19 +2671,19 @@ ModelInfo::~ModelInfo()
 
 SubFlowInfo::SubFlowInfo(InferencePipe     *inferPipe,
                          PreprocessImage   *preProcObj,
-                         PostprocessImage  *postProcObj):
+                         PostprocessImage  *postProcObj,
+                         PostprocElement   *postProcElement):
     m_preProcObj(preProcObj),
     m_inferPipe(inferPipe),
-    m_postProcObj(postProcObj)
+    m_postProcObj(postProcObj),
+    m_postProcElement(postProcElement)
 {
     LOG_DEBUG("CONSTRUCTOR\n");
 }
 
 int32_t SubFlowInfo::start(GstPipe   *gstPipe)
 {
-    m_inferPipe->start(gstPipe);
-
-    return 0;
+    return m_inferPipe->start(gstPipe);
 }
 
 
@@ -1872,6 +2693,7 @@ SubFlowInfo::~SubFlowInfo()
 
     delete m_preProcObj;
     delete m_inferPipe;
+    delete m_postProcElement;
     delete m_postProcObj;
 }
 
@@ -1889,9 +2711,18 @@ FlowInfo::FlowInfo(FlowConfig       &flowConfig)
     {
         m_modelIds.push_back(s.model);
 
+        if (s.cascade)
+        {
+            m_modelIds.push_back(s.cascade_config.model);
+        }
+
+        /* Only the results of a metadata-only sub-flow are used. */
         for (auto const &o : s.outputs)
         {
-            m_outputIds.push_back(o);
+            if (!s.metadata_only)
+            {
+                m_outputIds.push_back(o);
+            }
         }
     }
 
@@ -1900,7 +2731,7 @@ FlowInfo::FlowInfo(FlowConfig       &flowConfig)
 
         m_debugEnableMask = flowConfig.debugNode["enable_mask"].as<uint32_t>();
 
-        if (m_debugEnableMask > EDGEAI_ENABLE_DATA_DUMP_MASK)
+        if (m_debugEnableMask > EDGEAI_ENABLE_DEBUG_MASK)
         {
             LOG_ERROR("Invalid debug enable mask specified. "
                       "Disabling debug logging.\n");
@@ -1931,18 +2762,92 @@ FlowInfo::FlowInfo(FlowConfig       &flowConfig)
     LOG_DEBUG("CONSTRUCTOR\n");
 }
 
-int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
-                             map<string, InputInfo*>   &inputMap,
-                             map<string, OutputInfo*>  &outputMap)
+int32_t FlowInfo::initialize(map<string, ModelInfo*>       &modelMap,
+                             map<string, InputInfo*>       &inputMap,
+                             map<string, OutputInfo*>      &outputMap,
+                             map<string, InferScheduler*>  &schedulerMap)
 {
     auto                          &inputInfo = inputMap[m_inputId];
     vector<vector<GstElement *>>  preProcElementVec;
     vector<vector<GstElement *>>  preProcScalerElementVec;
+    vector<int32_t>               preProcShareVec;
+    vector<int32_t>               preProcDropVec;
+    vector<bool>                  inPipelineVec;
+    vector<GstElement *>          postProcElemVec;
+    vector<bool>                  metadataOnlyVec;
+    map<string, int32_t>          preProcKeyMap;
     vector<string>                flowSrcElemNames;
     int32_t                       cnt = 0;
     string                        flowStr = "flow" + to_string(m_instId);
     int32_t                       status = 0;
 
+    m_framerate = inputInfo->m_framerate;
+    m_dropLateFrames = inputInfo->m_drop && inputInfo->m_throttle;
+
+    /* Sub-flows needing the same pre-processed frames from this input
+     * tap the branch of the first one instead of building their own.
+     */
+    for (auto &s : m_subFlowConfigs)
+    {
+        string  preProcKey = modelMap[s.model]->getPreProcKey(*inputInfo);
+        int32_t shareIdx = -1;
+        int32_t idx = preProcShareVec.size();
+
+        /* The pre-processing branch of an in-pipeline sub-flow feeds its
+         * inferer directly and cannot be shared.
+         */
+        if (s.in_pipeline)
+        {
+            preProcKey += ":" + to_string(idx);
+        }
+
+        if (preProcKeyMap.find(preProcKey) != preProcKeyMap.end())
+        {
+            shareIdx = preProcKeyMap[preProcKey];
+            LOG_INFO("Sub-flow %d of %s shares the pre-processing of "
+                     "sub-flow %d.\n", idx, flowStr.c_str(), shareIdx);
+        }
+        else
+        {
+            preProcKeyMap[preProcKey] = idx;
+        }
+
+        preProcShareVec.push_back(shareIdx);
+    }
+
+    /* Frames that are not inferred are dropped at the start of the
+     * pre-processing branch, unless its users infer at different rates.
+     */
+    for (uint32_t i = 0; i < m_subFlowConfigs.size(); i++)
+    {
+        int32_t owner = preProcShareVec[i];
+
+        if (m_subFlowConfigs[i].in_pipeline)
+        {
+            preProcDropVec.push_back(1);
+        }
+        else if (owner < 0)
+        {
+            preProcDropVec.push_back(m_subFlowConfigs[i].every_nth_frame);
+        }
+        else
+        {
+            if (preProcDropVec[owner] != m_subFlowConfigs[i].every_nth_frame)
+            {
+                preProcDropVec[owner] = 1;
+            }
+            preProcDropVec.push_back(0);
+        }
+    }
+
+    for (uint32_t i = 0; i < m_subFlowConfigs.size(); i++)
+    {
+        if (preProcShareVec[i] >= 0)
+        {
+            preProcDropVec[i] = preProcDropVec[preProcShareVec[i]];
+        }
+    }
+
     /* Set up the flows. */
     for (auto &s : m_subFlowConfigs)
     {
@@ -1987,12 +2892,15 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
             debugConfig.enable = false;
         }
 
+        int32_t shareIdx = preProcShareVec[cnt];
+
         /* Create pre-process context. */
         status = model->createPreprocCntxt(*inputInfo,
                                            debugConfig,
                                            preProcElements,
                                            preProcScalerElements,
-                                           preProcObj);
+                                           preProcObj,
+                                           shareIdx < 0);
 
         if (status < 0)
         {
@@ -2013,7 +2921,16 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
             }
         }
 
-        for (unsigned i = 0; i < s.outputs.size(); i++)
+        /* A metadata-only sub-flow has no frames to display, the sensor
+         * dimensions only scale the results.
+         */
+        if (s.metadata_only)
+        {
+            sensorWidth = inputInfo->m_width;
+            sensorHeight = inputInfo->m_height;
+        }
+
+        for (unsigned i = 0; !s.metadata_only && i < s.outputs.size(); i++)
         {
             auto &output     =  s.outputs[i];
             auto &outputInfo =  outputMap[output];
@@ -2079,57 +2996,203 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
             {
                 sensorWidth = mosaicInfo->m_width;
             }
-            if (mosaicInfo->m_height > sensorHeight)
+            if (mosaicInfo->m_height > sensorHeight)
+            {
+                sensorHeight = mosaicInfo->m_height;
+            }
+        }
+
+        if (status == -1)
+        {
+            if (nullptr != preProcObj)
+            {
+                delete preProcObj;
+            }
+            break;
+        }
+        
+        m_sensorDimVec.push_back({sensorWidth,sensorHeight});
+
+        debugConfig.file = "post";
+
+        if (m_debugEnableMask & EDGEAI_ENABLE_POSTPROC_DUMP)
+        {
+            debugConfig.enable = true;
+        }
+        else
+        {
+            debugConfig.enable = false;
+        }
+
+        /* Create post-process context. */
+        status = model->createPostprocCntxt(debugConfig,
+                                            sensorWidth,
+                                            sensorHeight,
+                                            postProcObj);
+
+        if (status < 0)
+        {
+            if (nullptr != preProcObj)
+            {
+                delete preProcObj;
+            }
+            LOG_ERROR("createPostprocCntxt() failed.\n");
+            break;
+        }
+
+        if (s.tracking)
+        {
+            s.tracker_config.dumpInfo();
+            status = postProcObj->enableTracking(s.tracker_config);
+
+            if (status < 0)
+            {
+                delete preProcObj;
+                delete postProcObj;
+                LOG_ERROR("enableTracking() failed.\n");
+                break;
+            }
+        }
+
+        /* Construct source command strings. */
+        auto const &srcStr1 = flowStr + "_sensor" + to_string(cnt);
+        auto const &srcStr2 = flowStr +
+                              (s.in_pipeline ? "_tidl_post_proc" : "_pre_proc") +
+                              to_string(cnt);
+
+        if (s.in_pipeline)
+        {
+            status = makeInPipelineElements(model, srcStr2, preProcElements);
+
+            if (status < 0)
+            {
+                delete preProcObj;
+                delete postProcObj;
+                LOG_ERROR("makeInPipelineElements() failed.\n");
+                break;
+            }
+
+            if (s.tracking || s.cascade || s.motion_threshold > 0 ||
+                s.every_nth_frame > 1 || s.target_fps > 0 ||
+                s.postproc_element || !s.result_socket.empty())
+            {
+                LOG_WARN("Sub-flow %d of %s runs in the pipeline, the "
+                         "tracking, cascade, frame skipping, postproc and "
+                         "publish_results options are ignored.\n",
+                         cnt, flowStr.c_str());
+            }
+        }
+        else if (s.metadata_only)
+        {
+            /* There are no camera frames in the application. */
+            if (s.cascade || s.motion_threshold > 0 || s.postproc_element)
+            {
+                LOG_WARN("Sub-flow %d of %s only exports the results, the "
+                         "cascade, motion gating and postproc options are "
+                         "ignored.\n", cnt, flowStr.c_str());
+            }
+
+            if (s.result_socket.empty())
+            {
+                LOG_WARN("Sub-flow %d of %s only exports the results but "
+                         "does not publish them.\n", cnt, flowStr.c_str());
+            }
+
+            s.cascade = false;
+            s.motion_threshold = 0.0f;
+            s.postproc_element = false;
+        }
+        else if (s.postproc_element && s.motion_threshold > 0)
+        {
+            /* Motion gating needs the camera frames in the application. */
+            LOG_WARN("Sub-flow %d of %s is post-processed by an element, "
+                     "motion gating is ignored.\n", cnt, flowStr.c_str());
+            s.motion_threshold = 0.0f;
+        }
+
+        /* Everything that can fail is set up before the contexts of the
+         * sub-flow are stored.
+         */
+        if (s.cascade && !s.in_pipeline)
+        {
+            ModelInfo          *cascadeModel = modelMap[s.cascade_config.model];
+            CascadeClassifier  *cascade = nullptr;
+
+            if (cascadeModel->m_postProcCfg.taskType != "classification")
+            {
+                LOG_ERROR("Cascade model [%s] is not a classification model.\n",
+                          s.cascade_config.model.c_str());
+                status = -1;
+            }
+            else
             {
-                sensorHeight = mosaicInfo->m_height;
+                s.cascade_config.dumpInfo();
+
+                try
+                {
+                    cascade = new CascadeClassifier(s.cascade_config,
+                                                    cascadeModel->m_infererObj,
+                                                    cascadeModel->m_preProcCfg,
+                                                    cascadeModel->m_postProcCfg,
+                                                    getInferScheduler(s.cascade_config.model,
+                                                                      cascadeModel,
+                                                                      schedulerMap),
+                                                    s.priority);
+                    status = postProcObj->enableCascade(cascade);
+                }
+                catch (const runtime_error &e)
+                {
+                    LOG_ERROR("%s\n", e.what());
+                    status = -1;
+                }
             }
-        }
 
-        if (status == -1)
-        {
-            if (nullptr != preProcObj)
+            if (status < 0)
             {
+                delete cascade;
                 delete preProcObj;
+                delete postProcObj;
+                releaseElements(preProcElements);
+                releaseElements(preProcScalerElements);
+                m_sensorDimVec.pop_back();
+                LOG_ERROR("Cascade setup failed.\n");
+                break;
             }
-            break;
-        }
-        
-        m_sensorDimVec.push_back({sensorWidth,sensorHeight});
-
-        debugConfig.file = "post";
-
-        if (m_debugEnableMask & EDGEAI_ENABLE_POSTPROC_DUMP)
-        {
-            debugConfig.enable = true;
-        }
-        else
-        {
-            debugConfig.enable = false;
         }
 
-        /* Create post-process context. */
-        status = model->createPostprocCntxt(debugConfig,
-                                            sensorWidth,
-                                            sensorHeight,
-                                            postProcObj);
+        /* The results are drawn in the source pipeline, before the
+         * sensor appsink.
+         */
+        PostprocElement *postProcElement = nullptr;
 
-        if (status < 0)
+        if (s.postproc_element && !s.in_pipeline)
         {
-            if (nullptr != preProcObj)
+            try
             {
+                postProcElement = new PostprocElement(postProcObj,
+                                                      sensorWidth,
+                                                      sensorHeight,
+                                                      flowStr + "_edgeai_post_proc" +
+                                                      to_string(cnt));
+            }
+            catch (const runtime_error &e)
+            {
+                LOG_ERROR("%s\n", e.what());
                 delete preProcObj;
+                delete postProcObj;
+                releaseElements(preProcElements);
+                releaseElements(preProcScalerElements);
+                m_sensorDimVec.pop_back();
+                status = -1;
+                break;
             }
-            LOG_ERROR("createPostprocCntxt() failed.\n");
-            break;
         }
 
         /* Store the contexts. */
         preProcElementVec.push_back(preProcElements);
         preProcScalerElementVec.push_back(preProcScalerElements);
-
-        /* Construct source command strings. */
-        auto const &srcStr1 = flowStr + "_sensor" + to_string(cnt);
-        auto const &srcStr2 = flowStr + "_pre_proc" + to_string(cnt);
+        inPipelineVec.push_back(s.in_pipeline);
+        metadataOnlyVec.push_back(s.metadata_only);
         srcElemNames.push_back(srcStr1);
         srcElemNames.push_back(srcStr2);
         sinkElemName = flowStr + "_post_proc" + to_string(cnt);
@@ -2152,6 +3215,9 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
 
         ipCfg.zeroCopyEnable = false;
 
+        /* A shared branch hands out the buffers of its owner. */
+        auto &branchElements = preProcElementVec[shareIdx < 0 ? cnt : shareIdx];
+
         /* Check if tiovxmemalloc exists. */
         GstElementFactory *tiovxmemalloc_factory;
         tiovxmemalloc_factory = gst_element_factory_find("tiovxmemalloc");
@@ -2164,12 +3230,12 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
         /* if tiovxmemalloc doesnt exist, check if the lase
         * element before appsink (except capsfilter) is a tiovx.
         */
-        else if (preProcElements.size() > 0)
+        else if (branchElements.size() > 0)
         {
             string       name;
             gchar       *factory_name;
-            int32_t      index = preProcElements.size() - 1;
-            factory_name = GST_OBJECT_NAME(gst_element_get_factory(preProcElements[index]));
+            int32_t      index = branchElements.size() - 1;
+            factory_name = GST_OBJECT_NAME(gst_element_get_factory(branchElements[index]));
             while (g_strcmp0("capsfilter", factory_name) == 0)
             {
                 index--;
@@ -2177,7 +3243,7 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
                 {
                     break;
                 }
-                factory_name = GST_OBJECT_NAME(gst_element_get_factory(preProcElements[index]));
+                factory_name = GST_OBJECT_NAME(gst_element_get_factory(branchElements[index]));
             }
             name.assign(factory_name);
             if (name.rfind("tiovx", 0) == 0)
@@ -2192,6 +3258,43 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
         ipCfg.loop          = inputInfo->m_loop;
         ipCfg.frameRate     = inputInfo->m_framerate;
         ipCfg.debugConfig   = debugConfig;
+        ipCfg.priority      = s.priority;
+        ipCfg.targetFps     = s.target_fps;
+        ipCfg.everyNthFrame = s.every_nth_frame;
+        ipCfg.preProcInterval = preProcDropVec[cnt];
+        ipCfg.motionThreshold = s.motion_threshold;
+        ipCfg.motionRefresh = s.motion_refresh;
+        ipCfg.inPipeline    = s.in_pipeline;
+        ipCfg.resultSocket  = s.result_socket;
+        ipCfg.metadataOnly  = metadataOnlyVec.back();
+        ipCfg.dropLateFrames = m_dropLateFrames;
+
+        /* The result meta is only attached for the shm sinks reading it. */
+        for (unsigned i = 0; !ipCfg.metadataOnly && i < s.outputs.size(); i++)
+        {
+            const auto &sinks = outputMap[s.outputs[i]]->m_sinks;
+
+            if (find(sinks.begin(), sinks.end(), "shm") != sinks.end())
+            {
+                ipCfg.exportResults = true;
+            }
+        }
+
+        if (!s.in_pipeline)
+        {
+            ipCfg.scheduler = getInferScheduler(s.model, model, schedulerMap);
+            ipCfg.scheduler->addUser(s.priority);
+        }
+
+        if (m_debugEnableMask & EDGEAI_ENABLE_TENSOR_CAPTURE)
+        {
+            ipCfg.captureFile = debugConfig.dir + "/" + flowStr +
+                                "_capture" + to_string(cnt) + ".bin";
+        }
+
+        postProcElemVec.push_back(postProcElement ?
+                                  postProcElement->getElement() : nullptr);
+        ipCfg.postProcElement = postProcElement;
 
         inferPipe = new InferencePipe(ipCfg,
                                       model->m_infererObj,
@@ -2202,10 +3305,11 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
 
         subFlow = new SubFlowInfo(inferPipe,
                                   preProcObj,
-                                  postProcObj);
+                                  postProcObj,
+                                  postProcElement);
 
         vector <OutputInfo *> outputs;
-        for (unsigned i = 0; i < s.outputs.size(); i++)
+        for (unsigned i = 0; !ipCfg.metadataOnly && i < s.outputs.size(); i++)
         {
             auto    &mosaicInfo =  m_mosaicVec[i];
             auto    out = mosaicInfo->m_outputInfo;
@@ -2239,6 +3343,11 @@ int32_t FlowInfo::initialize(map<string, ModelInfo*>   &modelMap,
         /* Create the GST source command string. */
         status = inputInfo->addGstPipeline(preProcElementVec,
                                            preProcScalerElementVec,
+                                           preProcShareVec,
+                                           preProcDropVec,
+                                           inPipelineVec,
+                                           postProcElemVec,
+                                           metadataOnlyVec,
                                            flowSrcElemNames,
                                            m_sensorDimVec);
         if (status < 0)
@@ -2268,15 +3377,51 @@ int32_t FlowInfo::getSinkPipeline(GstElement*       &sinkPipeline,
         int32_t sensorHeight = m_sensorDimVec[cnt][1];
         int32_t numSink = outputs.size();
         vector<GstElement *> post_proc_elements;
+
+        /* Nothing is displayed for a metadata-only sub-flow. */
+        if (numSink == 0)
+        {
+            cnt++;
+            continue;
+        }
+
         sinkElemNames.push_back(name);
 
+        /* The caps are fixed on the appsrc so that they are negotiated
+         * once, the queue is bounded by GstPipe. Late frames are dropped
+         * by the inference pipe if the input drops frames, the appsrc
+         * blocks and paces the input otherwise.
+         */
+        string appsrcCaps = "video/x-raw, format=RGB"
+                            ", width=" +
+                            to_string(sensorWidth) +
+                            ", height=" +
+                            to_string(sensorHeight) +
+                            ", framerate=" +
+                            m_framerate;
+        string block = m_dropLateFrames ? "false" : "true";
+
         m_gstElementProperty = {{"format","3"},
                                 //{"is-live","true"},
-                                {"block","true"},
+                                {"block",block.c_str()},
                                 {"do-timestamp","true"},
                                 {"name",name.c_str()}};
 
         makeElement(post_proc_elements,"appsrc",m_gstElementProperty,NULL);
+        GstCaps *fixedCaps = gst_caps_from_string(appsrcCaps.c_str());
+
+        /* The caps are taken from the first frame otherwise. */
+        if (fixedCaps != nullptr)
+        {
+            g_object_set(post_proc_elements.back(), "caps", fixedCaps, NULL);
+            gst_caps_unref(fixedCaps);
+        }
+        else
+        {
+            LOG_WARN("Invalid caps [%s], the caps of %s are not fixed.\n",
+                     appsrcCaps.c_str(), name.c_str());
+        }
+
         string caps = "video/x-raw"
                       ", width=" +
                       to_string(sensorWidth) +
@@ -2343,7 +3488,7 @@ int32_t FlowInfo::getSinkPipeline(GstElement*       &sinkPipeline,
                 if (!output->m_dispElementAdded)
                 {
                     output->m_dispElementAdded = true;
-                    addAndLink(sinkPipeline,output->m_dispElements);
+                    output->addDispElements(sinkPipeline);
                 }
                 link(output->m_mosaicElements.back(),output->m_dispElements.front());
 
@@ -2425,7 +3570,7 @@ int32_t FlowInfo::getSinkPipeline(GstElement*       &sinkPipeline,
                     lastElement = scaler_element.back();
                 }
 
-                addAndLink(sinkPipeline,output->m_dispElements);
+                output->addDispElements(sinkPipeline);
                 link(lastElement,output->m_dispElements.front());
             }
         }
@@ -2581,10 +3726,253 @@ int32_t DemoConfig::parse(const YAML::Node &yaml)
     }
     if (status == 0)
     {
+        /* Flows using the same input and model are grouped into one
+         * sub-flow that runs the inference once and feeds all of its
+         * outputs. Fold the model entries describing the same model into
+         * the first one, so that this also holds across model names.
+         */
+        for (auto const &[name, model] : m_modelMap)
+        {
+            m_modelAlias[name] = name;
+
+            for (auto const &[other, otherModel] : m_modelMap)
+            {
+                if (other == name)
+                {
+                    break;
+                }
+
+                if (m_modelAlias[other] == other &&
+                    model->isEquivalent(*otherModel))
+                {
+                    LOG_INFO("Model [%s] shares the inference of [%s].\n",
+                             name.c_str(), other.c_str());
+                    m_modelAlias[name] = other;
+                    break;
+                }
+            }
+        }
+
         /* Parse flow information. */
         status = parseFlowInfo(yaml);
     }
 
+    if (yaml["element_latency"])
+    {
+        m_elementLatency = yaml["element_latency"].as<bool>();
+    }
+
+    return status;
+}
+
+int32_t DemoConfig::initializeModels(const set<string> &modelIds)
+{
+    vector<int32_t> coreIds;
+    set<string>     appModelIds;
+    set<string>     pending;
+    int32_t         status = 0;
+
+    /* The models only run by the tidlinferer elements of the pipelines
+     * need no inference object in the application.
+     */
+    for (auto const &[name, flow] : m_flowMap)
+    {
+        for (auto const &s : flow->m_subFlowConfigs)
+        {
+            if (!s.in_pipeline)
+            {
+                appModelIds.insert(s.model);
+
+                if (s.cascade)
+                {
+                    appModelIds.insert(s.cascade_config.model);
+                }
+            }
+        }
+    }
+
+    if (gstElementMap["inferer"]["target"].as<string>() == "dsp" &&
+        gstElementMap["inferer"]["core-id"])
+    {
+        coreIds = gstElementMap["inferer"]["core-id"].as<vector<int32_t>>();
+    }
+
+    /* Only the models to be timed are initialized before the placement,
+     * the others get their inference object on the placed cores.
+     */
+    for (auto const &mId : modelIds)
+    {
+        ModelInfo *model = m_modelMap[mId];
+
+        model->m_inPipelineOnly = appModelIds.count(mId) == 0;
+
+        if (coreIds.size() > 1 &&
+            !model->m_replay &&
+            (model->m_inPipelineOnly || model->m_inferTime > 0.0f))
+        {
+            pending.insert(mId);
+            continue;
+        }
+
+        status = model->initialize();
+
+        if (status < 0)
+        {
+            LOG_ERROR("[%s] Model initialization failed.\n", mId.c_str());
+            break;
+        }
+    }
+
+    if (status == 0 && coreIds.size() > 1)
+    {
+        map<string, int32_t>            numUsers;
+        map<string, vector<int32_t>>    placement;
+        vector<pair<float, string>>     replicas;
+        vector<string>                  unmeasured;
+        vector<float>                   load(coreIds.size(), 0.0f);
+        float                           totalTime = 0.0f;
+        float                           nominal = 1.0f;
+        int32_t                         numTimed = 0;
+
+        /* Every sub-flow runs its model once per frame. */
+        for (auto const &[name, flow] : m_flowMap)
+        {
+            for (auto const &m : flow->m_modelIds)
+            {
+                numUsers[m]++;
+            }
+        }
+
+        for (auto const &mId : modelIds)
+        {
+            ModelInfo *model = m_modelMap[mId];
+
+            if (model->m_replay)
+            {
+                continue;
+            }
+
+            /* The time can only be measured with an inference object. */
+            if (model->m_inPipelineOnly && model->m_inferTime <= 0.0f)
+            {
+                unmeasured.push_back(mId);
+                continue;
+            }
+
+            if (model->m_inferTime <= 0.0f)
+            {
+                model->m_inferTime = model->measureInferTime(MODEL_PLACEMENT_RUNS);
+
+                if (model->m_inferTime < 0.0f)
+                {
+                    LOG_ERROR("[%s] Measuring the inference time failed.\n",
+                              mId.c_str());
+                    status = -1;
+                    break;
+                }
+            }
+
+            /* The requests are spread evenly over the replicas. A
+             * tidlinferer element only runs on one core.
+             */
+            int32_t n = model->m_inPipelineOnly ? 1 :
+                        min(model->m_replicas, (int32_t)coreIds.size());
+            float   cost = model->m_inferTime * numUsers[mId] / n;
+
+            for (int32_t i = 0; i < n; i++)
+            {
+                replicas.push_back({cost, mId});
+            }
+
+            totalTime += model->m_inferTime;
+            numTimed++;
+        }
+
+        /* The models of unknown cost are given the mean time of the timed
+         * ones, and placed with them.
+         */
+        if (numTimed > 0)
+        {
+            nominal = totalTime / numTimed;
+        }
+
+        for (auto const &mId : unmeasured)
+        {
+            replicas.push_back({nominal * numUsers[mId], mId});
+        }
+
+        /* Place the heaviest replicas first, each on the least loaded
+         * core not already holding a replica of the same model.
+         */
+        sort(replicas.rbegin(), replicas.rend());
+
+        for (auto const &[cost, mId] : replicas)
+        {
+            auto    &cores = placement[mId];
+            int32_t  best = -1;
+
+            for (uint32_t c = 0; c < coreIds.size(); c++)
+            {
+                if (find(cores.begin(), cores.end(), coreIds[c]) != cores.end())
+                {
+                    continue;
+                }
+
+                if (best < 0 || load[c] < load[best])
+                {
+                    best = c;
+                }
+            }
+
+            load[best] += cost;
+            cores.push_back(coreIds[best]);
+        }
+
+        for (auto const &[mId, cores] : placement)
+        {
+            string coreStr;
+
+            for (auto const &c : cores)
+            {
+                coreStr += " " + to_string(c);
+            }
+
+            LOG_INFO("Model [%s] (%.2f ms) placed on core(s)%s.\n",
+                     mId.c_str(), m_modelMap[mId]->m_inferTime, coreStr.c_str());
+
+            if (pending.count(mId) > 0)
+            {
+                m_modelMap[mId]->m_coreIds = cores;
+                continue;
+            }
+
+            status = m_modelMap[mId]->setCores(cores);
+
+            if (status < 0)
+            {
+                break;
+            }
+        }
+
+        for (uint32_t c = 0; c < coreIds.size(); c++)
+        {
+            LOG_INFO("Core %d load: %.2f ms per frame.\n", coreIds[c], load[c]);
+        }
+    }
+
+    for (auto const &mId : pending)
+    {
+        if (status == 0)
+        {
+            status = m_modelMap[mId]->initialize();
+
+            if (status < 0)
+            {
+                LOG_ERROR("[%s] Model initialization failed.\n", mId.c_str());
+            }
+        }
+    }
+
     return status;
 }
 
@@ -2668,8 +4056,14 @@ int32_t DemoConfig::parseFlowInfo(const YAML::Node &config)
                flow_name = s;
             }
 
-            string model_name = flows[s][1].as<string>();
+            string model_name = m_modelAlias[flows[s][1].as<string>()];
             SubFlowConfig subFlowConfig;
+            vector<int32_t> everyNthVec;
+            vector<float>   motionThresholdVec;
+            vector<int32_t> motionRefreshVec;
+            bool            inPipeline = true;
+            bool            postProcElement = true;
+            bool            metadataOnly = true;
             subFlowConfig.model = model_name;
 
             for (auto &j : flows)
@@ -2680,7 +4074,7 @@ int32_t DemoConfig::parseFlowInfo(const YAML::Node &config)
                     continue;
                 }
                 string          input = flows[t][0].as<string>();
-                string          model = flows[t][1].as<string>();
+                string          model = m_modelAlias[flows[t][1].as<string>()];
                 if (input != input_name || model_name != model)
                 {
                     continue;
@@ -2709,6 +4103,152 @@ int32_t DemoConfig::parseFlowInfo(const YAML::Node &config)
                 {
                     subFlowConfig.debug_infos.push_back("");
                 }
+
+                /* The merged sub-flow gets the most demanding options. */
+                if (config["flow_options"] && config["flow_options"][t])
+                {
+                    const YAML::Node &options = config["flow_options"][t];
+
+                    if (options["priority"])
+                    {
+                        subFlowConfig.priority =
+                            max(subFlowConfig.priority,
+                                options["priority"].as<int32_t>());
+                    }
+
+                    if (options["target_fps"])
+                    {
+                        subFlowConfig.target_fps =
+                            max(subFlowConfig.target_fps,
+                                options["target_fps"].as<float>());
+                    }
+
+                    int32_t everyNth = 1;
+                    if (options["every_nth_frame"])
+                    {
+                        everyNth = max(options["every_nth_frame"].as<int32_t>(), 1);
+                    }
+
+                    if (options["infer_rate"])
+                    {
+                        const string &fps = m_inputMap[input_name]->m_framerate;
+                        float rate = options["infer_rate"].as<float>();
+
+                        if (rate > 0)
+                        {
+                            everyNth = max(everyNth,
+                                           (int32_t)lround(fractionToFloat(fps) / rate));
+                        }
+                    }
+
+                    everyNthVec.push_back(everyNth);
+
+                    float motionThreshold = 0.0f;
+                    if (options["motion_threshold"])
+                    {
+                        motionThreshold = max(options["motion_threshold"].as<float>(),
+                                              0.0f);
+                    }
+
+                    int32_t motionRefresh = subFlowConfig.motion_refresh;
+                    if (options["motion_refresh"])
+                    {
+                        motionRefresh = max(options["motion_refresh"].as<int32_t>(), 1);
+                    }
+
+                    motionThresholdVec.push_back(motionThreshold);
+                    motionRefreshVec.push_back(motionRefresh);
+
+                    /* Tracking is enabled if any of the merged flows
+                     * asks for it, with the options of the first one.
+                     */
+                    if (options["tracking"] && !subFlowConfig.tracking)
+                    {
+                        subFlowConfig.tracking =
+                            parseTrackerConfig(options["tracking"],
+                                               subFlowConfig.tracker_config);
+                    }
+
+                    /* Runs in the pipeline only if all the merged flows
+                     * ask for it.
+                     */
+                    if (!options["execution"] ||
+                        options["execution"].as<string>() != "optiflow")
+                    {
+                        inPipeline = false;
+                    }
+
+                    if (!options["postproc"] ||
+                        options["postproc"].as<string>() != "element")
+                    {
+                        postProcElement = false;
+                    }
+
+                    if (!options["metadata_only"] ||
+                        !options["metadata_only"].as<bool>())
+                    {
+                        metadataOnly = false;
+                    }
+
+                    /* The results are published once, to the socket of
+                     * the first of the merged flows asking for it.
+                     */
+                    if (options["publish_results"] &&
+                        subFlowConfig.result_socket.empty())
+                    {
+                        subFlowConfig.result_socket =
+                            options["publish_results"].as<string>();
+                    }
+
+                    if (options["cascade"] && !subFlowConfig.cascade)
+                    {
+                        auto &cascadeConfig = subFlowConfig.cascade_config;
+
+                        parseCascadeConfig(options["cascade"], cascadeConfig);
+
+                        if (m_modelAlias.find(cascadeConfig.model) == m_modelAlias.end())
+                        {
+                            LOG_ERROR("Cascade model [%s] of [%s] not found.\n",
+                                      cascadeConfig.model.c_str(), t.c_str());
+                            status = -1;
+                        }
+                        else
+                        {
+                            cascadeConfig.model = m_modelAlias[cascadeConfig.model];
+                            subFlowConfig.cascade = true;
+                        }
+                    }
+                }
+                else
+                {
+                    inPipeline = false;
+                    postProcElement = false;
+                    metadataOnly = false;
+                    everyNthVec.push_back(1);
+                    motionThresholdVec.push_back(0.0f);
+                    motionRefreshVec.push_back(subFlowConfig.motion_refresh);
+                }
+            }
+
+            /* Infer as often as the most demanding of the merged flows. */
+            subFlowConfig.every_nth_frame = *min_element(everyNthVec.begin(),
+                                                         everyNthVec.end());
+
+            /* Motion gating only applies if all the merged flows allow it. */
+            subFlowConfig.motion_threshold =
+                *min_element(motionThresholdVec.begin(), motionThresholdVec.end());
+            subFlowConfig.motion_refresh =
+                *min_element(motionRefreshVec.begin(), motionRefreshVec.end());
+            subFlowConfig.in_pipeline = inPipeline;
+            subFlowConfig.postproc_element = postProcElement;
+            subFlowConfig.metadata_only = metadataOnly;
+
+            /* The frames of an in-pipeline sub-flow are always displayed. */
+            if (inPipeline && metadataOnly)
+            {
+                LOG_WARN("Flow [%s] runs in the pipeline, metadata_only is "
+                         "ignored.\n", s.c_str());
+                subFlowConfig.metadata_only = false;
             }
 
             flowConfig.subflow_configs.push_back(subFlowConfig);
@@ -2727,6 +4267,7 @@ DemoConfig::~DemoConfig()
     DeleteMap(m_modelMap);
     DeleteMap(m_outputMap);
     DeleteMap(m_flowMap);
+    DeleteMap(m_schedulerMap);
 }
 
 } // namespace ti::edgeai::common
@@ -0,0 +1,645 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/* Third-party headers. */
+#include <gst/base/gstbasesink.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_result_export.h>
+#include <common/include/edgeai_frame_export.h>
+
+#define FRAME_EXPORT_FACTORY    "edgeaishmsink"
+#define FRAME_EXPORT_NV12       (0x3231564E) /* "NV12" */
+
+using namespace ti::edgeai::common;
+
+/** Instance of the element. */
+typedef struct
+{
+    /** Parent instance. */
+    GstBaseSink         parent;
+
+    /** Exporter, set after creation. */
+    FrameExporter      *ctx;
+
+} GstEdgeaiShmSink;
+
+/** Class of the element. */
+typedef struct
+{
+    /** Parent class. */
+    GstBaseSinkClass    parent_class;
+
+} GstEdgeaiShmSinkClass;
+
+G_DEFINE_TYPE(GstEdgeaiShmSink, gst_edgeai_shm_sink, GST_TYPE_BASE_SINK);
+
+static GstStaticPadTemplate gSinkTemplate =
+    GST_STATIC_PAD_TEMPLATE("sink",
+                            GST_PAD_SINK,
+                            GST_PAD_ALWAYS,
+                            GST_STATIC_CAPS("video/x-raw, format=NV12"));
+
+static gboolean gst_edgeai_shm_sink_start(GstBaseSink *sink)
+{
+    GstEdgeaiShmSink   *self = reinterpret_cast<GstEdgeaiShmSink*>(sink);
+
+    if (self->ctx == nullptr)
+    {
+        return TRUE;
+    }
+
+    return self->ctx->start() < 0 ? FALSE : TRUE;
+}
+
+static gboolean gst_edgeai_shm_sink_stop(GstBaseSink *sink)
+{
+    GstEdgeaiShmSink   *self = reinterpret_cast<GstEdgeaiShmSink*>(sink);
+
+    if (self->ctx != nullptr)
+    {
+        self->ctx->stop();
+    }
+
+    return TRUE;
+}
+
+static GstFlowReturn gst_edgeai_shm_sink_render(GstBaseSink   *sink,
+                                                GstBuffer     *buf)
+{
+    GstEdgeaiShmSink   *self = reinterpret_cast<GstEdgeaiShmSink*>(sink);
+
+    if (self->ctx == nullptr)
+    {
+        return GST_FLOW_OK;
+    }
+
+    return self->ctx->render(buf) < 0 ? GST_FLOW_ERROR : GST_FLOW_OK;
+}
+
+static void gst_edgeai_shm_sink_class_init(GstEdgeaiShmSinkClass *klass)
+{
+    GstElementClass    *elementClass = GST_ELEMENT_CLASS(klass);
+    GstBaseSinkClass   *sinkClass = GST_BASE_SINK_CLASS(klass);
+
+    gst_element_class_set_static_metadata(elementClass,
+                                          "EdgeAI shared memory sink",
+                                          "Sink/Video",
+                                          "Shares the frames with local processes",
+                                          "Texas Instruments");
+
+    gst_element_class_add_static_pad_template(elementClass, &gSinkTemplate);
+
+    sinkClass->start  = gst_edgeai_shm_sink_start;
+    sinkClass->stop   = gst_edgeai_shm_sink_stop;
+    sinkClass->render = gst_edgeai_shm_sink_render;
+}
+
+static void gst_edgeai_shm_sink_init(GstEdgeaiShmSink *self)
+{
+    self->ctx = nullptr;
+    gst_base_sink_set_sync(&self->parent, FALSE);
+}
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+void FrameExportConfig::dumpInfo() const
+{
+    LOG_INFO_RAW("\n");
+    LOG_INFO("FrameExportConfig::path         = %s\n", path.c_str());
+    LOG_INFO("FrameExportConfig::numSlots     = %d\n", numSlots);
+    LOG_INFO("FrameExportConfig::block        = %d\n", block);
+    LOG_INFO("FrameExportConfig::blockTimeout = %d\n", blockTimeout);
+    LOG_INFO("FrameExportConfig::width        = %d\n", width);
+    LOG_INFO("FrameExportConfig::height       = %d\n", height);
+    LOG_INFO_RAW("\n");
+}
+
+FrameExporter::FrameExporter(const FrameExportConfig   &config,
+                             const string              &name):
+    m_config(config)
+{
+    struct sockaddr_un  addr;
+
+    if (m_config.path.size() >= sizeof(addr.sun_path))
+    {
+        throw runtime_error("Frame socket path [" + m_config.path +
+                            "] is too long.");
+    }
+
+    /* A reader holds all the slots but one, so there must be two. */
+    if (m_config.numSlots < 2 || m_config.numSlots > UINT16_MAX)
+    {
+        throw runtime_error("Invalid number of frame slots [" +
+                            to_string(m_config.numSlots) + "].");
+    }
+
+    if (registerElement() < 0)
+    {
+        throw runtime_error("Failed to register the shared memory sink.");
+    }
+
+    m_element = gst_element_factory_make(FRAME_EXPORT_FACTORY, name.c_str());
+
+    if (m_element == nullptr)
+    {
+        throw runtime_error("Failed to create the shared memory sink.");
+    }
+
+    /* Keep a reference so that the element cannot outlive the context. */
+    gst_object_ref_sink(m_element);
+    reinterpret_cast<GstEdgeaiShmSink*>(m_element)->ctx = this;
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+GstElement *FrameExporter::getElement()
+{
+    return m_element;
+}
+
+int32_t FrameExporter::start()
+{
+    struct sockaddr_un  addr{};
+    int32_t             status;
+
+    m_socket = socket(AF_UNIX,
+                      SOCK_SEQPACKET | SOCK_NONBLOCK | SOCK_CLOEXEC,
+                      0);
+
+    if (m_socket < 0)
+    {
+        LOG_ERROR("Failed to create the frame socket: %s\n", strerror(errno));
+        return -1;
+    }
+
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, m_config.path.c_str(), sizeof(addr.sun_path) - 1);
+
+    /* Remove the socket left over by a previous run. */
+    unlink(addr.sun_path);
+
+    status = bind(m_socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr));
+
+    if (status == 0)
+    {
+        status = listen(m_socket, SOMAXCONN);
+    }
+
+    if (status < 0)
+    {
+        LOG_ERROR("Failed to listen on [%s]: %s\n",
+                  m_config.path.c_str(), strerror(errno));
+        close(m_socket);
+        m_socket = -1;
+        return -1;
+    }
+
+    return 0;
+}
+
+void FrameExporter::stop()
+{
+    while (!m_readers.empty())
+    {
+        dropReader(m_readers.size() - 1);
+    }
+
+    if (m_socket >= 0)
+    {
+        close(m_socket);
+        unlink(m_config.path.c_str());
+        m_socket = -1;
+    }
+
+    releaseRing();
+
+    if (m_frameCnt > 0)
+    {
+        LOG_INFO("Exported %ld of %ld frames to [%s], %ld dropped for lack "
+                 "of a slot, %ld skipped for lagging readers.\n",
+                 m_sentCnt, m_frameCnt, m_config.path.c_str(),
+                 m_dropCnt, m_readerDropCnt);
+    }
+
+    if (m_oversizeCnt > 0)
+    {
+        LOG_INFO("%ld frames too large for the ring slots were dropped.\n",
+                 m_oversizeCnt);
+    }
+
+    m_frameCnt = 0;
+    m_sentCnt = 0;
+    m_dropCnt = 0;
+    m_readerDropCnt = 0;
+    m_oversizeCnt = 0;
+}
+
+void FrameExporter::releaseRing()
+{
+    if (m_ring != nullptr)
+    {
+        munmap(m_ring, m_slotSize * m_config.numSlots);
+        m_ring = nullptr;
+    }
+
+    if (m_ringFd >= 0)
+    {
+        close(m_ringFd);
+        m_ringFd = -1;
+    }
+
+    m_slotSize = 0;
+}
+
+int32_t FrameExporter::createRing(uint64_t size)
+{
+    uint64_t pageSize = sysconf(_SC_PAGESIZE);
+    uint64_t slotSize = (size + pageSize - 1) / pageSize * pageSize;
+    uint64_t ringSize = slotSize * m_config.numSlots;
+    void    *ring;
+
+    m_ringFd = memfd_create("edgeai_frames", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+
+    if (m_ringFd < 0)
+    {
+        LOG_ERROR("Failed to create the frame ring: %s\n", strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(m_ringFd, ringSize) < 0)
+    {
+        LOG_ERROR("Failed to size the frame ring: %s\n", strerror(errno));
+        close(m_ringFd);
+        m_ringFd = -1;
+        return -1;
+    }
+
+    /* The readers cannot resize the ring under the mapping. */
+    fcntl(m_ringFd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+
+    ring = mmap(nullptr, ringSize, PROT_READ | PROT_WRITE, MAP_SHARED, m_ringFd, 0);
+
+    if (ring == MAP_FAILED)
+    {
+        LOG_ERROR("Failed to map the frame ring: %s\n", strerror(errno));
+        close(m_ringFd);
+        m_ringFd = -1;
+        return -1;
+    }
+
+    m_ring = reinterpret_cast<uint8_t*>(ring);
+    m_slotSize = slotSize;
+    m_slotRefs.assign(m_config.numSlots, 0);
+    m_nextSlot = 0;
+
+    return 0;
+}
+
+void FrameExporter::acceptReaders()
+{
+    while (true)
+    {
+        FrameExportHello    hello{};
+        struct msghdr       msg{};
+        struct iovec        iov;
+        char                ctrl[CMSG_SPACE(sizeof(int32_t))]{};
+        struct cmsghdr     *cmsg;
+        int32_t             fd;
+
+        fd = accept4(m_socket, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0)
+        {
+            if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+            {
+                LOG_ERROR("Failed to accept a frame reader: %s\n", strerror(errno));
+            }
+
+            break;
+        }
+
+        hello.magic    = FRAME_EXPORT_MAGIC;
+        hello.version  = FRAME_EXPORT_VERSION;
+        hello.numSlots = m_config.numSlots;
+        hello.slotSize = m_slotSize;
+        hello.format   = FRAME_EXPORT_NV12;
+        hello.width    = m_config.width;
+        hello.height   = m_config.height;
+
+        iov.iov_base       = &hello;
+        iov.iov_len        = sizeof(hello);
+        msg.msg_iov        = &iov;
+        msg.msg_iovlen     = 1;
+        msg.msg_control    = ctrl;
+        msg.msg_controllen = sizeof(ctrl);
+
+        cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(sizeof(int32_t));
+        memcpy(CMSG_DATA(cmsg), &m_ringFd, sizeof(int32_t));
+
+        if (sendmsg(fd, &msg, MSG_NOSIGNAL) != sizeof(hello))
+        {
+            LOG_WARN("Failed to send the frame ring to a reader: %s\n",
+                     strerror(errno));
+            close(fd);
+            continue;
+        }
+
+        m_readers.push_back({fd, vector<bool>(m_config.numSlots, false), 0});
+        LOG_INFO("Frame reader connected to [%s], %ld reader(s).\n",
+                 m_config.path.c_str(), m_readers.size());
+    }
+}
+
+void FrameExporter::collectReleases(int32_t timeout)
+{
+    vector<struct pollfd>   fds;
+
+    for (const auto &r : m_readers)
+    {
+        fds.push_back({r.socket, POLLIN, 0});
+    }
+
+    if (fds.empty() || poll(fds.data(), fds.size(), timeout) <= 0)
+    {
+        return;
+    }
+
+    /* Go backwards, readers disconnecting are removed from the vector. */
+    for (uint64_t i = fds.size(); i-- > 0;)
+    {
+        auto   &r = m_readers[i];
+        bool    closed = (fds[i].revents & (POLLHUP | POLLERR)) != 0;
+
+        while (!closed && (fds[i].revents & POLLIN))
+        {
+            uint32_t    slot;
+            ssize_t     ret = recv(r.socket, &slot, sizeof(slot), 0);
+
+            if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+            {
+                break;
+            }
+
+            if (ret <= 0)
+            {
+                closed = true;
+            }
+            else if (ret == sizeof(slot) &&
+                     slot < r.held.size() && r.held[slot])
+            {
+                r.held[slot] = false;
+                r.numHeld--;
+                m_slotRefs[slot]--;
+            }
+        }
+
+        if (closed)
+        {
+            dropReader(i);
+        }
+    }
+}
+
+void FrameExporter::dropReader(uint64_t idx)
+{
+    auto &r = m_readers[idx];
+
+    for (uint64_t slot = 0; slot < r.held.size(); slot++)
+    {
+        if (r.held[slot])
+        {
+            m_slotRefs[slot]--;
+        }
+    }
+
+    close(r.socket);
+    m_readers.erase(m_readers.begin() + idx);
+
+    LOG_INFO("Frame reader disconnected from [%s], %ld reader(s).\n",
+             m_config.path.c_str(), m_readers.size());
+}
+
+int32_t FrameExporter::findFreeSlot() const
+{
+    for (int32_t i = 0; i < m_config.numSlots; i++)
+    {
+        int32_t slot = (m_nextSlot + i) % m_config.numSlots;
+
+        if (m_slotRefs[slot] == 0)
+        {
+            return slot;
+        }
+    }
+
+    return -1;
+}
+
+int32_t FrameExporter::render(GstBuffer *buffer)
+{
+    FrameExportRecord       record{};
+    const PostprocResult   *result;
+    GstMapInfo              map;
+    struct iovec            iov[2];
+    struct msghdr           msg{};
+    int32_t                 slot;
+    bool                    sent = false;
+    uint64_t                size = gst_buffer_get_size(buffer);
+
+    m_frameCnt++;
+
+    /* The readers map the ring they were sent, so it can only grow for
+     * larger frames while none is connected.
+     */
+    if (m_ring != nullptr && size > m_slotSize && m_readers.empty())
+    {
+        LOG_INFO("Re-creating the frame ring for frames of %ld bytes.\n", size);
+        releaseRing();
+    }
+
+    if (m_ring == nullptr && createRing(size) < 0)
+    {
+        return -1;
+    }
+
+    acceptReaders();
+    collectReleases(0);
+
+    if (m_readers.empty())
+    {
+        return 0;
+    }
+
+    slot = findFreeSlot();
+
+    /* Give the readers some time to release a slot before dropping. */
+    if (slot < 0 && m_config.block)
+    {
+        collectReleases(m_config.blockTimeout);
+        slot = findFreeSlot();
+    }
+
+    if (slot < 0)
+    {
+        m_dropCnt++;
+        return 0;
+    }
+
+    if (!gst_buffer_map(buffer, &map, GST_MAP_READ))
+    {
+        LOG_ERROR("Failed to map the frame for export.\n");
+        return -1;
+    }
+
+    /* The frame is dropped rather than stopping the output pipeline. */
+    if (map.size > m_slotSize)
+    {
+        if (m_oversizeCnt++ == 0)
+        {
+            LOG_WARN("Frame of %ld bytes does not fit a slot of %ld bytes, "
+                     "dropped until all readers disconnect.\n",
+                     map.size, m_slotSize);
+        }
+
+        gst_buffer_unmap(buffer, &map);
+        return 0;
+    }
+
+    memcpy(m_ring + slot * m_slotSize, map.data, map.size);
+
+    record.magic     = FRAME_EXPORT_MAGIC;
+    record.slot      = slot;
+    record.size      = map.size;
+    record.frameId   = m_frameCnt - 1;
+    record.timestamp = GST_BUFFER_PTS(buffer);
+
+    gst_buffer_unmap(buffer, &map);
+
+    result = getResultMeta(buffer);
+
+    if (result != nullptr)
+    {
+        record.resultSize = serializeResult(*result,
+                                            0,
+                                            record.frameId,
+                                            record.timestamp,
+                                            m_record);
+    }
+
+    iov[0].iov_base = &record;
+    iov[0].iov_len  = sizeof(record);
+    iov[1].iov_base = m_record.data();
+    iov[1].iov_len  = record.resultSize;
+    msg.msg_iov     = iov;
+    msg.msg_iovlen  = record.resultSize > 0 ? 2 : 1;
+
+    for (uint64_t i = m_readers.size(); i-- > 0;)
+    {
+        auto   &r = m_readers[i];
+        ssize_t ret;
+
+        /* Keep a slot for the next frame. */
+        if (r.numHeld >= m_config.numSlots - 1)
+        {
+            m_readerDropCnt++;
+            continue;
+        }
+
+        ret = sendmsg(r.socket, &msg, MSG_DONTWAIT | MSG_NOSIGNAL);
+
+        if (ret < 0)
+        {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+            {
+                m_readerDropCnt++;
+            }
+            else
+            {
+                dropReader(i);
+            }
+
+            continue;
+        }
+
+        r.held[slot] = true;
+        r.numHeld++;
+        m_slotRefs[slot]++;
+        sent = true;
+    }
+
+    if (sent)
+    {
+        m_sentCnt++;
+        m_nextSlot = (slot + 1) % m_config.numSlots;
+    }
+
+    return 0;
+}
+
+int32_t FrameExporter::registerElement()
+{
+    static const gboolean registered =
+        gst_element_register(nullptr,
+                             FRAME_EXPORT_FACTORY,
+                             GST_RANK_NONE,
+                             gst_edgeai_shm_sink_get_type());
+
+    return registered ? 0 : -1;
+}
+
+FrameExporter::~FrameExporter()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    stop();
+    reinterpret_cast<GstEdgeaiShmSink*>(m_element)->ctx = nullptr;
+    gst_object_unref(m_element);
+}
+
+} // namespace ti::edgeai::common
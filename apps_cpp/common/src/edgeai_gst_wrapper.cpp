@@ -31,30 +31,431 @@
  */
 /* Standard headers. */
 #include <map>
+#include <chrono>
+#include <cstring>
 #include <filesystem>
 
 /* Module headers. */
 #include <utils/include/ti_logger.h>
 #include <common/include/edgeai_gst_wrapper.h>
 #include <common/include/edgeai_gst_helper.h>
+#include <common/include/edgeai_utils.h>
 
 #define TI_GST_WRAPPER_DEFAULT_IMAGE_FRAMERATE  (12)
 #define GST_TIMEOUT 5000000000
 
+/* Buffers an element holds at most, as seen by the latency probes. */
+#define GST_PIPE_MAX_PENDING_BUFFERS            (16)
+
+/* Elements followed at most when looking for the flow of a queue. */
+#define GST_PIPE_MAX_FLOW_SEARCH_DEPTH          (32)
+
 using namespace ti::utils;
 
 namespace ti::edgeai::common
 {
+/* Seek back to the start of the stream without flushing. The SEGMENT flag
+ * keeps the pipeline in segment mode so that the next wrap is again
+ * signalled through SEGMENT_DONE instead of EOS.
+ */
+static void segmentLoopSeek(GstElement *pipeline, gpointer userData)
+{
+    gboolean ret;
+
+    (void)userData;
+
+    ret = gst_element_seek(pipeline,
+                           1.0,
+                           GST_FORMAT_TIME,
+                           GST_SEEK_FLAG_SEGMENT,
+                           GST_SEEK_TYPE_SET,
+                           0,
+                           GST_SEEK_TYPE_NONE,
+                           GST_CLOCK_TIME_NONE);
+
+    if (!ret)
+    {
+        LOG_ERROR("[%s] Segment seek failed.\n", GST_ELEMENT_NAME(pipeline));
+    }
+}
+
+/* Called from the streaming thread which posted the message, so the seek
+ * is deferred to the GStreamer thread pool instead of being issued here.
+ */
+static GstBusSyncReply segmentLoopBusHandler(GstBus        *bus,
+                                             GstMessage    *msg,
+                                             gpointer       userData)
+{
+    (void)bus;
+
+    if (GST_MESSAGE_TYPE(msg) == GST_MESSAGE_SEGMENT_DONE)
+    {
+        gst_element_call_async(GST_ELEMENT(userData),
+                               segmentLoopSeek,
+                               nullptr,
+                               nullptr);
+        gst_message_unref(msg);
+        return GST_BUS_DROP;
+    }
+
+    return GST_BUS_PASS;
+}
+
+/* Counts the buffers reaching an appsink, including the ones the appsink
+ * drops when its queue is full.
+ */
+static GstPadProbeReturn countBufferProbe(GstPad            *pad,
+                                          GstPadProbeInfo   *info,
+                                          gpointer           userData)
+{
+    auto   *counter = static_cast<GstPipeCounter *>(userData);
+
+    (void)pad;
+
+    if (info->type & GST_PAD_PROBE_TYPE_BUFFER_LIST)
+    {
+        counter->received += gst_buffer_list_length(GST_PAD_PROBE_INFO_BUFFER_LIST(info));
+    }
+    else
+    {
+        counter->received++;
+    }
+
+    return GST_PAD_PROBE_OK;
+}
+
+/* The appsrc queue dropped below its limit. */
+static void sinkNeedDataCb(GstElement  *appsrc,
+                           guint        length,
+                           gpointer     userData)
+{
+    auto   *handle = static_cast<GstPipeSinkHandle *>(userData);
+
+    (void)appsrc;
+    (void)length;
+
+    handle->full = false;
+}
+
+/* The appsrc queue reached its limit. */
+static void sinkEnoughDataCb(GstElement    *appsrc,
+                             gpointer       userData)
+{
+    auto   *handle = static_cast<GstPipeSinkHandle *>(userData);
+
+    (void)appsrc;
+
+    handle->full = true;
+}
+
+static int64_t probeTimeNs()
+{
+    auto now = chrono::steady_clock::now().time_since_epoch();
+
+    return chrono::duration_cast<chrono::nanoseconds>(now).count();
+}
+
+/* A buffer entered an element. */
+static GstPadProbeReturn latencyInProbe(GstPad             *pad,
+                                        GstPadProbeInfo    *info,
+                                        gpointer            userData)
+{
+    auto       *probe = static_cast<GstPipeElemProbe *>(userData);
+    GstBuffer  *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    int64_t     now = probeTimeNs();
+
+    (void)pad;
+
+    std::unique_lock<std::mutex> lock(probe->lock);
+
+    /* The buffers consumed without an output (ex:- dropped) age out. */
+    if (probe->pending.size() >= GST_PIPE_MAX_PENDING_BUFFERS)
+    {
+        probe->pending.pop_front();
+    }
+
+    probe->pending.push_back({GST_BUFFER_PTS(buffer), now});
+
+    return GST_PAD_PROBE_OK;
+}
+
+/* A buffer left an element. The elements keep the order of the buffers,
+ * so that the ones which entered before the matching one were consumed.
+ */
+static GstPadProbeReturn latencyOutProbe(GstPad            *pad,
+                                         GstPadProbeInfo   *info,
+                                         gpointer           userData)
+{
+    auto           *probe = static_cast<GstPipeElemProbe *>(userData);
+    GstBuffer      *buffer = GST_PAD_PROBE_INFO_BUFFER(info);
+    GstClockTime    pts = GST_BUFFER_PTS(buffer);
+    int64_t         now = probeTimeNs();
+    int64_t         arrival = -1;
+
+    (void)pad;
+
+    std::unique_lock<std::mutex> lock(probe->lock);
+
+    for (auto it = probe->pending.begin(); it != probe->pending.end(); it++)
+    {
+        if (it->first == pts)
+        {
+            arrival = it->second;
+            probe->pending.erase(probe->pending.begin(), it + 1);
+            break;
+        }
+    }
+
+    /* Reported by the telemetry thread, off the streaming threads. */
+    if (arrival >= 0)
+    {
+        probe->totalNs += now - arrival;
+        probe->count++;
+    }
+
+    return GST_PAD_PROBE_OK;
+}
+
+static gboolean addLatencyInProbe(GstElement   *elem,
+                                  GstPad       *pad,
+                                  gpointer      userData)
+{
+    (void)elem;
+
+    gst_pad_add_probe(pad,
+                      GST_PAD_PROBE_TYPE_BUFFER,
+                      latencyInProbe,
+                      userData,
+                      NULL);
+
+    return TRUE;
+}
+
+static gboolean addLatencyOutProbe(GstElement  *elem,
+                                   GstPad      *pad,
+                                   gpointer     userData)
+{
+    (void)elem;
+
+    gst_pad_add_probe(pad,
+                      GST_PAD_PROBE_TYPE_BUFFER,
+                      latencyOutProbe,
+                      userData,
+                      NULL);
+
+    return TRUE;
+}
+
+/* Called for every element of a pipeline, including the ones in bins. */
+static void addLatencyProbes(const GValue  *item,
+                             gpointer       userData)
+{
+    auto       *probes = static_cast<vector<GstPipeElemProbe *> *>(userData);
+    GstElement *elem = GST_ELEMENT(g_value_get_object(item));
+    const char *factory;
+    string      tag = "proc";
+
+    /* Only the elements in between take time of their own. The bins are
+     * visited through their elements.
+     */
+    if (GST_IS_BIN(elem) ||
+        GST_OBJECT_FLAG_IS_SET(elem, GST_ELEMENT_FLAG_SOURCE) ||
+        GST_OBJECT_FLAG_IS_SET(elem, GST_ELEMENT_FLAG_SINK))
+    {
+        return;
+    }
+
+    factory = GST_OBJECT_NAME(gst_element_get_factory(elem));
+
+    if (g_strcmp0(factory, "capsfilter") == 0)
+    {
+        return;
+    }
+
+    if (g_strcmp0(factory, "queue") == 0 ||
+        g_strcmp0(factory, "queue2") == 0 ||
+        g_strcmp0(factory, "multiqueue") == 0)
+    {
+        tag = "queue";
+    }
+
+    if (Statistics::addElementEntry(GST_ELEMENT_NAME(elem), tag) < 0)
+    {
+        return;
+    }
+
+    GstPipeElemProbe   *probe = new GstPipeElemProbe;
+
+    probe->name = GST_ELEMENT_NAME(elem);
+
+    gst_element_foreach_sink_pad(elem, addLatencyInProbe, probe);
+    gst_element_foreach_src_pad(elem, addLatencyOutProbe, probe);
+
+    probes->push_back(probe);
+}
+
+/* A leaky queue drops a buffer for every overrun. */
+static void queueOverrunCb(GstElement  *queue,
+                           gpointer     userData)
+{
+    auto   *counter = static_cast<GstPipeQueueCounter *>(userData);
+
+    (void)queue;
+
+    counter->dropped++;
+}
+
+/* Keeps a reference to the only pad of an element, or none if it has more
+ * than one.
+ */
+static gboolean getSinglePad(GstElement    *elem,
+                             GstPad        *pad,
+                             gpointer       userData)
+{
+    auto   *single = static_cast<GstPad **>(userData);
+
+    (void)elem;
+
+    if (*single != nullptr)
+    {
+        gst_object_unref(*single);
+        *single = nullptr;
+        return FALSE;
+    }
+
+    *single = GST_PAD(gst_object_ref(pad));
+
+    return TRUE;
+}
+
+/* Returns the "flowN" prefix of the first element named after a flow, the
+ * appsinks and appsrcs of the flows, found by following the links of an
+ * element downstream or upstream. The search stops at an element with more
+ * than one pad in that direction, a tee or a mosaic for instance, as the
+ * elements past it serve more than one flow.
+ */
+static string findFlowName(GstElement  *elem,
+                           bool         downstream)
+{
+    gst_object_ref(elem);
+
+    for (int32_t i = 0; i < GST_PIPE_MAX_FLOW_SEARCH_DEPTH; i++)
+    {
+        const gchar    *name = GST_ELEMENT_NAME(elem);
+        const gchar    *sep = strchr(name, '_');
+        GstPad         *pad = nullptr;
+        GstPad         *peer = nullptr;
+        GstElement     *next = nullptr;
+
+        if (g_str_has_prefix(name, "flow") && sep != nullptr)
+        {
+            string flowName(name, sep - name);
+
+            gst_object_unref(elem);
+            return flowName;
+        }
+
+        if (downstream)
+        {
+            gst_element_foreach_src_pad(elem, getSinglePad, &pad);
+        }
+        else
+        {
+            gst_element_foreach_sink_pad(elem, getSinglePad, &pad);
+        }
+
+        if (pad != nullptr)
+        {
+            peer = gst_pad_get_peer(pad);
+            gst_object_unref(pad);
+        }
+
+        if (peer != nullptr)
+        {
+            next = gst_pad_get_parent_element(peer);
+            gst_object_unref(peer);
+        }
+
+        gst_object_unref(elem);
+
+        if (next == nullptr)
+        {
+            break;
+        }
+
+        elem = next;
+    }
+
+    return "";
+}
+
+/* Called for every element of a pipeline, including the ones in bins. */
+static void addQueueCounter(const GValue   *item,
+                            gpointer        userData)
+{
+    auto       *counters = static_cast<map<string, GstPipeQueueCounter *> *>(userData);
+    GstElement *elem = GST_ELEMENT(g_value_get_object(item));
+    const char *factory = GST_OBJECT_NAME(gst_element_get_factory(elem));
+    gint        leaky = 0;
+
+    if (g_strcmp0(factory, "queue") != 0 &&
+        g_strcmp0(factory, "queue2") != 0)
+    {
+        return;
+    }
+
+    GstPipeQueueCounter    *counter = new GstPipeQueueCounter;
+
+    /* A queue2 never drops buffers and has no leaky property. */
+    if (g_strcmp0(factory, "queue") == 0)
+    {
+        g_object_get(elem, "leaky", &leaky, NULL);
+    }
+
+    counter->elem  = elem;
+    counter->leaky = leaky != 0;
+
+    if (counter->leaky)
+    {
+        g_signal_connect(elem,
+                         "overrun",
+                         G_CALLBACK(queueOverrunCb),
+                         counter);
+    }
+
+    /* The source pipeline queues lead to the appsinks of a flow, the
+     * sink pipeline ones come from its appsrc.
+     */
+    string flowName = findFlowName(elem, true);
+
+    if (flowName.empty())
+    {
+        flowName = findFlowName(elem, false);
+    }
+
+    string name = GST_ELEMENT_NAME(elem);
+
+    if (!flowName.empty())
+    {
+        name = flowName + "/" + name;
+    }
+
+    (*counters)[name] = counter;
+}
+
 GstPipe::GstPipe(vector<GstElement*>     &srcPipelines,
                  GstElement*             &sinkPipeline,
                  vector<vector<string>>  &srcElemNames,
-                 vector<string>          &sinkElemNames)
+                 vector<string>          &sinkElemNames,
+                 const vector<bool>      &srcLoop)
 {
     int32_t status = 0;
 
     /* Create the source pipeline. */
-    for (auto const &srcPipe : srcPipelines)
+    for (uint64_t i = 0; i < srcPipelines.size(); i++)
     {
+        auto const &srcPipe = srcPipelines[i];
+
         if (srcPipe == nullptr)
         {
             LOG_ERROR("Pipeline creation for source failed.\n");
@@ -63,6 +464,7 @@ GstPipe::GstPipe(vector<GstElement*>     &srcPipelines,
         else
         {
             m_srcPipe.push_back(srcPipe);
+            m_srcLoop.push_back(i < srcLoop.size() ? srcLoop[i] : false);
         }
     }
 
@@ -96,6 +498,30 @@ GstPipe::GstPipe(vector<GstElement*>     &srcPipelines,
 
                 /* Create a map entry for the new elemet created. */
                 m_srcElemMap[s] = elem;
+
+                if (GST_IS_APP_SINK(elem))
+                {
+                    GstPad         *pad = gst_element_get_static_pad(elem, "sink");
+                    GstPipeCounter *counter = new GstPipeCounter;
+
+                    gst_pad_add_probe(pad,
+                                      (GstPadProbeType)(GST_PAD_PROBE_TYPE_BUFFER |
+                                                        GST_PAD_PROBE_TYPE_BUFFER_LIST),
+                                      countBufferProbe,
+                                      counter,
+                                      NULL);
+                    gst_object_unref(pad);
+
+                    m_srcCounters[s] = counter;
+
+                    GstPipeSrcHandle   *handle = new GstPipeSrcHandle;
+
+                    handle->name    = s;
+                    handle->elem    = elem;
+                    handle->counter = counter;
+
+                    m_srcHandles[s] = handle;
+                }
             }
             if (status != 0)
                 break;
@@ -119,6 +545,47 @@ GstPipe::GstPipe(vector<GstElement*>     &srcPipelines,
 
             /* Create a map entry for the new elenet created. */
             m_sinkElemMap[s] = elem;
+
+            if (GST_IS_APP_SRC(elem))
+            {
+                GstPipeSinkHandle  *handle = new GstPipeSinkHandle;
+                GstCaps            *caps = gst_app_src_get_caps(GST_APP_SRC(elem));
+
+                handle->name      = s;
+                handle->elem      = elem;
+                handle->fixedCaps = caps != nullptr;
+
+                if (caps != nullptr)
+                {
+                    gst_caps_unref(caps);
+                }
+
+                g_signal_connect(elem,
+                                 "need-data",
+                                 G_CALLBACK(sinkNeedDataCb),
+                                 handle);
+                g_signal_connect(elem,
+                                 "enough-data",
+                                 G_CALLBACK(sinkEnoughDataCb),
+                                 handle);
+
+                m_sinkHandles[s] = handle;
+            }
+        }
+    }
+
+    if (status == 0)
+    {
+        vector<GstElement *>    pipelines(m_srcPipe);
+
+        pipelines.push_back(m_sinkPipe);
+
+        for (auto const &p : pipelines)
+        {
+            GstIterator *it = gst_bin_iterate_recurse(GST_BIN(p));
+
+            gst_iterator_foreach(it, addQueueCounter, &m_queueCounters);
+            gst_iterator_free(it);
         }
     }
 
@@ -142,8 +609,22 @@ int GstPipe::startPipeline()
         return -1;
     }
 
-    for (auto const &p : m_srcPipe)
+    for (uint64_t i = 0; i < m_srcPipe.size(); i++)
     {
+        auto const &p = m_srcPipe[i];
+
+        if (m_srcLoop[i])
+        {
+            /* Failing to setup the segment loop is not fatal. The pipeline
+             * falls back to the EOS based looping in getBuffer().
+             */
+            if (startSegmentLoop(p) < 0)
+            {
+                LOG_WARN("[%s] Segment looping not possible, falling back "
+                         "to seek on EOS.\n", GST_ELEMENT_NAME(p));
+            }
+        }
+
         ret = gst_element_set_state(p, GST_STATE_PLAYING);
 
         if (ret == GST_STATE_CHANGE_FAILURE)
@@ -156,6 +637,56 @@ int GstPipe::startPipeline()
     return 0;
 }
 
+int32_t GstPipe::startSegmentLoop(GstElement *pipeline)
+{
+    GstStateChangeReturn    ret;
+    GstBus                 *bus;
+    gboolean                seekRet;
+
+    ret = gst_element_set_state(pipeline, GST_STATE_PAUSED);
+
+    if (ret == GST_STATE_CHANGE_FAILURE)
+    {
+        LOG_ERROR("gst_element_set_state() failed.\n");
+        return -1;
+    }
+
+    /* Seeking is only possible once the pipeline has pre-rolled. Live
+     * sources do not pre-roll and cannot be looped anyway.
+     */
+    ret = gst_element_get_state(pipeline, NULL, NULL, GST_TIMEOUT);
+
+    if (ret != GST_STATE_CHANGE_SUCCESS)
+    {
+        return -1;
+    }
+
+    /* Install the handler before the seek so that a SEGMENT_DONE posted
+     * for a very short clip is not missed.
+     */
+    bus = gst_pipeline_get_bus(GST_PIPELINE(pipeline));
+    gst_bus_set_sync_handler(bus, segmentLoopBusHandler, pipeline, NULL);
+
+    seekRet = gst_element_seek(pipeline,
+                               1.0,
+                               GST_FORMAT_TIME,
+                               (GstSeekFlags)(GST_SEEK_FLAG_FLUSH |
+                                              GST_SEEK_FLAG_SEGMENT),
+                               GST_SEEK_TYPE_SET,
+                               0,
+                               GST_SEEK_TYPE_NONE,
+                               GST_CLOCK_TIME_NONE);
+
+    if (!seekRet)
+    {
+        gst_bus_set_sync_handler(bus, NULL, NULL, NULL);
+    }
+
+    gst_object_unref(bus);
+
+    return seekRet ? 0 : -1;
+}
+
 GstElement *GstPipe::findElementByName(GstElement      *pipeline,
                                        const string    &name)
 {
@@ -171,92 +702,178 @@ GstElement *GstPipe::findElementByName(GstElement      *pipeline,
     return elem;
 }
 
+/* Parse the caps of the frames pulled from an appsink. The frames are
+ * returned with a copy of them, declaring square pixels.
+ */
+static int32_t updateSrcCaps(GstPipeSrcHandle  *handle,
+                             GstCaps           *inCaps)
+{
+    GstCaps        *caps = gst_caps_copy(inCaps);
+    GstStructure   *strc = nullptr;
+    const gchar    *format;
+
+    if (caps == nullptr)
+    {
+        LOG_ERROR("[%s] gst_caps_copy() failed.\n", handle->name.c_str());
+        return -1;
+    }
+
+    strc = gst_caps_get_structure(caps, 0);
+
+    if (strc == nullptr)
+    {
+        LOG_ERROR("[%s] gst_caps_get_structure() failed.\n",
+                  handle->name.c_str());
+        gst_caps_unref(caps);
+        return -1;
+    }
+
+    gst_structure_get_int(strc, "width", &handle->width);
+    gst_structure_get_int(strc, "height", &handle->height);
+
+    format = gst_structure_get_string(strc, "format");
+    handle->format = format ? format : "";
+
+    gst_structure_set(strc,
+                      "pixel-aspect-ratio",
+                      GST_TYPE_FRACTION,
+                      1,
+                      1,
+                      NULL);
+
+    if (handle->caps != nullptr)
+    {
+        gst_caps_unref(handle->caps);
+    }
+
+    if (handle->inCaps != nullptr)
+    {
+        gst_caps_unref(handle->inCaps);
+    }
+
+    handle->caps   = caps;
+    handle->inCaps = gst_caps_ref(inCaps);
+
+    return 0;
+}
+
+GstPipeSrcHandle *GstPipe::getSrcHandle(const string &name)
+{
+    const auto &it = m_srcHandles.find(name);
+
+    if (it == m_srcHandles.end())
+    {
+        LOG_ERROR("[%s] 'elemName' lookup failed.\n", name.c_str());
+        return nullptr;
+    }
+
+    return it->second;
+}
+
+GstPipeSinkHandle *GstPipe::getSinkHandle(const string &name)
+{
+    const auto &it = m_sinkHandles.find(name);
+
+    if (it == m_sinkHandles.end())
+    {
+        LOG_ERROR("[%s] 'elemName' lookup failed.\n", name.c_str());
+        return nullptr;
+    }
+
+    return it->second;
+}
+
 int32_t GstPipe::getBuffer(const string        &name,
                            GstWrapperBuffer    &buf,
                            bool                loop,
                            bool                readonly)
 {
+    GstPipeSrcHandle   *handle = getSrcHandle(name);
+
+    if (handle == nullptr)
+    {
+        return -1;
+    }
+
+    return getBuffer(handle, buf, loop, readonly);
+}
+
+int32_t GstPipe::getBuffer(GstPipeSrcHandle    *handle,
+                           GstWrapperBuffer    &buf,
+                           bool                loop,
+                           bool                readonly)
+{
+    GstElement     *elem = handle->elem;
+    const char     *name = handle->name.c_str();
     GstSample      *sample = nullptr;
     GstBuffer      *buffer = nullptr;
     GstCaps        *caps = nullptr;
     int32_t         ret;
     int32_t         status = 0;
-    const auto     &it = m_srcElemMap.find(name);
     GstMapFlags     mapflag = readonly? GST_MAP_READ: GST_MAP_READWRITE;
 
-    if (it == m_srcElemMap.end())
-    {
-        LOG_ERROR("[%s] 'elemName' lookup failed.\n", name.c_str());
-        status = -1;
-    }
+    sample = gst_app_sink_try_pull_sample(GST_APP_SINK(elem), GST_TIMEOUT);
 
-    if (status == 0)
+    if (sample == nullptr)
     {
-        GstElement *elem = it->second;
+        auto isEos = gst_app_sink_is_eos(GST_APP_SINK(elem));
 
-        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(elem), GST_TIMEOUT);
-
-        if (sample == nullptr)
+        if (isEos)
         {
-            auto isEos = gst_app_sink_is_eos(GST_APP_SINK(elem));
-
-            if (isEos)
+            if (loop)
             {
-                if (loop)
+                /* Only reached by the sources which could not be looped
+                 * using segment seeks, see startSegmentLoop().
+                 */
+                // Mutex used in seek since seek can be called by multiple instances
+                // Mutex released at the end of this block
+                GST_PIPE_LOCK_SEEK_ACCESS;
+                gst_element_seek_simple(elem,
+                                        GST_FORMAT_TIME,
+                                        GST_SEEK_FLAG_FLUSH,
+                                        0);
+
+                sample = gst_app_sink_try_pull_sample(GST_APP_SINK(elem),
+                                                      GST_TIMEOUT);
+
+                if (sample == nullptr)
                 {
-                    // Mutex used in seek since seek can be called by multiple instances
-                    // Mutex released at the end of this block
-                    GST_PIPE_LOCK_SEEK_ACCESS;
-                    gst_element_seek_simple(elem,
-                                            GST_FORMAT_TIME,
-                                            GST_SEEK_FLAG_FLUSH,
-                                            0);
-
-                    sample = gst_app_sink_try_pull_sample(GST_APP_SINK(elem),
-                                                          GST_TIMEOUT);
-
-                    if (sample == nullptr)
-                    {
-                        LOG_ERROR("[%s] Could not get data from Gstreamer appsink.\n",
-                                  name.c_str());
-                        status = -1;
-                    }
-                }
-                else
-                {
-                    LOG_INFO("[%s] End of Stream \n", name.c_str());
-                    status = EOS;
+                    LOG_ERROR("[%s] Could not get data from Gstreamer appsink.\n",
+                              name);
+                    status = -1;
                 }
             }
             else
             {
-                LOG_ERROR("[%s] Could not get data from Gstreamer appsink.\n",
-                          name.c_str());
-                status = -1;
+                LOG_INFO("[%s] End of Stream \n", name);
+                status = EOS;
             }
         }
+        else
+        {
+            LOG_ERROR("[%s] Could not get data from Gstreamer appsink.\n",
+                      name);
+            status = -1;
+        }
     }
 
     if (status == 0)
     {
+        handle->counter->pulled++;
+
         caps = gst_sample_get_caps(sample);
 
         if (caps == nullptr)
         {
-            LOG_ERROR("[%s] gst_sample_get_caps() failed.\n", name.c_str());
+            LOG_ERROR("[%s] gst_sample_get_caps() failed.\n", name);
             status = -1;
         }
     }
 
-    if (status == 0)
+    /* The caps are only parsed when they change. */
+    if (status == 0 && caps != handle->inCaps)
     {
-        caps = gst_caps_copy(caps);
-
-        if (caps == nullptr)
-        {
-            LOG_ERROR("[%s] gst_caps_copy() failed.\n", name.c_str());
-            status = -1;
-        }
+        status = updateSrcCaps(handle, caps);
     }
 
     if (status == 0)
@@ -265,7 +882,7 @@ int32_t GstPipe::getBuffer(const string        &name,
 
         if (buffer == nullptr)
         {
-            LOG_ERROR("[%s] gst_sample_get_buffer() failed.\n", name.c_str());
+            LOG_ERROR("[%s] gst_sample_get_buffer() failed.\n", name);
             status = -1;
         }
     }
@@ -282,7 +899,7 @@ int32_t GstPipe::getBuffer(const string        &name,
 
             if (buffer == nullptr)
             {
-                LOG_ERROR("[%s] gst_buffer_copy() failed.\n", name.c_str());
+                LOG_ERROR("[%s] gst_buffer_copy() failed.\n", name);
                 status = -1;
             }
         }
@@ -294,41 +911,30 @@ int32_t GstPipe::getBuffer(const string        &name,
 
         if (ret == 0)
         {
-            LOG_ERROR("[%s] gst_buffer_map() failed.\n", name.c_str());
+            LOG_ERROR("[%s] gst_buffer_map() failed.\n", name);
             status = -1;
         }
     }
 
     if (status == 0)
     {
-        GstStructure   *strc = gst_caps_get_structure(caps, 0);
-
-        if (strc == nullptr)
-        {
-            LOG_ERROR("[%s] gst_caps_get_structure() failed.\n", name.c_str());
-            status = -1;
-        }
-        else
-        {
-            gst_structure_get_int(strc, "width", &buf.width);
-            gst_structure_get_int(strc, "height", &buf.height);
+        buf.width  = handle->width;
+        buf.height = handle->height;
 
-            sample = gst_sample_make_writable(sample);
-            gst_structure_set (strc,
-                               "pixel-aspect-ratio",
-                               GST_TYPE_FRACTION,
-                               1,
-                               1,
-                               NULL);
-
-            gst_sample_set_caps(sample,caps);
-            gst_caps_unref(caps);
+        sample = gst_sample_make_writable(sample);
+        gst_sample_set_caps(sample, handle->caps);
 
+        /* A buffer held by a sample is shared and cannot take any meta, so
+         * a writable copy only goes into the sample when it is pushed.
+         */
+        if (readonly == true)
+        {
             gst_sample_set_buffer(sample,buffer);
-            buf.sample = sample;
-            buf.gbuf   = buffer;
-            buf.addr   = buf.mapinfo.data;
         }
+
+        buf.sample = sample;
+        buf.gbuf   = buffer;
+        buf.addr   = buf.mapinfo.data;
     }
     else
     {
@@ -350,40 +956,74 @@ int32_t GstPipe::getBuffer(const string        &name,
 int32_t GstPipe::putBuffer(const string        &name,
                            GstWrapperBuffer    &buff)
 {
-    int32_t     status = 0;
-    const auto &it = m_sinkElemMap.find(name);
+    GstPipeSinkHandle  *handle = getSinkHandle(name);
 
-    if (it == m_sinkElemMap.end())
+    if (handle == nullptr)
     {
-        LOG_ERROR("'name' lookup failed.\n");
-        status = -1;
+        return -1;
+    }
+
+    return putBuffer(handle, buff);
+}
+
+int32_t GstPipe::putBuffer(GstPipeSinkHandle   *handle,
+                           GstWrapperBuffer    &buff)
+{
+    GstAppSrc  *appsrc = GST_APP_SRC(handle->elem);
+
+    if (!handle->bounded)
+    {
+        gst_app_src_set_max_bytes(appsrc,
+                                  GST_PIPE_SINK_QUEUE_DEPTH *
+                                  gst_buffer_get_size(buff.gbuf));
+        handle->bounded = true;
+    }
+
+    /* The caps are negotiated once if fixed on the appsrc, instead of
+     * being checked against the ones of every sample.
+     */
+    if (handle->fixedCaps)
+    {
+        gst_app_src_push_buffer(appsrc, gst_buffer_ref(buff.gbuf));
     }
     else
     {
-        GstElement *elem = it->second;
-        gst_app_src_push_sample(GST_APP_SRC(elem), buff.sample);
+        gst_sample_set_buffer(buff.sample, buff.gbuf);
+        gst_app_src_push_sample(appsrc, buff.sample);
     }
 
-    return status;
+    return 0;
 }
 
-int32_t GstPipe::sendEOS(const string        &name)
+bool GstPipe::isSinkReady(const string &name)
 {
-    int32_t     status = 0;
-    const auto &it = m_sinkElemMap.find(name);
+    const auto &it = m_sinkHandles.find(name);
 
-    if (it == m_sinkElemMap.end())
+    if (it == m_sinkHandles.end())
     {
-        LOG_ERROR("'name' lookup failed.\n");
-        status = -1;
+        return true;
     }
-    else
+
+    return isSinkReady(it->second);
+}
+
+int32_t GstPipe::sendEOS(const string        &name)
+{
+    GstPipeSinkHandle  *handle = getSinkHandle(name);
+
+    if (handle == nullptr)
     {
-        GstElement *elem = it->second;
-        gst_app_src_end_of_stream(GST_APP_SRC(elem));
+        return -1;
     }
 
-    return status;
+    return sendEOS(handle);
+}
+
+int32_t GstPipe::sendEOS(GstPipeSinkHandle *handle)
+{
+    gst_app_src_end_of_stream(GST_APP_SRC(handle->elem));
+
+    return 0;
 }
 
 int32_t GstPipe::allocBuffer(GstWrapperBuffer  &buf,
@@ -537,6 +1177,18 @@ GstPipe::~GstPipe()
 {
     LOG_DEBUG("DESTRUCTOR\n");
 
+    /* Stop the queue telemetry before the elements go away. */
+    if (m_telemetryThread.joinable())
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_telemetryMutex);
+            m_telemetryRunning = false;
+        }
+
+        m_telemetryCv.notify_all();
+        m_telemetryThread.join();
+    }
+
     //Wait for EOS from sink pipeline
     auto bus = gst_pipeline_get_bus(GST_PIPELINE(m_sinkPipe));
 
@@ -577,6 +1229,10 @@ GstPipe::~GstPipe()
     //Set the pipelines to NULL and unref
     for (auto const &p : m_srcPipe)
     {
+        auto srcBus = gst_pipeline_get_bus(GST_PIPELINE(p));
+        gst_bus_set_sync_handler(srcBus, NULL, NULL, NULL);
+        gst_object_unref(srcBus);
+
         gst_element_set_state(p, GST_STATE_NULL);
         gst_object_unref(p);
     }
@@ -596,6 +1252,152 @@ GstPipe::~GstPipe()
         auto const &src = m.second;
         gst_object_unref(src);
     }
+
+    /* The pipelines are stopped, no probe can run anymore. */
+    for (auto &m : m_srcCounters)
+    {
+        delete m.second;
+    }
+
+    for (auto &m : m_srcHandles)
+    {
+        auto const &handle = m.second;
+
+        if (handle->caps != nullptr)
+        {
+            gst_caps_unref(handle->caps);
+        }
+
+        if (handle->inCaps != nullptr)
+        {
+            gst_caps_unref(handle->inCaps);
+        }
+
+        delete handle;
+    }
+
+    for (auto &m : m_sinkHandles)
+    {
+        delete m.second;
+    }
+
+    for (auto &p : m_elemProbes)
+    {
+        delete p;
+    }
+
+    for (auto &m : m_queueCounters)
+    {
+        delete m.second;
+    }
+}
+
+void GstPipe::enableLatencyProbes()
+{
+    vector<GstElement *>    pipelines(m_srcPipe);
+
+    pipelines.push_back(m_sinkPipe);
+
+    for (auto const &p : pipelines)
+    {
+        GstIterator *it = gst_bin_iterate_recurse(GST_BIN(p));
+
+        gst_iterator_foreach(it, addLatencyProbes, &m_elemProbes);
+        gst_iterator_free(it);
+    }
+
+    LOG_INFO("Latency probes installed on %ld elements.\n",
+             m_elemProbes.size());
+}
+
+void GstPipe::getQueueStats(map<string, GstPipeQueueStat> &stats)
+{
+    for (auto const &[name, c] : m_queueCounters)
+    {
+        GstPipeQueueStat   &stat = stats[name];
+        guint               level = 0;
+
+        g_object_get(c->elem, "current-level-buffers", &level, NULL);
+
+        stat.level   = level;
+        stat.leaky   = c->leaky;
+        stat.dropped = c->dropped;
+    }
+}
+
+void GstPipe::startTelemetry(uint32_t periodMs)
+{
+    for (auto const &[name, c] : m_queueCounters)
+    {
+        Statistics::addElementEntry(name, "queue");
+    }
+
+    m_telemetryRunning = true;
+    m_telemetryThread = std::thread([this, periodMs]{telemetryLoop(periodMs);});
+}
+
+void GstPipe::telemetryLoop(uint32_t periodMs)
+{
+    map<string, GstPipeQueueStat>   last;
+    map<string, GstPipeQueueStat>   stats;
+
+    getQueueStats(last);
+
+    std::unique_lock<std::mutex> lock(m_telemetryMutex);
+
+    while (!m_telemetryCv.wait_for(lock,
+                                   chrono::milliseconds(periodMs),
+                                   [this]{return !m_telemetryRunning;}))
+    {
+        getQueueStats(stats);
+
+        for (auto const &p : m_elemProbes)
+        {
+            int64_t     totalNs;
+            uint64_t    count;
+
+            {
+                std::unique_lock<std::mutex> probeLock(p->lock);
+
+                totalNs = p->totalNs;
+                count   = p->count;
+                p->totalNs = 0;
+                p->count   = 0;
+            }
+
+            if (count > 0)
+            {
+                Statistics::reportElementTime(p->name,
+                                              totalNs / 1e6 / count,
+                                              count);
+            }
+        }
+
+        for (auto const &[name, s] : stats)
+        {
+            Statistics::reportElementMetric(name, "level", "buf", s.level);
+
+            if (s.leaky)
+            {
+                float rate = (s.dropped - last[name].dropped) * 1000.0 / periodMs;
+
+                Statistics::reportElementMetric(name, "drops", "fps", rate);
+            }
+        }
+
+        last.swap(stats);
+    }
+}
+
+void GstPipe::getBufferCounts(map<string, GstPipeBufferCount> &counts)
+{
+    for (auto const &[name, c] : m_srcCounters)
+    {
+        GstPipeBufferCount &count = counts[name];
+
+        count.received = c->received;
+        count.pulled   = c->pulled;
+    }
 }
 
 } // namespace ti::edgeai::common
@@ -40,7 +40,15 @@ namespace ti::edgeai::common
 
     const YAML::Node getGstElementMap()
     {
-        const string  &GST_ELEMENT_MAP_PATH = "/opt/edgeai-gst-apps/configs/gst_plugins_map.yaml";
+        const char    *appsPath = std::getenv("EDGEAI_GST_APPS_PATH");
+        string         GST_ELEMENT_MAP_PATH = "/opt/edgeai-gst-apps/configs/gst_plugins_map.yaml";
+
+        /* Host builds run from a checkout instead of /opt. */
+        if (appsPath != NULL && appsPath != string(""))
+        {
+            GST_ELEMENT_MAP_PATH = string(appsPath) + "/configs/gst_plugins_map.yaml";
+        }
+
         if (!std::filesystem::exists(GST_ELEMENT_MAP_PATH))
         {
             LOG_ERROR("The file [%s] does'nt exist.\n" , GST_ELEMENT_MAP_PATH.c_str());
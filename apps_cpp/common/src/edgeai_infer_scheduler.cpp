@@ -0,0 +1,134 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <algorithm>
+#include <climits>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_infer_scheduler.h>
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+InferScheduler::InferScheduler(int32_t numSlots):
+    m_numSlots(max(numSlots, 1)),
+    m_minPriority(INT_MAX),
+    m_maxPriority(INT_MIN)
+{
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+void InferScheduler::addUser(int32_t priority)
+{
+    lock_guard<mutex>   lock(m_mutex);
+
+    m_minPriority = min(m_minPriority, priority);
+    m_maxPriority = max(m_maxPriority, priority);
+}
+
+int32_t InferScheduler::run(DLInferer             *inferer,
+                            int32_t                priority,
+                            bool                   sheddable,
+                            const VecDlTensorPtr  &inputs,
+                            VecDlTensorPtr        &outputs)
+{
+    int32_t status;
+
+    /* Nothing to arbitrate between users of equal priority. */
+    if (m_minPriority == m_maxPriority)
+    {
+        return inferer->run(inputs, outputs);
+    }
+
+    {
+        unique_lock<mutex>  lock(m_mutex);
+
+        if (sheddable &&
+            (m_running.size() >= m_numSlots || !m_waiting.empty()))
+        {
+            int32_t top = INT_MIN;
+
+            if (!m_running.empty())
+            {
+                top = *m_running.begin();
+            }
+
+            if (!m_waiting.empty())
+            {
+                top = max(top, m_waiting.begin()->first);
+            }
+
+            if (top > priority)
+            {
+                return INFER_SCHED_SHED;
+            }
+        }
+
+        m_waiting[priority]++;
+
+        m_cv.wait(lock, [&]
+        {
+            return m_running.size() < m_numSlots &&
+                   m_waiting.begin()->first == priority;
+        });
+
+        if (--m_waiting[priority] == 0)
+        {
+            m_waiting.erase(priority);
+        }
+
+        m_running.insert(priority);
+    }
+
+    status = inferer->run(inputs, outputs);
+
+    {
+        lock_guard<mutex>   lock(m_mutex);
+
+        m_running.erase(m_running.find(priority));
+    }
+
+    m_cv.notify_all();
+
+    return status;
+}
+
+InferScheduler::~InferScheduler()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+}
+
+} // namespace ti::edgeai::common
+
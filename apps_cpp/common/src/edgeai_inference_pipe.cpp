@@ -38,8 +38,9 @@
 
 #define TI_EDGEAI_GET_TIME() chrono::system_clock::now()
 
+/* Milliseconds, without truncating the runs shorter than one. */
 #define TI_EDGEAI_GET_DIFF(_START, _END) \
-chrono::duration_cast<chrono::milliseconds>(_END - _START).count()
+chrono::duration<float, std::milli>(_END - _START).count()
 
 namespace ti::edgeai::common
 {
@@ -65,23 +66,29 @@ InferencePipe::InferencePipe(const InferencePipeConfig &config,
     m_debugObj(config.debugConfig)
 {
     const VecDlTensor  *dlInfOutputs;
-    int32_t             status;
+    int32_t             status = 0;
 
     /* Set the instance Id. */
     m_instId = m_instCnt++;
 
-    // Query the output information for setting up the output buffers
-    dlInfOutputs = m_inferer->getOutputInfo();
-    m_numOutputs = dlInfOutputs->size();
+    /* The tensors never reach the application if the inference runs in
+     * the pipeline, where the model may have no inferer in the application.
+     */
+    if (!m_config.inPipeline)
+    {
+        // Query the output information for setting up the output buffers
+        dlInfOutputs = m_inferer->getOutputInfo();
+        m_numOutputs = dlInfOutputs->size();
 
-    status = createBuffers(dlInfOutputs, m_inferOutputBuff, true);
+        status = createBuffers(dlInfOutputs, m_inferOutputBuff, true);
 
-    if (status < 0)
-    {
-        LOG_ERROR("createBuffers(m_inferOutputBuff) failed.\n");
+        if (status < 0)
+        {
+            LOG_ERROR("createBuffers(m_inferOutputBuff) failed.\n");
+        }
     }
 
-    if (status == 0)
+    if (status == 0 && !m_config.inPipeline)
     {
         const VecDlTensor  *dlInfInputs;
 
@@ -101,6 +108,75 @@ InferencePipe::InferencePipe(const InferencePipeConfig &config,
         }
     }
 
+    /* The element holds one set of output buffers while the other one
+     * is being filled.
+     */
+    if (status == 0 && m_config.postProcElement)
+    {
+        status = createBuffers(dlInfOutputs, m_spareOutputBuff, true);
+
+        if (status < 0)
+        {
+            LOG_ERROR("createBuffers(m_spareOutputBuff) failed.\n");
+        }
+
+        m_config.postProcElement->setStatsKey(m_instId);
+    }
+
+    if (status == 0 && !m_config.inPipeline && !m_config.captureFile.empty())
+    {
+        try
+        {
+            m_capture = new TensorCaptureWriter(m_config.captureFile,
+                                                *m_inferer->getInputInfo(),
+                                                *dlInfOutputs);
+        }
+        catch (const runtime_error &e)
+        {
+            LOG_ERROR("%s\n", e.what());
+            status = -1;
+        }
+    }
+
+    if (status == 0 && !m_config.inPipeline && m_config.motionThreshold > 0)
+    {
+        MotionDetectConfig  motionConfig;
+
+        motionConfig.threshold       = m_config.motionThreshold;
+        motionConfig.refreshInterval = m_config.motionRefresh;
+
+        m_motionDetector = new MotionDetector(motionConfig);
+    }
+
+    if (status == 0 && !m_config.inPipeline && !m_config.resultSocket.empty())
+    {
+        try
+        {
+            m_publisher = new ResultPublisher(m_config.resultSocket);
+        }
+        catch (const runtime_error &e)
+        {
+            LOG_ERROR("%s\n", e.what());
+            status = -1;
+        }
+
+        if (m_config.postProcElement)
+        {
+            m_config.postProcElement->setPublisher(m_publisher);
+        }
+    }
+
+    if (status == 0)
+    {
+        m_postProcObj->setResultsRequired(m_publisher != nullptr ||
+                                          m_config.exportResults);
+
+        if (m_config.postProcElement)
+        {
+            m_config.postProcElement->setExportResults(m_config.exportResults);
+        }
+    }
+
     if (status < 0)
     {
         throw runtime_error("InferencePipe object creation failed.");
@@ -114,12 +190,48 @@ int32_t InferencePipe::getInstId()
     return m_instId;
 }
 
-void InferencePipe::start(GstPipe   *gstPipe)
+int32_t InferencePipe::start(GstPipe   *gstPipe)
 {
+    int32_t status = 0;
+
     m_gstPipe = gstPipe;
 
-    /* Launch processing threads. */
-    launchThreads();
+    /* The pre-processed frames are consumed in the pipeline if it runs
+     * the inference, the sensor frames are not used if only the results
+     * are.
+     */
+    if (!m_config.inPipeline)
+    {
+        m_preProcSrc = m_gstPipe->getSrcHandle(m_srcElemNames[1]);
+
+        if (m_preProcSrc == nullptr)
+        {
+            status = -1;
+        }
+    }
+
+    if (status == 0 && !m_config.metadataOnly)
+    {
+        m_sensorSrc = m_gstPipe->getSrcHandle(m_srcElemNames[0]);
+        m_sink = m_gstPipe->getSinkHandle(m_sinkElemName);
+
+        if (m_sensorSrc == nullptr || m_sink == nullptr)
+        {
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        /* Launch processing threads. */
+        status = launchThreads();
+    }
+    else
+    {
+        LOG_ERROR("Could not bind the GST elements of the flow.\n");
+    }
+
+    return status;
 }
 
 /**
@@ -137,7 +249,19 @@ int32_t InferencePipe::launchThreads()
     /* Launch the inference thread using a lambda function.
      * The usage "[=]" or [this] captures entire class context.
      */
-    m_inferThreadId = std::thread([this]{inferenceThread();});
+    if (m_config.inPipeline)
+    {
+        m_inferThreadId = std::thread([this]{forwardThread();});
+    }
+    else
+    {
+        m_inferThreadId = std::thread([this]{inferenceThread();});
+
+        if (m_config.postProcElement)
+        {
+            m_forwardThreadId = std::thread([this]{forwardThread();});
+        }
+    }
 
     return status;
 }
@@ -161,6 +285,11 @@ void InferencePipe::waitForExit()
     {
         m_inferThreadId.join();
     }
+
+    if (m_forwardThreadId.joinable())
+    {
+        m_forwardThreadId.join();
+    }
 }
 
 int32_t InferencePipe::createBuffers(const VecDlTensor    *ifInfoList,
@@ -198,7 +327,23 @@ int InferencePipe::runModel(const VecDlTensorPtr    &inVecVar,
     int32_t status;
 
     // Run the model
-    status = m_inferer->run(inVecVar, outVecVar);
+    if (m_config.scheduler != nullptr)
+    {
+        /* Keep inferring until there are results to show, and while the
+         * flow is below its target rate.
+         */
+        bool sheddable = m_inferCnt > 0 && m_inferFps >= m_config.targetFps;
+
+        status = m_config.scheduler->run(m_inferer,
+                                         m_config.priority,
+                                         sheddable,
+                                         inVecVar,
+                                         outVecVar);
+    }
+    else
+    {
+        status = m_inferer->run(inVecVar, outVecVar);
+    }
 
     if (status < 0)
     {
@@ -222,7 +367,11 @@ void InferencePipe::inferenceThread()
     TimePoint           end;
     TimePoint           prev_frame;
     TimePoint           curr_frame;
+    TimePoint           last_infer;
     bool                first_frame = true;
+    bool                inferred;
+    bool                cameraPulled;
+    GstClockTime        timestamp;
     float               diff;
     int32_t             status;
 
@@ -234,81 +383,292 @@ void InferencePipe::inferenceThread()
          * is available from the sensor.
          */
 
+        /* Only every n-th frame is inferred, the others are displayed
+         * with the last results. Pre-processed frames only arrive for the
+         * frames let into the pre-processing branch.
+         */
+        bool inferFrame = (m_inputCnt % m_config.everyNthFrame) == 0;
+        bool preProcFrame = (m_inputCnt % m_config.preProcInterval) == 0;
+        m_inputCnt++;
+        inferred = false;
+        cameraPulled = false;
+
+        /* The camera frames are handled by the post-processing element,
+         * or not used at all, only the pre-processed ones come through here.
+         */
+        if ((m_config.postProcElement || m_config.metadataOnly) &&
+            !preProcFrame)
+        {
+            continue;
+        }
+
         // Starting point to capture performance metrics
         ti::utils::startRec();
 
-        // Run pre-processing
-        status = m_gstPipe->getBuffer(m_srcElemNames[1],
-                                      inputBuff,
-                                      m_config.loop,
-                                      true);
-        if (status != 0)
+        if (preProcFrame)
         {
-            if (status != EOS)
+            // Run pre-processing
+            status = m_gstPipe->getBuffer(m_preProcSrc,
+                                          inputBuff,
+                                          m_config.loop,
+                                          true);
+            if (status != 0)
             {
-                LOG_ERROR("Could not get 'input' buffer from Gstreamer");
-            }
+                if (status != EOS)
+                {
+                    LOG_ERROR("Could not get 'input' buffer from Gstreamer");
+                }
 
-            break;
+                break;
+            }
         }
 
-        frame = inputBuff.getAddr();
+        /* With motion gating, the camera frame is checked against the
+         * last inferred one before running the model.
+         */
+        if (inferFrame && m_motionDetector)
+        {
+            status = m_gstPipe->getBuffer(m_sensorSrc,
+                                          cameraBuff,
+                                          m_config.loop,
+                                          false);
 
-        status = (*m_preProcObj)(frame,
-                     m_inferInputBuff,
-                 m_config.zeroCopyEnable);
+            if (status != 0)
+            {
+                if (status != EOS)
+                {
+                    LOG_ERROR("Could not get 'camera' buffer from Gstreamer");
+                }
 
-        if (status != 0)
+                if (preProcFrame)
+                {
+                    m_gstPipe->freeBuffer(inputBuff);
+                }
+
+                break;
+            }
+
+            cameraPulled = true;
+
+            /* The rows of the mapped frame may be padded. */
+            int32_t stride = cameraBuff.height > 0 ?
+                             cameraBuff.mapinfo.size / cameraBuff.height : 0;
+
+            inferFrame =
+                m_motionDetector->isChanged(reinterpret_cast<uint8_t*>(cameraBuff.getAddr()),
+                                            cameraBuff.width,
+                                            cameraBuff.height,
+                                            stride);
+
+            if (!inferFrame)
+            {
+                m_staticCnt++;
+            }
+        }
+
+        if (inferFrame)
         {
-            LOG_ERROR("Pre-processing execution failed.\n");
-            break;
+            frame = inputBuff.getAddr();
+
+            status = (*m_preProcObj)(frame,
+                         m_inferInputBuff,
+                     m_config.zeroCopyEnable);
+
+            if (status != 0)
+            {
+                LOG_ERROR("Pre-processing execution failed.\n");
+                break;
+            }
+
+            // Run inference
+            start = TI_EDGEAI_GET_TIME();
+            status = runModel(m_inferInputBuff, m_inferOutputBuff);
+            end = TI_EDGEAI_GET_TIME();
+
+            if (status == INFER_SCHED_SHED)
+            {
+                /* The frame is still displayed, with the last results. */
+                m_shedCnt++;
+                status = 0;
+            }
+            else if (status == 0)
+            {
+                diff = TI_EDGEAI_GET_DIFF(start, end);
+                Statistics::reportProcTime(m_instId, "dl-inference", diff);
+
+                chrono::duration<float> interval = end - last_infer;
+
+                if (m_inferCnt > 0 && interval.count() > 0)
+                {
+                    float fps = 1.0f / interval.count();
+
+                    m_inferFps = m_inferCnt == 1 ? fps : 0.9f * m_inferFps + 0.1f * fps;
+                }
+
+                last_infer = end;
+                inferred = true;
+                m_inferCnt++;
+
+                /* A shed frame is not compared against, the next one is
+                 * checked against the last inferred frame again.
+                 */
+                if (m_motionDetector)
+                {
+                    m_motionDetector->updateReference();
+                }
+            }
+            else
+            {
+                LOG_ERROR("Failed to run the model.\n");
+                break;
+            }
         }
 
-        // Run inference
-        start = TI_EDGEAI_GET_TIME();
-        status = runModel(m_inferInputBuff, m_inferOutputBuff);
-        end = TI_EDGEAI_GET_TIME();
+        /* Record the tensors before the input buffer is released, it may
+         * be backing the input tensors when zero copy is enabled. The
+         * debug window counts the input frames, skipped or not.
+         */
+        if (m_capture && inferred &&
+            (m_inputCnt >= m_config.debugConfig.startFrame) &&
+            (m_inputCnt <= m_config.debugConfig.endFrame))
+        {
+            auto inferTime =
+                chrono::duration_cast<chrono::nanoseconds>(end - start).count();
 
-        diff = TI_EDGEAI_GET_DIFF(start, end);
-        Statistics::reportProcTime(m_instId, "dl-inference", diff);
+            m_capture->write(m_inputCnt - 1,
+                             inferTime,
+                             m_inferInputBuff,
+                             m_inferOutputBuff);
+        }
 
-        if (status)
+        timestamp = GST_CLOCK_TIME_NONE;
+
+        if (preProcFrame)
         {
-            LOG_ERROR("Failed to run the model.\n");
-            break;
+            timestamp = GST_BUFFER_PTS(inputBuff.gbuf);
+            m_gstPipe->freeBuffer(inputBuff);
         }
 
-        m_gstPipe->freeBuffer(inputBuff);
+        /* Hand the results over to the post-processing element and keep
+         * filling the buffers it was holding.
+         */
+        if (m_config.postProcElement)
+        {
+            if (inferred)
+            {
+                m_config.postProcElement->exchangeResults(m_inferOutputBuff);
+
+                if (m_inferOutputBuff.empty())
+                {
+                    m_inferOutputBuff.swap(m_spareOutputBuff);
+                }
+            }
+
+            ti::utils::endRec();
+            continue;
+        }
 
         // Run post-process logic
-        status = m_gstPipe->getBuffer(m_srcElemNames[0],
-                                      cameraBuff,
-                                      m_config.loop,
-                                      false);
+        if (!cameraPulled && !m_config.metadataOnly)
+        {
+            status = m_gstPipe->getBuffer(m_sensorSrc,
+                                          cameraBuff,
+                                          m_config.loop,
+                                          false);
 
-        if (status != 0)
+            if (status != 0)
+            {
+                if (status != EOS)
+                {
+                    LOG_ERROR("Could not get 'camera' buffer from Gstreamer");
+                }
+                break;
+            }
+        }
+
+        /* The frame is not drawn on if the output cannot take it. */
+        bool late = !m_config.metadataOnly &&
+                    m_config.dropLateFrames &&
+                    !m_gstPipe->isSinkReady(m_sink);
+
+        m_postProcObj->setFrameIndex(m_inputCnt - 1);
+
+        start = TI_EDGEAI_GET_TIME();
+        if (m_config.metadataOnly || late)
         {
-            if (status != EOS)
+            /* Only the new results are decoded, without a frame to draw on. */
+            if (inferred)
             {
-                LOG_ERROR("Could not get 'camera' buffer from Gstreamer");
+                m_postProcObj->setResultsUpdated(true);
+                (*m_postProcObj)(nullptr, m_inferOutputBuff);
             }
-            break;
         }
+        else
+        {
+            m_postProcObj->setResultsUpdated(inferred);
+            (*m_postProcObj)(cameraBuff.getAddr(),
+                             m_inferOutputBuff);
+        }
+        end = TI_EDGEAI_GET_TIME();
 
-        (*m_postProcObj)(cameraBuff.getAddr(),
-                         m_inferOutputBuff);
+        diff = TI_EDGEAI_GET_DIFF(start, end);
+        Statistics::reportProcTime(m_instId, "post-process", diff);
 
-        /* Send the buffer to the output pipeline. */
-        status = m_gstPipe->putBuffer(m_sinkElemName, cameraBuff);
+        auto result = m_postProcObj->getResult();
 
-        if (status != 0)
+        if (m_config.metadataOnly)
         {
-            LOG_ERROR("Could not put 'post-processed' buffer to Gstreamer");
-            break;
+            /* The results are stamped with the pre-processed frame. */
+            if (m_publisher && inferred)
+            {
+                m_publisher->publish(*result,
+                                     m_instId,
+                                     m_inputCnt - 1,
+                                     timestamp);
+            }
         }
+        else if (late)
+        {
+            if (m_publisher)
+            {
+                m_publisher->publish(*result,
+                                     m_instId,
+                                     m_inputCnt - 1,
+                                     GST_BUFFER_PTS(cameraBuff.gbuf));
+            }
 
-        /* Free the buffer. */
-        m_gstPipe->freeBuffer(cameraBuff);
+            m_gstPipe->freeBuffer(cameraBuff);
+            m_lateCnt++;
+        }
+        else
+        {
+            /* Hand the decoded results over with the frame. */
+            if (m_config.exportResults &&
+                addResultMeta(cameraBuff.gbuf, result) < 0)
+            {
+                LOG_ERROR("addResultMeta() failed.\n");
+            }
+
+            if (m_publisher)
+            {
+                m_publisher->publish(*result,
+                                     m_instId,
+                                     m_inputCnt - 1,
+                                     GST_BUFFER_PTS(cameraBuff.gbuf));
+            }
+
+            /* Send the buffer to the output pipeline. */
+            status = m_gstPipe->putBuffer(m_sink, cameraBuff);
+
+            if (status != 0)
+            {
+                LOG_ERROR("Could not put 'post-processed' buffer to Gstreamer");
+                break;
+            }
+
+            /* Free the buffer. */
+            m_gstPipe->freeBuffer(cameraBuff);
+        }
 
         /* End point for capturing performance metrics. 
            Capturing metrics paused until startRec() is called again. */
@@ -325,6 +685,8 @@ void InferencePipe::inferenceThread()
 
             Statistics::reportMetric(m_instId, "total time", "ms", diff);
             Statistics::reportMetric(m_instId, "framerate", "fps", 1000/diff);
+
+            reportInputDrops();
         }
         else
         {
@@ -334,20 +696,161 @@ void InferencePipe::inferenceThread()
 
     } // while (m_running)
 
-    /* Send EOS to gst sink element*/
-    m_gstPipe->sendEOS(m_sinkElemName);
+    if (m_shedCnt > 0)
+    {
+        LOG_INFO("Shed %ld of %ld frames.\n",
+                 m_shedCnt, m_shedCnt + m_inferCnt);
+    }
+
+    if (m_motionDetector)
+    {
+        LOG_INFO("Skipped %ld of %ld frames without motion.\n",
+                 m_staticCnt, m_inputCnt);
+    }
+
+    if (m_lateCnt > 0)
+    {
+        LOG_INFO("Dropped %ld of %ld frames the output was too slow for.\n",
+                 m_lateCnt, m_inputCnt);
+    }
+
+    /* Send EOS to gst sink element, the forwarding thread does it if the
+     * post-processing runs in an element. There is none if only the
+     * results are used.
+     */
+    if (!m_config.postProcElement && !m_config.metadataOnly)
+    {
+        m_gstPipe->sendEOS(m_sink);
+    }
 
     LOG_INFO("Exiting inference thread.\n");
 
     return;
 }
 
+void InferencePipe::reportInputDrops()
+{
+    TimePoint   now = TI_EDGEAI_GET_TIME();
+    uint64_t    dropped = 0;
+    float       diff = TI_EDGEAI_GET_DIFF(m_inputDropTime, now);
+
+    /* The frames which reached an appsink and were never pulled were
+     * dropped by it, but for the few in its queue.
+     */
+    for (auto const &handle : {m_sensorSrc, m_preProcSrc})
+    {
+        if (handle != nullptr)
+        {
+            uint64_t pulled = handle->counter->pulled;
+
+            dropped += handle->counter->received - pulled;
+        }
+    }
+
+    if (m_inputDropTime == TimePoint{})
+    {
+        m_inputDropCnt  = dropped;
+        m_inputDropTime = now;
+    }
+    else if (diff >= 1000)
+    {
+        uint64_t delta = dropped > m_inputDropCnt ? dropped - m_inputDropCnt : 0;
+
+        Statistics::reportMetric(m_instId, "input drops", "fps",
+                                 delta * 1000 / diff);
+        m_inputDropCnt  = dropped;
+        m_inputDropTime = now;
+    }
+}
+
+void InferencePipe::forwardThread()
+{
+    GstWrapperBuffer    cameraBuff;
+    TimePoint           prev_frame;
+    TimePoint           curr_frame;
+    bool                first_frame = true;
+    float               diff;
+    int32_t             status;
+
+    LOG_INFO("Starting forwarding thread.\n");
+
+    while (m_running)
+    {
+        ti::utils::startRec();
+
+        status = m_gstPipe->getBuffer(m_sensorSrc,
+                                      cameraBuff,
+                                      m_config.loop,
+                                      false);
+
+        if (status != 0)
+        {
+            if (status != EOS)
+            {
+                LOG_ERROR("Could not get 'post-processed' buffer from Gstreamer");
+            }
+            break;
+        }
+
+        if (m_config.dropLateFrames && !m_gstPipe->isSinkReady(m_sink))
+        {
+            m_lateCnt++;
+        }
+        else
+        {
+            status = m_gstPipe->putBuffer(m_sink, cameraBuff);
+
+            if (status != 0)
+            {
+                LOG_ERROR("Could not put 'post-processed' buffer to Gstreamer");
+                break;
+            }
+        }
+
+        m_gstPipe->freeBuffer(cameraBuff);
+
+        ti::utils::endRec();
+
+        if (!first_frame)
+        {
+            curr_frame = TI_EDGEAI_GET_TIME();
+            diff = TI_EDGEAI_GET_DIFF(prev_frame, curr_frame);
+            prev_frame = curr_frame;
+
+            Statistics::reportMetric(m_instId, "total time", "ms", diff);
+            Statistics::reportMetric(m_instId, "framerate", "fps", 1000/diff);
+
+            reportInputDrops();
+        }
+        else
+        {
+            prev_frame = TI_EDGEAI_GET_TIME();
+            first_frame = false;
+        }
+    }
+
+    if (m_lateCnt > 0)
+    {
+        LOG_INFO("Dropped %ld frames the output was too slow for.\n",
+                 m_lateCnt);
+    }
+
+    /* Send EOS to gst sink element*/
+    m_gstPipe->sendEOS(m_sink);
+
+    LOG_INFO("Exiting forwarding thread.\n");
+}
+
 /** Destructor. */
 InferencePipe::~InferencePipe()
 {
     LOG_DEBUG("DESTRUCTOR\n");
+    delete m_capture;
+    delete m_motionDetector;
+    delete m_publisher;
     DeleteVec(m_inferInputBuff);
     DeleteVec(m_inferOutputBuff);
+    DeleteVec(m_spareOutputBuff);
 }
 
 void InferencePipeConfig::dumpInfo() const
@@ -358,6 +861,18 @@ void InferencePipeConfig::dumpInfo() const
     LOG_INFO("InferencePipeConfig::inDataHeight   = %d\n", inDataHeight);
     LOG_INFO("InferencePipeConfig::frameRate      = %s\n", frameRate.c_str());
     LOG_INFO("InferencePipeConfig::zeroCopyEnable = %d\n", zeroCopyEnable);
+    LOG_INFO("InferencePipeConfig::captureFile    = %s\n", captureFile.c_str());
+    LOG_INFO("InferencePipeConfig::priority       = %d\n", priority);
+    LOG_INFO("InferencePipeConfig::targetFps      = %f\n", targetFps);
+    LOG_INFO("InferencePipeConfig::everyNthFrame  = %d\n", everyNthFrame);
+    LOG_INFO("InferencePipeConfig::preProcInterval= %d\n", preProcInterval);
+    LOG_INFO("InferencePipeConfig::motionThreshold= %f\n", motionThreshold);
+    LOG_INFO("InferencePipeConfig::motionRefresh  = %d\n", motionRefresh);
+    LOG_INFO("InferencePipeConfig::inPipeline     = %d\n", inPipeline);
+    LOG_INFO("InferencePipeConfig::postProcElement= %d\n", postProcElement != nullptr);
+    LOG_INFO("InferencePipeConfig::resultSocket   = %s\n", resultSocket.c_str());
+    LOG_INFO("InferencePipeConfig::metadataOnly   = %d\n", metadataOnly);
+    LOG_INFO("InferencePipeConfig::dropLateFrames = %d\n", dropLateFrames);
 }
 
 } // namespace ti::edgeai::common
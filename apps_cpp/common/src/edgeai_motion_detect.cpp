@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <algorithm>
+#include <cstdlib>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_motion_detect.h>
+
+/* Maximum number of pixels averaged along each side of a grid cell. */
+#define MOTION_BLOCK_SIZE   (4)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+MotionDetector::MotionDetector(const MotionDetectConfig &config):
+    m_config(config)
+{
+    m_config.gridWidth  = max(m_config.gridWidth, 1);
+    m_config.gridHeight = max(m_config.gridHeight, 1);
+    m_current.resize(m_config.gridWidth * m_config.gridHeight);
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+bool MotionDetector::isChanged(const uint8_t   *frame,
+                               int32_t          width,
+                               int32_t          height,
+                               int32_t          stride)
+{
+    int32_t gw = min(m_config.gridWidth, width);
+    int32_t gh = min(m_config.gridHeight, height);
+    int32_t bw = clamp(width / gw, 1, MOTION_BLOCK_SIZE);
+    int32_t bh = clamp(height / gh, 1, MOTION_BLOCK_SIZE);
+    int64_t sad = 0;
+    bool    changed;
+
+    if (stride < width * 3)
+    {
+        stride = width * 3;
+    }
+
+    m_current.resize(gw * gh);
+
+    /* A small block is averaged per cell so that noise on single pixels
+     * does not look like motion.
+     */
+    for (int32_t y = 0; y < gh; y++)
+    {
+        const uint8_t *row = frame + static_cast<int64_t>((y * height) / gh) * stride;
+
+        for (int32_t x = 0; x < gw; x++)
+        {
+            const uint8_t  *block = row + ((x * width) / gw) * 3;
+            int32_t         sum = 0;
+
+            for (int32_t by = 0; by < bh; by++)
+            {
+                const uint8_t *p = block + by * stride;
+
+                for (int32_t bx = 0; bx < bw; bx++, p += 3)
+                {
+                    /* BT.601 luma, integer approximation. */
+                    sum += 77 * p[0] + 150 * p[1] + 29 * p[2];
+                }
+            }
+
+            m_current[y * gw + x] = (sum / (bw * bh)) >> 8;
+        }
+    }
+
+    if (m_reference.size() != m_current.size())
+    {
+        changed = true;
+    }
+    else if (++m_unchangedCnt >= m_config.refreshInterval)
+    {
+        changed = true;
+    }
+    else
+    {
+        for (uint64_t i = 0; i < m_current.size(); i++)
+        {
+            sad += abs(m_current[i] - m_reference[i]);
+        }
+
+        changed = static_cast<float>(sad) / m_current.size() > m_config.threshold;
+    }
+
+    return changed;
+}
+
+void MotionDetector::updateReference()
+{
+    m_reference.swap(m_current);
+    m_unchangedCnt = 0;
+}
+
+MotionDetector::~MotionDetector()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+}
+
+} // namespace ti::edgeai::common
+
@@ -0,0 +1,358 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <algorithm>
+#include <limits>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_object_tracker.h>
+
+/* Noise of the Kalman filters, relative to the box height. */
+#define TRACKER_STD_WEIGHT_POS      (1.0f/20)
+#define TRACKER_STD_WEIGHT_VEL      (1.0f/160)
+
+/* Maximum number of detections per frame, relative to maxTracks. */
+#define TRACKER_DETECTIONS_FACTOR   (4)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+static float boxIou(const float *a,
+                    const float *b)
+{
+    float w = min(a[2], b[2]) - max(a[0], b[0]);
+    float h = min(a[3], b[3]) - max(a[1], b[1]);
+    float inter;
+    float uni;
+
+    if (w <= 0 || h <= 0)
+    {
+        return 0.0f;
+    }
+
+    inter = w * h;
+    uni   = (a[2] - a[0]) * (a[3] - a[1]) +
+            (b[2] - b[0]) * (b[3] - b[1]) - inter;
+
+    return uni > 0 ? inter / uni : 0.0f;
+}
+
+static void axisInit(TrackerAxis   &axis,
+                     float          pos,
+                     float          height)
+{
+    float stdPos = 2 * TRACKER_STD_WEIGHT_POS * height;
+    float stdVel = 10 * TRACKER_STD_WEIGHT_VEL * height;
+
+    axis.pos = pos;
+    axis.vel = 0.0f;
+    axis.p00 = stdPos * stdPos;
+    axis.p01 = 0.0f;
+    axis.p11 = stdVel * stdVel;
+}
+
+/* The process noise grows linearly with the number of frames. */
+static void axisPredict(TrackerAxis    &axis,
+                        float           height,
+                        float           dt)
+{
+    float stdPos = TRACKER_STD_WEIGHT_POS * height;
+    float stdVel = TRACKER_STD_WEIGHT_VEL * height;
+
+    axis.pos += axis.vel * dt;
+    axis.p00 += (2 * axis.p01 + axis.p11 * dt) * dt + stdPos * stdPos * dt;
+    axis.p01 += axis.p11 * dt;
+    axis.p11 += stdVel * stdVel * dt;
+}
+
+static void axisCorrect(TrackerAxis    &axis,
+                        float           pos,
+                        float           height)
+{
+    float stdPos = TRACKER_STD_WEIGHT_POS * height;
+    float s      = axis.p00 + stdPos * stdPos;
+    float k0     = axis.p00 / s;
+    float k1     = axis.p01 / s;
+    float y      = pos - axis.pos;
+
+    axis.pos += k0 * y;
+    axis.vel += k1 * y;
+    axis.p11 -= k1 * axis.p01;
+    axis.p00 *= 1 - k0;
+    axis.p01 *= 1 - k0;
+}
+
+static void trackSetBox(Track &track)
+{
+    float w = max(track.axis[2].pos, 1.0f);
+    float h = max(track.axis[3].pos, 1.0f);
+
+    track.box[0] = track.axis[0].pos - w / 2;
+    track.box[1] = track.axis[1].pos - h / 2;
+    track.box[2] = track.axis[0].pos + w / 2;
+    track.box[3] = track.axis[1].pos + h / 2;
+}
+
+void TrackerConfig::dumpInfo() const
+{
+    LOG_INFO_RAW("\n");
+    LOG_INFO("TrackerConfig::iouThreshold = %f\n", iouThreshold);
+    LOG_INFO("TrackerConfig::highScore    = %f\n", highScore);
+    LOG_INFO("TrackerConfig::lowScore     = %f\n", lowScore);
+    LOG_INFO("TrackerConfig::maxAge       = %d\n", maxAge);
+    LOG_INFO("TrackerConfig::minHits      = %d\n", minHits);
+    LOG_INFO("TrackerConfig::maxTracks    = %d\n", maxTracks);
+    LOG_INFO_RAW("\n");
+}
+
+ObjectTracker::ObjectTracker(const TrackerConfig &config):
+    m_config(config)
+{
+    int32_t maxDets;
+
+    m_config.maxTracks = max(m_config.maxTracks, 1);
+    m_config.lowScore  = min(m_config.lowScore, m_config.highScore);
+    maxDets = TRACKER_DETECTIONS_FACTOR * m_config.maxTracks;
+
+    m_tracks.resize(m_config.maxTracks);
+    m_trackMatched.resize(m_config.maxTracks);
+    m_detections.reserve(maxDets);
+    m_detMatched.reserve(maxDets);
+    /* Every track may overlap every detection. */
+    m_candidates.reserve(m_config.maxTracks * maxDets);
+
+    for (auto &t : m_tracks)
+    {
+        t.active  = false;
+        t.visible = false;
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+void ObjectTracker::clearDetections()
+{
+    m_detections.clear();
+}
+
+void ObjectTracker::addDetection(const TrackerDetection &det)
+{
+    /* Stay within the storage allocated up front. */
+    if (det.score >= m_config.lowScore &&
+        m_detections.size() < m_detections.capacity())
+    {
+        m_detections.push_back(det);
+    }
+}
+
+void ObjectTracker::advance(int32_t numFrames)
+{
+    for (auto &t : m_tracks)
+    {
+        if (!t.active)
+        {
+            continue;
+        }
+
+        t.age += numFrames;
+
+        if (t.age > m_config.maxAge)
+        {
+            t.active  = false;
+            t.visible = false;
+            continue;
+        }
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            axisPredict(t.axis[i], t.axis[3].pos, numFrames);
+        }
+
+        trackSetBox(t);
+    }
+}
+
+void ObjectTracker::associate(float     minScore,
+                              float     maxScore)
+{
+    m_candidates.clear();
+
+    for (uint64_t i = 0; i < m_tracks.size(); i++)
+    {
+        const Track &t = m_tracks[i];
+
+        if (!t.active || m_trackMatched[i])
+        {
+            continue;
+        }
+
+        for (uint64_t j = 0; j < m_detections.size(); j++)
+        {
+            const TrackerDetection &d = m_detections[j];
+
+            if (m_detMatched[j] || d.classId != t.classId ||
+                d.score < minScore || d.score >= maxScore)
+            {
+                continue;
+            }
+
+            float iou = boxIou(t.box, d.box);
+
+            if (iou >= m_config.iouThreshold)
+            {
+                m_candidates.push_back({iou, {i, j}});
+            }
+        }
+    }
+
+    /* Greedy association, best overlap first. */
+    sort(m_candidates.begin(), m_candidates.end(),
+         [](const auto &a, const auto &b) { return a.first > b.first; });
+
+    for (const auto &c : m_candidates)
+    {
+        int32_t ti = c.second.first;
+        int32_t di = c.second.second;
+
+        if (m_trackMatched[ti] || m_detMatched[di])
+        {
+            continue;
+        }
+
+        Track                  &t = m_tracks[ti];
+        const TrackerDetection &d = m_detections[di];
+        float                   h = d.box[3] - d.box[1];
+
+        axisCorrect(t.axis[0], (d.box[0] + d.box[2]) / 2, h);
+        axisCorrect(t.axis[1], (d.box[1] + d.box[3]) / 2, h);
+        axisCorrect(t.axis[2], d.box[2] - d.box[0], h);
+        axisCorrect(t.axis[3], h, h);
+        trackSetBox(t);
+
+        t.score  = d.score;
+        t.hits++;
+        t.age    = 0;
+        t.missed = false;
+
+        m_trackMatched[ti] = true;
+        m_detMatched[di]   = true;
+    }
+}
+
+void ObjectTracker::startTrack(const TrackerDetection &det)
+{
+    float w = det.box[2] - det.box[0];
+    float h = det.box[3] - det.box[1];
+
+    for (auto &t : m_tracks)
+    {
+        if (t.active)
+        {
+            continue;
+        }
+
+        t.id      = m_nextId++;
+        t.classId = det.classId;
+        t.score   = det.score;
+        t.hits    = 1;
+        t.age     = 0;
+        t.missed  = false;
+        t.active  = true;
+        t.visible = t.hits >= m_config.minHits;
+
+        axisInit(t.axis[0], det.box[0] + w / 2, h);
+        axisInit(t.axis[1], det.box[1] + h / 2, h);
+        axisInit(t.axis[2], w, h);
+        axisInit(t.axis[3], h, h);
+        trackSetBox(t);
+
+        return;
+    }
+
+    /* All the slots are in use, the detection is not tracked. */
+}
+
+void ObjectTracker::update(int32_t numFrames)
+{
+    advance(numFrames);
+
+    m_detMatched.assign(m_detections.size(), false);
+    fill(m_trackMatched.begin(), m_trackMatched.end(), false);
+
+    /* High scoring detections first, then the weak ones can only extend
+     * the remaining tracks.
+     */
+    associate(m_config.highScore, numeric_limits<float>::max());
+    associate(m_config.lowScore, m_config.highScore);
+
+    for (uint64_t i = 0; i < m_tracks.size(); i++)
+    {
+        Track &t = m_tracks[i];
+
+        if (!t.active)
+        {
+            continue;
+        }
+
+        t.missed  = !m_trackMatched[i];
+        t.visible = !t.missed && t.hits >= m_config.minHits;
+    }
+
+    for (uint64_t j = 0; j < m_detections.size(); j++)
+    {
+        const TrackerDetection &d = m_detections[j];
+
+        if (!m_detMatched[j] && d.score >= m_config.highScore)
+        {
+            startTrack(d);
+        }
+    }
+}
+
+void ObjectTracker::predict(int32_t numFrames)
+{
+    /* The tracks missed on the last detections stay hidden until they
+     * are associated again.
+     */
+    advance(numFrames);
+}
+
+ObjectTracker::~ObjectTracker()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+}
+
+} // namespace ti::edgeai::common
+
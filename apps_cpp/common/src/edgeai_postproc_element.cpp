@@ -0,0 +1,261 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <chrono>
+
+/* Third-party headers. */
+#include <gst/base/gstbasetransform.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <utils/include/ti_stl_helpers.h>
+#include <common/include/edgeai_utils.h>
+#include <common/include/edgeai_postproc_element.h>
+
+#define POSTPROC_ELEMENT_FACTORY "edgeaipostproc"
+
+#define TI_EDGEAI_GET_TIME() chrono::system_clock::now()
+
+#define TI_EDGEAI_GET_DIFF(_START, _END) \
+chrono::duration<float, std::milli>(_END - _START).count()
+
+using namespace ti::edgeai::common;
+
+/** Instance of the element. */
+typedef struct
+{
+    /** Parent instance. */
+    GstBaseTransform    parent;
+
+    /** Post-processing context, set after creation. */
+    PostprocElement    *ctx;
+
+} GstEdgeaiPostproc;
+
+/** Class of the element. */
+typedef struct
+{
+    /** Parent class. */
+    GstBaseTransformClass   parent_class;
+
+} GstEdgeaiPostprocClass;
+
+G_DEFINE_TYPE(GstEdgeaiPostproc, gst_edgeai_postproc, GST_TYPE_BASE_TRANSFORM);
+
+static GstStaticPadTemplate gSinkTemplate =
+    GST_STATIC_PAD_TEMPLATE("sink",
+                            GST_PAD_SINK,
+                            GST_PAD_ALWAYS,
+                            GST_STATIC_CAPS("video/x-raw, format=RGB"));
+
+static GstStaticPadTemplate gSrcTemplate =
+    GST_STATIC_PAD_TEMPLATE("src",
+                            GST_PAD_SRC,
+                            GST_PAD_ALWAYS,
+                            GST_STATIC_CAPS("video/x-raw, format=RGB"));
+
+static GstFlowReturn gst_edgeai_postproc_transform_ip(GstBaseTransform *trans,
+                                                      GstBuffer        *buf)
+{
+    GstEdgeaiPostproc  *self = reinterpret_cast<GstEdgeaiPostproc*>(trans);
+
+    if (self->ctx == nullptr)
+    {
+        return GST_FLOW_OK;
+    }
+
+    return self->ctx->process(buf) < 0 ? GST_FLOW_ERROR : GST_FLOW_OK;
+}
+
+static void gst_edgeai_postproc_class_init(GstEdgeaiPostprocClass *klass)
+{
+    GstElementClass        *elementClass = GST_ELEMENT_CLASS(klass);
+    GstBaseTransformClass  *transClass = GST_BASE_TRANSFORM_CLASS(klass);
+
+    gst_element_class_set_static_metadata(elementClass,
+                                          "EdgeAI post-processing",
+                                          "Filter/Video",
+                                          "Draws the inference results on the frames",
+                                          "Texas Instruments");
+
+    gst_element_class_add_static_pad_template(elementClass, &gSinkTemplate);
+    gst_element_class_add_static_pad_template(elementClass, &gSrcTemplate);
+
+    transClass->transform_ip = gst_edgeai_postproc_transform_ip;
+}
+
+static void gst_edgeai_postproc_init(GstEdgeaiPostproc *self)
+{
+    self->ctx = nullptr;
+    gst_base_transform_set_in_place(&self->parent, TRUE);
+}
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+PostprocElement::PostprocElement(PostprocessImage  *postProcObj,
+                                 int32_t            width,
+                                 int32_t            height,
+                                 const string      &name):
+    m_postProcObj(postProcObj),
+    m_width(width),
+    m_height(height)
+{
+    if (registerElement() < 0)
+    {
+        throw runtime_error("Failed to register the post-processing element.");
+    }
+
+    m_element = gst_element_factory_make(POSTPROC_ELEMENT_FACTORY, name.c_str());
+
+    if (m_element == nullptr)
+    {
+        throw runtime_error("Failed to create the post-processing element.");
+    }
+
+    /* Keep a reference so that the element cannot outlive the context. */
+    gst_object_ref_sink(m_element);
+    reinterpret_cast<GstEdgeaiPostproc*>(m_element)->ctx = this;
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+GstElement *PostprocElement::getElement()
+{
+    return m_element;
+}
+
+void PostprocElement::setStatsKey(int32_t instId)
+{
+    m_statsKey = instId;
+}
+
+void PostprocElement::setPublisher(ResultPublisher *publisher)
+{
+    m_publisher = publisher;
+}
+
+void PostprocElement::setExportResults(bool exportResults)
+{
+    m_exportResults = exportResults;
+}
+
+void PostprocElement::exchangeResults(VecDlTensorPtr &results)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    m_results.swap(results);
+    m_updated = true;
+}
+
+int32_t PostprocElement::process(GstBuffer *buffer)
+{
+    GstMapInfo  map;
+    uint64_t    frameId = m_frameCnt++;
+
+    lock_guard<mutex> lock(m_mutex);
+
+    /* Nothing to draw until the first inference completes. */
+    if (m_results.empty())
+    {
+        return 0;
+    }
+
+    if (!gst_buffer_map(buffer, &map, GST_MAP_READWRITE))
+    {
+        LOG_ERROR("Failed to map the frame for post-processing.\n");
+        return -1;
+    }
+
+    if (map.size < static_cast<size_t>(m_width) * m_height * 3)
+    {
+        LOG_ERROR("Frame of %ld bytes is smaller than %dx%d RGB.\n",
+                  map.size, m_width, m_height);
+        gst_buffer_unmap(buffer, &map);
+        return -1;
+    }
+
+    auto start = TI_EDGEAI_GET_TIME();
+
+    m_postProcObj->setResultsUpdated(m_updated);
+    m_postProcObj->setFrameIndex(frameId);
+    (*m_postProcObj)(map.data, m_results);
+    m_updated = false;
+
+    auto end = TI_EDGEAI_GET_TIME();
+
+    gst_buffer_unmap(buffer, &map);
+
+    auto result = m_postProcObj->getResult();
+
+    if (m_exportResults && addResultMeta(buffer, result) < 0)
+    {
+        LOG_ERROR("addResultMeta() failed.\n");
+    }
+
+    if (m_publisher)
+    {
+        m_publisher->publish(*result, m_statsKey, frameId, GST_BUFFER_PTS(buffer));
+    }
+
+    if (m_statsKey >= 0)
+    {
+        float diff = TI_EDGEAI_GET_DIFF(start, end);
+        Statistics::reportProcTime(m_statsKey, "post-process", diff);
+    }
+
+    return 0;
+}
+
+int32_t PostprocElement::registerElement()
+{
+    static const gboolean registered =
+        gst_element_register(nullptr,
+                             POSTPROC_ELEMENT_FACTORY,
+                             GST_RANK_NONE,
+                             gst_edgeai_postproc_get_type());
+
+    return registered ? 0 : -1;
+}
+
+PostprocElement::~PostprocElement()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    reinterpret_cast<GstEdgeaiPostproc*>(m_element)->ctx = nullptr;
+    gst_object_unref(m_element);
+    DeleteVec(m_results);
+}
+
+} // namespace ti::edgeai::common
@@ -0,0 +1,513 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* Standard headers. */
+#include <filesystem>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Third-party headers. */
+#include <gst/app/gstappsink.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_gst_helper.h>
+#include <common/include/edgeai_preload_source.h>
+
+#define PRELOAD_CACHE_MAGIC         "EAIPRELD"
+#define PRELOAD_CACHE_VERSION       (1)
+#define PRELOAD_CACHE_DATA_OFFSET   (4096)
+#define PRELOAD_DECODE_TIMEOUT      (5 * GST_SECOND)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+/* Header at the start of the raw cache file. The frames follow at
+ * PRELOAD_CACHE_DATA_OFFSET so that they start page aligned.
+ */
+struct PreloadCacheHeader
+{
+    char        magic[8];
+    uint32_t    version;
+    int32_t     width;
+    int32_t     height;
+    int32_t     index;
+    uint32_t    numFrames;
+    uint32_t    reserved;
+    uint64_t    frameSize;
+    char        location[1024];
+};
+
+static_assert(sizeof(PreloadCacheHeader) <= PRELOAD_CACHE_DATA_OFFSET,
+              "Cache header does not fit in front of the frame data.");
+
+PreloadedImageSource::PreloadedImageSource(const string    &location,
+                                           int32_t          index,
+                                           int32_t          width,
+                                           int32_t          height,
+                                           const string    &framerate,
+                                           bool             loop,
+                                           const string    &cacheFile):
+    m_location(location),
+    m_index(index),
+    m_width(width),
+    m_height(height),
+    m_loop(loop),
+    m_cacheFile(cacheFile)
+{
+    if (sscanf(framerate.c_str(), "%d/%d", &m_fpsN, &m_fpsD) != 2 ||
+        m_fpsD <= 0)
+    {
+        LOG_ERROR("Invalid framerate %s.\n", framerate.c_str());
+        throw runtime_error("PreloadedImageSource object creation failed.");
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+int32_t PreloadedImageSource::load()
+{
+    int32_t status = -1;
+
+    if (!m_cacheFile.empty())
+    {
+        status = mapCache();
+
+        if (status == 0)
+        {
+            LOG_INFO("Mapped %d pre-decoded frames from %s\n",
+                     m_numFrames, m_cacheFile.c_str());
+        }
+    }
+
+    if (status < 0)
+    {
+        status = decode();
+
+        if (status == 0)
+        {
+            LOG_INFO("Decoded %d frames from %s (%zu bytes)\n",
+                     m_numFrames, m_location.c_str(),
+                     m_numFrames * m_frameSize);
+        }
+    }
+
+    if (status == 0 && !m_cacheFile.empty() && !m_mapped)
+    {
+        /* Failing to write the cache only costs a decode in the next run. */
+        if (writeCache() < 0)
+        {
+            LOG_WARN("Could not write the cache file %s.\n",
+                     m_cacheFile.c_str());
+        }
+    }
+
+    if (status == 0)
+    {
+        wrapFrames();
+    }
+
+    return status;
+}
+
+int32_t PreloadedImageSource::mapCache()
+{
+    PreloadCacheHeader  hdr;
+    struct stat         st;
+    int                 fd;
+    int32_t             status = 0;
+
+    fd = open(m_cacheFile.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    if (read(fd, &hdr, sizeof(hdr)) != sizeof(hdr) || fstat(fd, &st) < 0)
+    {
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        hdr.location[sizeof(hdr.location) - 1] = '\0';
+
+        if (memcmp(hdr.magic, PRELOAD_CACHE_MAGIC, sizeof(hdr.magic)) ||
+            hdr.version != PRELOAD_CACHE_VERSION ||
+            hdr.width != m_width ||
+            hdr.height != m_height ||
+            hdr.index != m_index ||
+            hdr.numFrames == 0 ||
+            hdr.frameSize == 0 ||
+            m_location != hdr.location)
+        {
+            LOG_INFO("Cache file %s does not match the input, ignoring it.\n",
+                     m_cacheFile.c_str());
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        m_dataSize = PRELOAD_CACHE_DATA_OFFSET + hdr.numFrames * hdr.frameSize;
+
+        if (static_cast<size_t>(st.st_size) < m_dataSize)
+        {
+            LOG_WARN("Cache file %s is truncated, ignoring it.\n",
+                     m_cacheFile.c_str());
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        void *addr = mmap(nullptr, m_dataSize, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (addr == MAP_FAILED)
+        {
+            LOG_ERROR("mmap() failed for %s.\n", m_cacheFile.c_str());
+            status = -1;
+        }
+        else
+        {
+            m_data       = static_cast<uint8_t *>(addr);
+            m_dataOffset = PRELOAD_CACHE_DATA_OFFSET;
+            m_frameSize  = hdr.frameSize;
+            m_numFrames  = hdr.numFrames;
+            m_mapped     = true;
+        }
+    }
+
+    close(fd);
+
+    return status;
+}
+
+int32_t PreloadedImageSource::decode()
+{
+    vector<GstElement *>            elements;
+    vector<vector<const gchar*>>    props;
+    GstElement                     *pipeline;
+    GstElement                     *appsink;
+    GstSample                      *sample;
+    string                          ext;
+    string                          srcCaps;
+    string                          outCaps;
+    string                          indexStr;
+    string                          stopIndexStr;
+    uint32_t                        numFiles = 0;
+    int32_t                         status = 0;
+
+    ext = filesystem::path(m_location).extension();
+
+    /* Count the files up front so that the frames can be decoded straight
+     * into a region of the final size. multifilesrc stops at the first
+     * missing file as well.
+     */
+    if (m_location.find('%') != string::npos)
+    {
+        char path[2048];
+
+        indexStr     = to_string(m_index);
+        stopIndexStr = "-1";
+
+        while (true)
+        {
+            snprintf(path, sizeof(path), m_location.c_str(), m_index + numFiles);
+
+            if (!filesystem::exists(path))
+            {
+                break;
+            }
+
+            numFiles++;
+        }
+    }
+    else
+    {
+        indexStr     = "0";
+        stopIndexStr = "0";
+        numFiles     = filesystem::exists(m_location) ? 1 : 0;
+    }
+
+    if (numFiles == 0)
+    {
+        LOG_ERROR("No images found at %s.\n", m_location.c_str());
+        return -1;
+    }
+
+    srcCaps = (ext == ".png" ? "image/png" : "image/jpeg");
+    srcCaps += ",framerate=1/1";
+    outCaps = "video/x-raw, format=" PRELOAD_SOURCE_FORMAT ", width=" +
+              to_string(m_width) + ", height=" + to_string(m_height);
+
+    /* The decode runs once, so the stock elements are good enough here. */
+    props = {{"location",m_location.c_str()},
+             {"index",indexStr.c_str()},
+             {"stop-index",stopIndexStr.c_str()},
+             {"caps",srcCaps.c_str()}};
+    makeElement(elements, "multifilesrc", props, NULL);
+    makeElement(elements, ext == ".png" ? "pngdec" : "jpegdec", props, NULL);
+    makeElement(elements, "videoscale", props, NULL);
+    makeElement(elements, "videoconvert", props, outCaps.c_str());
+
+    props = {{"sync","false"},
+             {"max-buffers","4"}};
+    makeElement(elements, "appsink", props, NULL);
+
+    appsink  = elements.back();
+    pipeline = gst_pipeline_new(NULL);
+    addAndLink(pipeline, elements);
+
+    if (gst_element_set_state(pipeline, GST_STATE_PLAYING) ==
+        GST_STATE_CHANGE_FAILURE)
+    {
+        LOG_ERROR("Failed to start the decode pipeline.\n");
+        status = -1;
+    }
+
+    while (status == 0 && m_numFrames < numFiles)
+    {
+        GstBuffer  *buffer;
+        GstMapInfo  mapinfo;
+
+        sample = gst_app_sink_try_pull_sample(GST_APP_SINK(appsink),
+                                              PRELOAD_DECODE_TIMEOUT);
+
+        if (sample == nullptr)
+        {
+            /* EOS or a decode error. Keep whatever was decoded so far. */
+            break;
+        }
+
+        buffer = gst_sample_get_buffer(sample);
+
+        if (m_data == nullptr)
+        {
+            void   *addr;
+
+            m_frameSize = gst_buffer_get_size(buffer);
+            m_dataSize  = numFiles * m_frameSize;
+
+            addr = mmap(nullptr, m_dataSize, PROT_READ | PROT_WRITE,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+            if (addr == MAP_FAILED)
+            {
+                LOG_ERROR("Failed to allocate %zu bytes for %d frames.\n",
+                          m_dataSize, numFiles);
+                status = -1;
+            }
+            else
+            {
+                m_data = static_cast<uint8_t *>(addr);
+            }
+        }
+
+        if (status == 0 && gst_buffer_get_size(buffer) != m_frameSize)
+        {
+            LOG_ERROR("Decoded frame size changed.\n");
+            status = -1;
+        }
+
+        if (status == 0 && gst_buffer_map(buffer, &mapinfo, GST_MAP_READ))
+        {
+            memcpy(m_data + m_numFrames * m_frameSize, mapinfo.data, m_frameSize);
+            gst_buffer_unmap(buffer, &mapinfo);
+            m_numFrames++;
+        }
+
+        gst_sample_unref(sample);
+    }
+
+    gst_element_set_state(pipeline, GST_STATE_NULL);
+    gst_object_unref(pipeline);
+
+    if (status == 0 && m_numFrames == 0)
+    {
+        LOG_ERROR("Could not decode any frame from %s.\n", m_location.c_str());
+        status = -1;
+    }
+
+    return status;
+}
+
+int32_t PreloadedImageSource::writeCache()
+{
+    PreloadCacheHeader  hdr{};
+    string              tmpFile = m_cacheFile + ".tmp";
+    size_t              size = m_numFrames * m_frameSize;
+    FILE               *fp;
+    int32_t             status = 0;
+
+    memcpy(hdr.magic, PRELOAD_CACHE_MAGIC, sizeof(hdr.magic));
+    hdr.version   = PRELOAD_CACHE_VERSION;
+    hdr.width     = m_width;
+    hdr.height    = m_height;
+    hdr.index     = m_index;
+    hdr.numFrames = m_numFrames;
+    hdr.frameSize = m_frameSize;
+    strncpy(hdr.location, m_location.c_str(), sizeof(hdr.location) - 1);
+
+    /* Written to a temporary file and renamed, so that an interrupted run
+     * never leaves a partial cache file behind.
+     */
+    fp = fopen(tmpFile.c_str(), "wb");
+
+    if (fp == nullptr)
+    {
+        return -1;
+    }
+
+    if (fwrite(&hdr, sizeof(hdr), 1, fp) != 1 ||
+        fseek(fp, PRELOAD_CACHE_DATA_OFFSET, SEEK_SET) != 0 ||
+        fwrite(m_data + m_dataOffset, 1, size, fp) != size)
+    {
+        status = -1;
+    }
+
+    if (fclose(fp) != 0)
+    {
+        status = -1;
+    }
+
+    if (status == 0 && rename(tmpFile.c_str(), m_cacheFile.c_str()) != 0)
+    {
+        status = -1;
+    }
+
+    if (status < 0)
+    {
+        unlink(tmpFile.c_str());
+    }
+
+    return status;
+}
+
+void PreloadedImageSource::wrapFrames()
+{
+    for (uint32_t i = 0; i < m_numFrames; i++)
+    {
+        GstMemory  *mem;
+
+        mem = gst_memory_new_wrapped(GST_MEMORY_FLAG_READONLY,
+                                     m_data,
+                                     m_dataSize,
+                                     m_dataOffset + i * m_frameSize,
+                                     m_frameSize,
+                                     nullptr,
+                                     nullptr);
+        m_frames.push_back(mem);
+    }
+}
+
+void PreloadedImageSource::attach(GstElement *appsrc)
+{
+    GstAppSrcCallbacks  callbacks{};
+    GstCaps            *caps;
+
+    caps = gst_caps_new_simple("video/x-raw",
+                               "format", G_TYPE_STRING, PRELOAD_SOURCE_FORMAT,
+                               "width", G_TYPE_INT, m_width,
+                               "height", G_TYPE_INT, m_height,
+                               "framerate", GST_TYPE_FRACTION, m_fpsN, m_fpsD,
+                               NULL);
+
+    g_object_set(appsrc,
+                 "caps", caps,
+                 "format", GST_FORMAT_TIME,
+                 "max-bytes", static_cast<guint64>(2 * m_frameSize),
+                 NULL);
+    gst_caps_unref(caps);
+
+    callbacks.need_data = needData;
+    gst_app_src_set_callbacks(GST_APP_SRC(appsrc), &callbacks, this, NULL);
+}
+
+void PreloadedImageSource::needData(GstAppSrc *src,
+                                    guint      length,
+                                    gpointer   userData)
+{
+    auto       *self = static_cast<PreloadedImageSource *>(userData);
+    GstBuffer  *buffer;
+    uint32_t    idx;
+
+    (void)length;
+
+    if (!self->m_loop && self->m_pushCount >= self->m_numFrames)
+    {
+        gst_app_src_end_of_stream(src);
+        return;
+    }
+
+    idx    = self->m_pushCount % self->m_numFrames;
+    buffer = gst_buffer_new();
+    gst_buffer_append_memory(buffer, gst_memory_ref(self->m_frames[idx]));
+
+    /* Without a rate the buffers carry no timestamps and the sinks
+     * render them as soon as they arrive.
+     */
+    if (self->m_fpsN > 0)
+    {
+        GST_BUFFER_PTS(buffer) = gst_util_uint64_scale(self->m_pushCount,
+                                                       GST_SECOND * self->m_fpsD,
+                                                       self->m_fpsN);
+        GST_BUFFER_DURATION(buffer) = gst_util_uint64_scale(GST_SECOND,
+                                                            self->m_fpsD,
+                                                            self->m_fpsN);
+    }
+
+    self->m_pushCount++;
+
+    gst_app_src_push_buffer(src, buffer);
+}
+
+PreloadedImageSource::~PreloadedImageSource()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    for (auto &mem : m_frames)
+    {
+        gst_memory_unref(mem);
+    }
+
+    if (m_data != nullptr)
+    {
+        munmap(m_data, m_dataSize);
+    }
+}
+
+} // namespace ti::edgeai::common
@@ -0,0 +1,387 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* Standard headers. */
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <thread>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+/* Third-party headers. */
+#include <yaml-cpp/yaml.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_replay_inferer.h>
+
+#define REPLAY_INFERER_CONFIG_FILE  "replay.yaml"
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+static map<string, pair<DlInferType, int32_t>> gReplayTypeMap =
+{
+    {"int8",    {DlInferType_Int8,    1}},
+    {"uint8",   {DlInferType_UInt8,   1}},
+    {"int16",   {DlInferType_Int16,   2}},
+    {"uint16",  {DlInferType_UInt16,  2}},
+    {"int32",   {DlInferType_Int32,   4}},
+    {"uint32",  {DlInferType_UInt32,  4}},
+    {"int64",   {DlInferType_Int64,   8}},
+    {"float32", {DlInferType_Float32, 4}}
+};
+
+static int32_t parseTensorInfo(const YAML::Node &node, DlTensor &tensor)
+{
+    const string type = node["type"].as<string>();
+    const auto  &it = gReplayTypeMap.find(type);
+
+    if (it == gReplayTypeMap.end())
+    {
+        LOG_ERROR("Unsupported tensor type %s.\n", type.c_str());
+        return -1;
+    }
+
+    tensor.name     = node["name"].as<string>();
+    tensor.type     = it->second.first;
+    tensor.elemSize = it->second.second;
+    tensor.shape    = node["shape"].as<vector<int64_t>>();
+    tensor.dim      = tensor.shape.size();
+    tensor.numElem  = 1;
+
+    for (auto const &d : tensor.shape)
+    {
+        tensor.numElem *= d;
+    }
+
+    tensor.size = tensor.numElem * tensor.elemSize;
+
+    return 0;
+}
+
+ReplayInferer::ReplayInferer(const ReplayInfererConfig &config):
+    m_config(config),
+    m_rng(config.seed)
+{
+    YAML::Node  yaml;
+    string      cfgFile = m_config.path + "/" + REPLAY_INFERER_CONFIG_FILE;
+    int32_t     status = 0;
+
+    if (m_config.distribution != "fixed" &&
+        m_config.distribution != "uniform" &&
+        m_config.distribution != "normal" &&
+        m_config.distribution != "lognormal")
+    {
+        LOG_ERROR("Invalid latency distribution %s.\n",
+                  m_config.distribution.c_str());
+        status = -1;
+    }
+
+    if (status == 0 && filesystem::is_regular_file(m_config.path))
+    {
+        /* A tensor capture file recorded by InferencePipe. */
+        try
+        {
+            m_capture = new TensorCaptureReader(m_config.path);
+        }
+        catch (const runtime_error &e)
+        {
+            LOG_ERROR("%s\n", e.what());
+            status = -1;
+        }
+
+        if (status == 0)
+        {
+            m_inputInfo  = *m_capture->getInputInfo();
+            m_outputInfo = *m_capture->getOutputInfo();
+            m_numFrames  = m_capture->getNumRecords();
+
+            if (m_numFrames == 0)
+            {
+                LOG_ERROR("%s does not hold a single frame.\n",
+                          m_config.path.c_str());
+                status = -1;
+            }
+        }
+    }
+    else if (status == 0 && !filesystem::exists(cfgFile))
+    {
+        LOG_ERROR("Replay description %s does not exist.\n", cfgFile.c_str());
+        status = -1;
+    }
+
+    if (status == 0 && m_capture == nullptr)
+    {
+        yaml = YAML::LoadFile(cfgFile);
+
+        for (auto const &node : yaml["inputs"])
+        {
+            DlTensor    tensor;
+
+            status = parseTensorInfo(node, tensor);
+
+            if (status < 0)
+            {
+                break;
+            }
+
+            m_inputInfo.push_back(tensor);
+        }
+    }
+
+    if (status == 0 && m_capture == nullptr)
+    {
+        for (auto const &node : yaml["outputs"])
+        {
+            DlTensor    tensor;
+            string      file;
+            struct stat st;
+            void       *addr;
+            uint64_t    numFrames;
+            int         fd;
+
+            status = parseTensorInfo(node, tensor);
+
+            if (status < 0)
+            {
+                break;
+            }
+
+            file = m_config.path + "/" + node["file"].as<string>();
+            fd   = open(file.c_str(), O_RDONLY);
+
+            if (fd < 0 || fstat(fd, &st) < 0)
+            {
+                LOG_ERROR("Could not open %s.\n", file.c_str());
+                status = -1;
+                break;
+            }
+
+            numFrames = st.st_size / tensor.size;
+
+            if (numFrames == 0)
+            {
+                LOG_ERROR("%s does not hold a single frame.\n", file.c_str());
+                close(fd);
+                status = -1;
+                break;
+            }
+
+            addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            close(fd);
+
+            if (addr == MAP_FAILED)
+            {
+                LOG_ERROR("mmap() failed for %s.\n", file.c_str());
+                status = -1;
+                break;
+            }
+
+            /* The recordings are read sequentially and in full on every
+             * pass, so ask the kernel to read ahead.
+             */
+            madvise(addr, st.st_size, MADV_SEQUENTIAL);
+
+            m_outputData.push_back(static_cast<uint8_t *>(addr));
+            m_outputDataSize.push_back(st.st_size);
+            m_outputInfo.push_back(tensor);
+
+            /* Outputs recorded with different frame counts replay the
+             * common part only.
+             */
+            if (m_numFrames == 0 || numFrames < m_numFrames)
+            {
+                m_numFrames = numFrames;
+            }
+        }
+    }
+
+    if (status == 0 && (m_inputInfo.empty() || m_outputInfo.empty()))
+    {
+        LOG_ERROR("%s must describe at least one input and one output.\n",
+                  cfgFile.c_str());
+        status = -1;
+    }
+
+    if (status < 0)
+    {
+        for (uint64_t i = 0; i < m_outputData.size(); i++)
+        {
+            munmap(m_outputData[i], m_outputDataSize[i]);
+        }
+
+        delete m_capture;
+
+        throw runtime_error("ReplayInferer object creation failed.");
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+int64_t ReplayInferer::sampleLatency()
+{
+    const double    mean = m_config.latency;
+    const double    jitter = m_config.jitter;
+    double          latency = mean;
+
+    if (jitter > 0 && mean > 0)
+    {
+        std::unique_lock<std::mutex> lock(m_rngMutex);
+
+        if (m_config.distribution == "uniform")
+        {
+            uniform_real_distribution<double> dist(mean - jitter, mean + jitter);
+            latency = dist(m_rng);
+        }
+        else if (m_config.distribution == "normal")
+        {
+            normal_distribution<double> dist(mean, jitter);
+            latency = dist(m_rng);
+        }
+        else if (m_config.distribution == "lognormal")
+        {
+            /* Pick the parameters so that the samples have the requested
+             * mean and standard deviation. This gives the long right tail
+             * seen on real accelerators.
+             */
+            double sigma2 = log(1.0 + (jitter * jitter) / (mean * mean));
+            lognormal_distribution<double> dist(log(mean) - sigma2/2,
+                                                sqrt(sigma2));
+            latency = dist(m_rng);
+        }
+    }
+
+    return latency > 0 ? static_cast<int64_t>(latency * 1000) : 0;
+}
+
+int32_t ReplayInferer::run(const VecDlTensorPtr   &inputs,
+                           VecDlTensorPtr         &outputs)
+{
+    auto        start = chrono::steady_clock::now();
+    uint64_t    frame = m_runCount++ % m_numFrames;
+
+    /* The outputs do not depend on the inputs. */
+    (void)inputs;
+
+    if (outputs.size() != m_outputInfo.size())
+    {
+        LOG_ERROR("Expected %ld outputs, got %ld.\n",
+                  m_outputInfo.size(), outputs.size());
+        return -1;
+    }
+
+    for (uint64_t i = 0; i < m_outputInfo.size(); i++)
+    {
+        const int64_t   size = m_outputInfo[i].size;
+        const uint8_t  *src;
+
+        if (m_capture)
+        {
+            src = m_capture->getOutputData(frame, i);
+        }
+        else
+        {
+            src = m_outputData[i] + frame * size;
+        }
+
+        memcpy(outputs[i]->data, src, size);
+    }
+
+    /* The copy counts towards the latency, like the output transfer of a
+     * real backend would.
+     */
+    this_thread::sleep_until(start + chrono::microseconds(sampleLatency()));
+
+    return 0;
+}
+
+void ReplayInferer::dumpInfo()
+{
+    LOG_INFO("ReplayInferer::path        = %s\n", m_config.path.c_str());
+    LOG_INFO("ReplayInferer::numFrames   = %ld\n", m_numFrames);
+
+    for (auto const &t : m_inputInfo)
+    {
+        LOG_INFO("ReplayInferer::input       = %s (%ld bytes)\n",
+                 t.name.c_str(), t.size);
+    }
+
+    for (auto const &t : m_outputInfo)
+    {
+        LOG_INFO("ReplayInferer::output      = %s (%ld bytes)\n",
+                 t.name.c_str(), t.size);
+    }
+
+    m_config.dumpInfo("ReplayInferer::");
+}
+
+const VecDlTensor *ReplayInferer::getInputInfo()
+{
+    return &m_inputInfo;
+}
+
+const VecDlTensor *ReplayInferer::getOutputInfo()
+{
+    return &m_outputInfo;
+}
+
+void *ReplayInferer::allocate(int64_t size)
+{
+    return malloc(size);
+}
+
+ReplayInferer::~ReplayInferer()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    delete m_capture;
+
+    for (uint64_t i = 0; i < m_outputData.size(); i++)
+    {
+        munmap(m_outputData[i], m_outputDataSize[i]);
+    }
+}
+
+void ReplayInfererConfig::dumpInfo(const char *prefix) const
+{
+    LOG_INFO("%sReplayInfererConfig::path         = %s\n", prefix, path.c_str());
+    LOG_INFO("%sReplayInfererConfig::latency      = %f\n", prefix, latency);
+    LOG_INFO("%sReplayInfererConfig::jitter       = %f\n", prefix, jitter);
+    LOG_INFO("%sReplayInfererConfig::distribution = %s\n", prefix, distribution.c_str());
+}
+
+} // namespace ti::edgeai::common
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <algorithm>
+#include <stdexcept>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_replicated_inferer.h>
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+ReplicatedInferer::ReplicatedInferer(const vector<DLInferer*> &replicas):
+    m_replicas(replicas)
+{
+    if (m_replicas.empty())
+    {
+        throw runtime_error("No model replicas given.");
+    }
+
+    m_pending.assign(m_replicas.size(), 0);
+
+    for (uint64_t i = 0; i < m_replicas.size(); i++)
+    {
+        m_runMutex.push_back(make_unique<mutex>());
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+int32_t ReplicatedInferer::run(const VecDlTensorPtr &inputs,
+                               VecDlTensorPtr       &outputs)
+{
+    uint64_t    idx;
+    int32_t     status;
+
+    {
+        lock_guard<mutex>   lock(m_mutex);
+
+        idx = min_element(m_pending.begin(), m_pending.end()) -
+              m_pending.begin();
+        m_pending[idx]++;
+    }
+
+    {
+        lock_guard<mutex>   lock(*m_runMutex[idx]);
+
+        status = m_replicas[idx]->run(inputs, outputs);
+    }
+
+    {
+        lock_guard<mutex>   lock(m_mutex);
+
+        m_pending[idx]--;
+    }
+
+    return status;
+}
+
+void ReplicatedInferer::dumpInfo()
+{
+    LOG_INFO("ReplicatedInferer::replicas = %ld\n", m_replicas.size());
+    m_replicas[0]->dumpInfo();
+}
+
+const VecDlTensor *ReplicatedInferer::getInputInfo()
+{
+    return m_replicas[0]->getInputInfo();
+}
+
+const VecDlTensor *ReplicatedInferer::getOutputInfo()
+{
+    return m_replicas[0]->getOutputInfo();
+}
+
+void *ReplicatedInferer::allocate(int64_t size)
+{
+    return m_replicas[0]->allocate(size);
+}
+
+ReplicatedInferer::~ReplicatedInferer()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    for (auto &r : m_replicas)
+    {
+        delete r;
+    }
+}
+
+} // namespace ti::edgeai::common
+
@@ -0,0 +1,297 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_result_export.h>
+
+#define RESULT_SOCKET_SNDBUF    (4 * 1024 * 1024)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+static gboolean resultMetaInit(GstMeta     *meta,
+                               gpointer     params,
+                               GstBuffer   *buffer)
+{
+    (void)params;
+    (void)buffer;
+
+    /* The meta memory is not constructed by GStreamer. */
+    new (&reinterpret_cast<ResultMeta*>(meta)->result)
+        shared_ptr<const PostprocResult>();
+
+    return TRUE;
+}
+
+static void resultMetaFree(GstMeta     *meta,
+                           GstBuffer   *buffer)
+{
+    (void)buffer;
+
+    reinterpret_cast<ResultMeta*>(meta)->result.~shared_ptr();
+}
+
+static gboolean resultMetaTransform(GstBuffer  *dest,
+                                    GstMeta    *meta,
+                                    GstBuffer  *buffer,
+                                    GQuark      type,
+                                    gpointer    data)
+{
+    const auto &result = reinterpret_cast<ResultMeta*>(meta)->result;
+
+    (void)buffer;
+    (void)data;
+
+    /* The results only describe the frame as a whole, they are kept on
+     * copies and dropped otherwise.
+     */
+    if (!GST_META_TRANSFORM_IS_COPY(type) || result == nullptr)
+    {
+        return FALSE;
+    }
+
+    return addResultMeta(dest, result) == 0;
+}
+
+GType getResultMetaApiType()
+{
+    static const gchar *tags[] = {nullptr};
+    static const GType  type = gst_meta_api_type_register("EdgeaiResultMetaAPI",
+                                                          tags);
+
+    return type;
+}
+
+static const GstMetaInfo *getResultMetaInfo()
+{
+    static const GstMetaInfo *info = gst_meta_register(getResultMetaApiType(),
+                                                       "EdgeaiResultMeta",
+                                                       sizeof(ResultMeta),
+                                                       resultMetaInit,
+                                                       resultMetaFree,
+                                                       resultMetaTransform);
+
+    return info;
+}
+
+int32_t addResultMeta(GstBuffer                               *buffer,
+                      const shared_ptr<const PostprocResult>  &result)
+{
+    ResultMeta *meta;
+
+    if (!gst_buffer_is_writable(buffer))
+    {
+        return -1;
+    }
+
+    meta = reinterpret_cast<ResultMeta*>(gst_buffer_add_meta(buffer,
+                                                             getResultMetaInfo(),
+                                                             nullptr));
+
+    if (meta == nullptr)
+    {
+        return -1;
+    }
+
+    meta->result = result;
+
+    return 0;
+}
+
+const PostprocResult *getResultMeta(GstBuffer *buffer)
+{
+    GstMeta *meta = gst_buffer_get_meta(buffer, getResultMetaApiType());
+
+    if (meta == nullptr)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<ResultMeta*>(meta)->result.get();
+}
+
+ResultPublisher::ResultPublisher(const string &path)
+{
+    if (path.size() >= sizeof(m_addr.sun_path))
+    {
+        throw runtime_error("Result socket path [" + path + "] is too long.");
+    }
+
+    m_socket = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+
+    if (m_socket < 0)
+    {
+        throw runtime_error("Failed to create the result socket: " +
+                            string(strerror(errno)));
+    }
+
+    /* Let the segmentation masks fit in a datagram. */
+    int32_t sndBuf = RESULT_SOCKET_SNDBUF;
+    setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &sndBuf, sizeof(sndBuf));
+
+    m_addr.sun_family = AF_UNIX;
+    strncpy(m_addr.sun_path, path.c_str(), sizeof(m_addr.sun_path) - 1);
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+uint64_t serializeResult(const PostprocResult   &result,
+                         uint32_t                flowId,
+                         uint64_t                frameId,
+                         uint64_t                timestamp,
+                         vector<uint8_t>        &record)
+{
+    ResultRecordHeader  header{};
+    uint64_t            size = sizeof(header);
+    uint8_t            *ptr;
+
+    for (const auto &obj : result.objects)
+    {
+        size += sizeof(ResultRecordObject) + obj.keypoints.size() * sizeof(float);
+    }
+
+    size += result.mask.size();
+    record.resize(size);
+    ptr = record.data();
+
+    header.magic      = RESULT_RECORD_MAGIC;
+    header.version    = RESULT_RECORD_VERSION;
+    header.type       = result.type;
+    header.flowId     = flowId;
+    header.numObjects = result.objects.size();
+    header.frameId    = frameId;
+    header.timestamp  = timestamp;
+    header.width      = result.width;
+    header.height     = result.height;
+
+    if (!result.mask.empty())
+    {
+        header.maskWidth  = result.maskWidth;
+        header.maskHeight = result.maskHeight;
+    }
+
+    memcpy(ptr, &header, sizeof(header));
+    ptr += sizeof(header);
+
+    for (const auto &obj : result.objects)
+    {
+        ResultRecordObject entry;
+
+        entry.classId      = obj.classId;
+        entry.trackId      = obj.trackId;
+        entry.subClassId   = obj.subClassId;
+        entry.score        = obj.score;
+        entry.numKeypoints = obj.keypoints.size() / 3;
+
+        for (int32_t i = 0; i < 4; i++)
+        {
+            entry.box[i] = obj.box[i];
+        }
+
+        memcpy(ptr, &entry, sizeof(entry));
+        ptr += sizeof(entry);
+
+        memcpy(ptr, obj.keypoints.data(), entry.numKeypoints * 3 * sizeof(float));
+        ptr += entry.numKeypoints * 3 * sizeof(float);
+    }
+
+    memcpy(ptr, result.mask.data(), result.mask.size());
+
+    return size;
+}
+
+int32_t ResultPublisher::publish(const PostprocResult  &result,
+                                 uint32_t               flowId,
+                                 uint64_t               frameId,
+                                 uint64_t               timestamp)
+{
+    uint64_t    size;
+    ssize_t     ret;
+
+    size = serializeResult(result, flowId, frameId, timestamp, m_record);
+
+    ret = sendto(m_socket,
+                 m_record.data(),
+                 size,
+                 MSG_DONTWAIT,
+                 reinterpret_cast<struct sockaddr*>(&m_addr),
+                 sizeof(m_addr));
+
+    if (ret >= 0)
+    {
+        m_sentCnt++;
+        return 0;
+    }
+
+    /* No reader, or a reader not keeping up. */
+    if (errno == ENOENT || errno == ECONNREFUSED ||
+        errno == EAGAIN || errno == EWOULDBLOCK || errno == ENOBUFS)
+    {
+        m_dropCnt++;
+        return 0;
+    }
+
+    /* Only the first failure is reported, the records are dropped. */
+    if (m_errorCnt++ == 0)
+    {
+        LOG_ERROR("Failed to send the results to [%s]: %s\n",
+                  m_addr.sun_path, strerror(errno));
+    }
+
+    return -1;
+}
+
+ResultPublisher::~ResultPublisher()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    if (m_sentCnt > 0 || m_dropCnt > 0 || m_errorCnt > 0)
+    {
+        LOG_INFO("Sent %ld, dropped %ld and failed %ld result records "
+                 "to [%s].\n",
+                 m_sentCnt, m_dropCnt, m_errorCnt, m_addr.sun_path);
+    }
+
+    close(m_socket);
+}
+
+} // namespace ti::edgeai::common
@@ -0,0 +1,315 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* Standard headers. */
+#include <stdexcept>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_rtsp_server.h>
+
+#define RTSP_SERVER_SRC_NAME    "edgeai_rtsp_src"
+
+/* Bound of the appsrc queue, a few frames of a 1080p stream. */
+#define RTSP_SERVER_MAX_BYTES   (1024 * 1024)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+void RtspServerConfig::dumpInfo() const
+{
+    LOG_INFO_RAW("\n");
+    LOG_INFO("RtspServerConfig::port = %d\n", port);
+    LOG_INFO("RtspServerConfig::path = %s\n", path.c_str());
+    LOG_INFO_RAW("\n");
+}
+
+RtspServer::RtspServer(const RtspServerConfig  &config,
+                       const string            &name):
+    m_config(config)
+{
+    GstAppSinkCallbacks callbacks{};
+
+    if (m_config.path.empty() || m_config.path[0] != '/')
+    {
+        throw runtime_error("RTSP path [" + m_config.path +
+                            "] must start with '/'.");
+    }
+
+    m_appsink = gst_element_factory_make("appsink", name.c_str());
+
+    if (m_appsink == nullptr)
+    {
+        throw runtime_error("Failed to create the RTSP appsink.");
+    }
+
+    /* Keep a reference so that the element cannot outlive the context. */
+    gst_object_ref_sink(m_appsink);
+
+    /* The output pipeline must never wait on the clients. The access units
+     * are pulled as they come and only dropped in forward(), where the
+     * stream can resume on a key frame. Dropping in the appsink would
+     * leave the clients with undecodable frames up to the next one.
+     */
+    GstCaps *caps = gst_caps_from_string("video/x-h264, "
+                                         "stream-format=byte-stream, "
+                                         "alignment=au");
+    g_object_set(m_appsink,
+                 "caps", caps,
+                 "sync", FALSE,
+                 "async", FALSE,
+                 "max-buffers", 1,
+                 "drop", FALSE,
+                 NULL);
+    gst_caps_unref(caps);
+
+    callbacks.new_sample = onNewSample;
+    gst_app_sink_set_callbacks(GST_APP_SINK(m_appsink), &callbacks, this, nullptr);
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+GstElement *RtspServer::getElement()
+{
+    return m_appsink;
+}
+
+int32_t RtspServer::start()
+{
+    GstRTSPMountPoints     *mounts;
+    GstRTSPMediaFactory    *factory;
+    string                  port = to_string(m_config.port);
+
+    m_server = gst_rtsp_server_new();
+    gst_rtsp_server_set_service(m_server, port.c_str());
+
+    /* All the clients share the media, payloading the same stream. */
+    factory = gst_rtsp_media_factory_new();
+    gst_rtsp_media_factory_set_launch(factory,
+                                      "( appsrc name=" RTSP_SERVER_SRC_NAME
+                                      " is-live=true format=time do-timestamp=true"
+                                      " ! h264parse config-interval=-1"
+                                      " ! rtph264pay name=pay0 pt=96 )");
+    gst_rtsp_media_factory_set_shared(factory, TRUE);
+    g_signal_connect(factory, "media-configure", G_CALLBACK(onMediaConfigure), this);
+
+    mounts = gst_rtsp_server_get_mount_points(m_server);
+    gst_rtsp_mount_points_add_factory(mounts, m_config.path.c_str(), factory);
+    g_object_unref(mounts);
+
+    m_context  = g_main_context_new();
+    m_loop     = g_main_loop_new(m_context, FALSE);
+    m_sourceId = gst_rtsp_server_attach(m_server, m_context);
+
+    if (m_sourceId == 0)
+    {
+        LOG_ERROR("Failed to start the RTSP server on port %d.\n", m_config.port);
+        return -1;
+    }
+
+    m_loopThread = thread([this]{ g_main_loop_run(m_loop); });
+
+    LOG_INFO("Serving rtsp://<host>:%d%s\n", m_config.port, m_config.path.c_str());
+
+    return 0;
+}
+
+void RtspServer::forward(GstSample *sample)
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    if (m_appsrc == nullptr)
+    {
+        return;
+    }
+
+    if (!m_capsSet)
+    {
+        gst_app_src_set_caps(GST_APP_SRC(m_appsrc), gst_sample_get_caps(sample));
+        m_capsSet = true;
+    }
+
+    GstBuffer  *input = gst_sample_get_buffer(sample);
+    bool        delta = GST_BUFFER_FLAG_IS_SET(input, GST_BUFFER_FLAG_DELTA_UNIT);
+
+    /* The access units are dropped while the clients do not keep up, then
+     * up to the next key frame the stream can be decoded from again.
+     */
+    if (gst_app_src_get_current_level_bytes(GST_APP_SRC(m_appsrc)) >=
+        RTSP_SERVER_MAX_BYTES)
+    {
+        m_waitKeyFrame = true;
+    }
+
+    if (m_waitKeyFrame && delta)
+    {
+        m_droppedCnt++;
+        return;
+    }
+
+    m_waitKeyFrame = false;
+
+    /* The media has its own running time, the appsrc stamps the buffers. */
+    GstBuffer *buffer = gst_buffer_copy(input);
+
+    GST_BUFFER_PTS(buffer) = GST_CLOCK_TIME_NONE;
+    GST_BUFFER_DTS(buffer) = GST_CLOCK_TIME_NONE;
+
+    if (gst_app_src_push_buffer(GST_APP_SRC(m_appsrc), buffer) == GST_FLOW_OK)
+    {
+        m_sentCnt++;
+    }
+}
+
+GstFlowReturn RtspServer::onNewSample(GstAppSink   *appsink,
+                                      gpointer      data)
+{
+    RtspServer *self = reinterpret_cast<RtspServer*>(data);
+    GstSample  *sample = gst_app_sink_pull_sample(appsink);
+
+    if (sample == nullptr)
+    {
+        return GST_FLOW_OK;
+    }
+
+    /* A server failing to start is reported once, the output keeps going. */
+    if (!self->m_started)
+    {
+        self->m_started = true;
+        self->start();
+    }
+
+    self->forward(sample);
+    gst_sample_unref(sample);
+
+    return GST_FLOW_OK;
+}
+
+void RtspServer::onMediaConfigure(GstRTSPMediaFactory  *factory,
+                                  GstRTSPMedia         *media,
+                                  gpointer              data)
+{
+    RtspServer *self = reinterpret_cast<RtspServer*>(data);
+    GstElement *element = gst_rtsp_media_get_element(media);
+    GstElement *appsrc;
+
+    (void)factory;
+
+    appsrc = gst_bin_get_by_name_recurse_up(GST_BIN(element), RTSP_SERVER_SRC_NAME);
+    gst_object_unref(element);
+
+    g_signal_connect(media, "unprepared", G_CALLBACK(onMediaUnprepared), self);
+
+    lock_guard<mutex> lock(self->m_mutex);
+
+    if (self->m_appsrc != nullptr)
+    {
+        gst_object_unref(self->m_appsrc);
+    }
+
+    self->m_appsrc = appsrc;
+    self->m_capsSet = false;
+    self->m_waitKeyFrame = false;
+
+    gst_app_src_set_max_bytes(GST_APP_SRC(appsrc), RTSP_SERVER_MAX_BYTES);
+
+    LOG_INFO("RTSP media prepared on %s.\n", self->m_config.path.c_str());
+}
+
+void RtspServer::onMediaUnprepared(GstRTSPMedia    *media,
+                                   gpointer         data)
+{
+    RtspServer *self = reinterpret_cast<RtspServer*>(data);
+
+    (void)media;
+
+    lock_guard<mutex> lock(self->m_mutex);
+
+    if (self->m_appsrc != nullptr)
+    {
+        gst_object_unref(self->m_appsrc);
+        self->m_appsrc = nullptr;
+    }
+}
+
+RtspServer::~RtspServer()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    if (m_loopThread.joinable())
+    {
+        g_main_loop_quit(m_loop);
+        m_loopThread.join();
+    }
+
+    if (m_sourceId != 0)
+    {
+        g_source_destroy(g_main_context_find_source_by_id(m_context, m_sourceId));
+    }
+
+    if (m_appsrc != nullptr)
+    {
+        gst_object_unref(m_appsrc);
+    }
+
+    if (m_server != nullptr)
+    {
+        g_object_unref(m_server);
+    }
+
+    if (m_loop != nullptr)
+    {
+        g_main_loop_unref(m_loop);
+    }
+
+    if (m_context != nullptr)
+    {
+        g_main_context_unref(m_context);
+    }
+
+    if (m_sentCnt > 0)
+    {
+        LOG_INFO("Served %ld access units on %s.\n",
+                 m_sentCnt, m_config.path.c_str());
+    }
+
+    if (m_droppedCnt > 0)
+    {
+        LOG_INFO("Dropped %ld access units the clients were too slow for.\n",
+                 m_droppedCnt);
+    }
+
+    gst_object_unref(m_appsink);
+}
+
+} // namespace ti::edgeai::common
@@ -0,0 +1,485 @@
+/*
+ *  Copyright (C) 2024 Texas Instruments Incorporated - http://www.ti.com/
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions
+ *  are met:
+ *
+ *    Redistributions of source code must retain the above copyright
+ *    notice, this list of conditions and the following disclaimer.
+ *
+ *    Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the
+ *    distribution.
+ *
+ *    Neither the name of Texas Instruments Incorporated nor the names of
+ *    its contributors may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ *  "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ *  LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ *  A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ *  OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ *  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ *  LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ *  DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ *  THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ *  OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+/* Standard headers. */
+#include <filesystem>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+
+/* Module headers. */
+#include <utils/include/ti_logger.h>
+#include <common/include/edgeai_tensor_capture.h>
+
+#define TENSOR_CAPTURE_ALIGN_UP(_S) \
+    ((((_S) + TENSOR_CAPTURE_ALIGN - 1) / TENSOR_CAPTURE_ALIGN) * TENSOR_CAPTURE_ALIGN)
+
+namespace ti::edgeai::common
+{
+using namespace ti::utils;
+
+static_assert(sizeof(TensorCaptureFileHeader) <= TENSOR_CAPTURE_ALIGN,
+              "Capture file header does not fit in the first page.");
+
+static_assert(sizeof(TensorCaptureRecordHeader) <= TENSOR_CAPTURE_ALIGN,
+              "Capture record header does not fit in a page.");
+
+/* Source of the padding bytes. */
+static const uint8_t gZeroPage[TENSOR_CAPTURE_ALIGN] = {0};
+
+static int32_t fillDesc(TensorCaptureDesc  &desc,
+                        const DlTensor     &tensor,
+                        int64_t             offset)
+{
+    if (tensor.dim > TENSOR_CAPTURE_MAX_DIMS)
+    {
+        LOG_ERROR("Tensor %s has %d dimensions. Only %d are supported.\n",
+                  tensor.name.c_str(), tensor.dim, TENSOR_CAPTURE_MAX_DIMS);
+        return -1;
+    }
+
+    strncpy(desc.name, tensor.name.c_str(), TENSOR_CAPTURE_NAME_LEN - 1);
+    desc.type     = tensor.type;
+    desc.elemSize = tensor.elemSize;
+    desc.dim      = tensor.dim;
+    desc.size     = tensor.size;
+    desc.offset   = offset;
+
+    for (int32_t i = 0; i < tensor.dim; i++)
+    {
+        desc.shape[i] = tensor.shape[i];
+    }
+
+    return 0;
+}
+
+/* Checks a descriptor read from a file before it is trusted. */
+static int32_t checkDesc(const TensorCaptureDesc   &desc,
+                         int64_t                    recordSize)
+{
+    if (memchr(desc.name, 0, TENSOR_CAPTURE_NAME_LEN) == nullptr ||
+        desc.dim < 0 || desc.dim > TENSOR_CAPTURE_MAX_DIMS)
+    {
+        return -1;
+    }
+
+    /* The payload is made of whole elements, inside the record. */
+    if (desc.elemSize <= 0 || desc.size < 0 ||
+        desc.size % desc.elemSize != 0 ||
+        desc.offset < 0 || desc.offset > recordSize ||
+        desc.size > recordSize - desc.offset)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+static DlTensor makeTensor(const TensorCaptureDesc &desc)
+{
+    DlTensor    tensor;
+
+    tensor.name     = desc.name;
+    tensor.type     = static_cast<DlInferType>(desc.type);
+    tensor.elemSize = desc.elemSize;
+    tensor.dim      = desc.dim;
+    tensor.size     = desc.size;
+    tensor.shape.assign(desc.shape, desc.shape + desc.dim);
+    tensor.numElem  = desc.size / desc.elemSize;
+
+    return tensor;
+}
+
+TensorCaptureWriter::TensorCaptureWriter(const string       &file,
+                                         const VecDlTensor  &inputInfo,
+                                         const VecDlTensor  &outputInfo):
+    m_file(file)
+{
+    uint8_t     page[TENSOR_CAPTURE_ALIGN] = {0};
+    int64_t     offset = TENSOR_CAPTURE_ALIGN;
+    uint32_t    cnt = 0;
+    int32_t     status = 0;
+
+    if (inputInfo.size() + outputInfo.size() > TENSOR_CAPTURE_MAX_TENSORS)
+    {
+        LOG_ERROR("Too many tensors to capture. Maximum is %d.\n",
+                  TENSOR_CAPTURE_MAX_TENSORS);
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        memcpy(m_header.magic, TENSOR_CAPTURE_MAGIC, sizeof(TENSOR_CAPTURE_MAGIC));
+        m_header.version    = TENSOR_CAPTURE_VERSION;
+        m_header.numInputs  = inputInfo.size();
+        m_header.numOutputs = outputInfo.size();
+        m_header.align      = TENSOR_CAPTURE_ALIGN;
+
+        for (auto const *info : {&inputInfo, &outputInfo})
+        {
+            for (auto const &t : *info)
+            {
+                status = fillDesc(m_header.tensors[cnt++], t, offset);
+
+                if (status < 0)
+                {
+                    break;
+                }
+
+                offset += TENSOR_CAPTURE_ALIGN_UP(t.size);
+            }
+        }
+
+        m_header.recordSize = offset;
+    }
+
+    if (status == 0)
+    {
+        auto dir = filesystem::path(m_file).parent_path();
+
+        if (!dir.empty())
+        {
+            filesystem::create_directories(dir);
+        }
+
+        m_fd = open(m_file.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+
+        if (m_fd < 0)
+        {
+            LOG_ERROR("Could not create %s.\n", m_file.c_str());
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        memcpy(page, &m_header, sizeof(m_header));
+
+        if (::write(m_fd, page, sizeof(page)) != sizeof(page))
+        {
+            LOG_ERROR("Could not write the header to %s.\n", m_file.c_str());
+            status = -1;
+        }
+    }
+
+    if (status < 0)
+    {
+        if (m_fd >= 0)
+        {
+            close(m_fd);
+        }
+
+        throw runtime_error("TensorCaptureWriter object creation failed.");
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+int32_t TensorCaptureWriter::write(uint64_t              frameId,
+                                   int64_t               inferTime,
+                                   const VecDlTensorPtr &inputs,
+                                   const VecDlTensorPtr &outputs)
+{
+    TensorCaptureRecordHeader   rec;
+    struct iovec                iov[1 + 2 * TENSOR_CAPTURE_MAX_TENSORS];
+    uint8_t                     page[TENSOR_CAPTURE_ALIGN] = {0};
+    struct timespec             ts;
+    int32_t                     numIov = 0;
+    uint32_t                    cnt = 0;
+    off_t                       pos;
+
+    if (inputs.size() != m_header.numInputs ||
+        outputs.size() != m_header.numOutputs)
+    {
+        LOG_ERROR("Tensor count does not match the capture header.\n");
+        return -1;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    rec.frameId   = frameId;
+    rec.timestamp = ts.tv_sec * 1000000000LL + ts.tv_nsec;
+    rec.inferTime = inferTime;
+    memcpy(page, &rec, sizeof(rec));
+
+    iov[numIov].iov_base = page;
+    iov[numIov].iov_len  = sizeof(page);
+    numIov++;
+
+    for (auto const *vec : {&inputs, &outputs})
+    {
+        for (auto const *t : *vec)
+        {
+            const int64_t size = m_header.tensors[cnt++].size;
+            const int64_t pad  = TENSOR_CAPTURE_ALIGN_UP(size) - size;
+
+            iov[numIov].iov_base = t->data;
+            iov[numIov].iov_len  = size;
+            numIov++;
+
+            if (pad)
+            {
+                iov[numIov].iov_base = const_cast<uint8_t *>(gZeroPage);
+                iov[numIov].iov_len  = pad;
+                numIov++;
+            }
+        }
+    }
+
+    pos = lseek(m_fd, 0, SEEK_CUR);
+
+    if (writev(m_fd, iov, numIov) != m_header.recordSize)
+    {
+        /* Drop the partial record so that the following ones stay
+         * aligned.
+         */
+        LOG_ERROR("Could not write frame %ld to %s.\n", frameId, m_file.c_str());
+
+        if (ftruncate(m_fd, pos) == 0)
+        {
+            lseek(m_fd, pos, SEEK_SET);
+        }
+
+        return -1;
+    }
+
+    return 0;
+}
+
+TensorCaptureWriter::~TensorCaptureWriter()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    if (m_fd >= 0)
+    {
+        close(m_fd);
+    }
+}
+
+TensorCaptureReader::TensorCaptureReader(const string &file)
+{
+    struct stat st;
+    void       *addr = MAP_FAILED;
+    int32_t     status = 0;
+    int         fd;
+
+    fd = open(file.c_str(), O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0 || fstat(fd, &st) < 0)
+    {
+        LOG_ERROR("Could not open %s.\n", file.c_str());
+        status = -1;
+    }
+    else if (st.st_size < TENSOR_CAPTURE_ALIGN)
+    {
+        LOG_ERROR("%s is too small to be a capture file.\n", file.c_str());
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        addr = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+        if (addr == MAP_FAILED)
+        {
+            LOG_ERROR("mmap() failed for %s.\n", file.c_str());
+            status = -1;
+        }
+    }
+
+    if (fd >= 0)
+    {
+        close(fd);
+    }
+
+    if (status == 0)
+    {
+        m_base   = static_cast<const uint8_t *>(addr);
+        m_size   = st.st_size;
+        m_header = reinterpret_cast<const TensorCaptureFileHeader *>(m_base);
+
+        if (memcmp(m_header->magic, TENSOR_CAPTURE_MAGIC, sizeof(TENSOR_CAPTURE_MAGIC)) ||
+            m_header->version != TENSOR_CAPTURE_VERSION ||
+            m_header->align != TENSOR_CAPTURE_ALIGN ||
+            m_header->recordSize <= 0 ||
+            m_header->numInputs > TENSOR_CAPTURE_MAX_TENSORS ||
+            m_header->numOutputs > TENSOR_CAPTURE_MAX_TENSORS ||
+            m_header->numInputs + m_header->numOutputs > TENSOR_CAPTURE_MAX_TENSORS)
+        {
+            LOG_ERROR("%s is not a valid capture file.\n", file.c_str());
+            status = -1;
+        }
+    }
+
+    if (status == 0)
+    {
+        const auto *desc = m_header->tensors;
+        uint32_t    numTensors = m_header->numInputs + m_header->numOutputs;
+
+        for (uint32_t i = 0; i < numTensors; i++)
+        {
+            if (checkDesc(desc[i], m_header->recordSize) < 0)
+            {
+                LOG_ERROR("Tensor %d of %s has an invalid descriptor.\n",
+                          i, file.c_str());
+                status = -1;
+                break;
+            }
+        }
+    }
+
+    if (status == 0)
+    {
+        const auto *desc = m_header->tensors;
+
+        for (uint32_t i = 0; i < m_header->numInputs; i++)
+        {
+            m_inputInfo.push_back(makeTensor(*desc++));
+        }
+
+        for (uint32_t i = 0; i < m_header->numOutputs; i++)
+        {
+            m_outputInfo.push_back(makeTensor(*desc++));
+        }
+
+        m_numRecords = (m_size - TENSOR_CAPTURE_ALIGN) / m_header->recordSize;
+
+        /* Records are read front to back. */
+        madvise(addr, m_size, MADV_SEQUENTIAL);
+    }
+
+    if (status < 0)
+    {
+        if (addr != MAP_FAILED)
+        {
+            munmap(addr, st.st_size);
+        }
+
+        throw runtime_error("TensorCaptureReader object creation failed.");
+    }
+
+    LOG_DEBUG("CONSTRUCTOR\n");
+}
+
+uint64_t TensorCaptureReader::getNumRecords() const
+{
+    return m_numRecords;
+}
+
+const VecDlTensor *TensorCaptureReader::getInputInfo() const
+{
+    return &m_inputInfo;
+}
+
+const VecDlTensor *TensorCaptureReader::getOutputInfo() const
+{
+    return &m_outputInfo;
+}
+
+const uint8_t *TensorCaptureReader::recordBase(uint64_t index) const
+{
+    return m_base + TENSOR_CAPTURE_ALIGN + index * m_header->recordSize;
+}
+
+const TensorCaptureRecordHeader *TensorCaptureReader::getRecord(uint64_t index) const
+{
+    if (index >= m_numRecords)
+    {
+        return nullptr;
+    }
+
+    return reinterpret_cast<const TensorCaptureRecordHeader *>(recordBase(index));
+}
+
+const uint8_t *TensorCaptureReader::getInputData(uint64_t index,
+                                                 uint32_t tensor) const
+{
+    if (index >= m_numRecords || tensor >= m_header->numInputs)
+    {
+        return nullptr;
+    }
+
+    return recordBase(index) + m_header->tensors[tensor].offset;
+}
+
+const uint8_t *TensorCaptureReader::getOutputData(uint64_t index,
+                                                  uint32_t tensor) const
+{
+    if (index >= m_numRecords || tensor >= m_header->numOutputs)
+    {
+        return nullptr;
+    }
+
+    tensor += m_header->numInputs;
+
+    return recordBase(index) + m_header->tensors[tensor].offset;
+}
+
+int32_t TensorCaptureReader::bind(uint64_t          index,
+                                  VecDlTensorPtr   &inputs,
+                                  VecDlTensorPtr   &outputs) const
+{
+    if (index >= m_numRecords ||
+        inputs.size() > m_header->numInputs ||
+        outputs.size() > m_header->numOutputs)
+    {
+        LOG_ERROR("Invalid record %ld or tensor count.\n", index);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < inputs.size(); i++)
+    {
+        inputs[i]->data = const_cast<uint8_t *>(getInputData(index, i));
+    }
+
+    for (uint32_t i = 0; i < outputs.size(); i++)
+    {
+        outputs[i]->data = const_cast<uint8_t *>(getOutputData(index, i));
+    }
+
+    return 0;
+}
+
+TensorCaptureReader::~TensorCaptureReader()
+{
+    LOG_DEBUG("DESTRUCTOR\n");
+
+    if (m_base != nullptr)
+    {
+        munmap(const_cast<uint8_t *>(m_base), m_size);
+    }
+}
+
+} // namespace ti::edgeai::common
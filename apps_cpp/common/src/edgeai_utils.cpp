@@ -52,7 +52,7 @@ uint32_t targetIdx = 0;
 // Please keep the following array and map consistent in terms of the
 // number anf names of the elements
 const string gStatKeys[] = {"dl-inference"};
-const string gMetricKeys[] = {"total time", "framerate"};
+const string gMetricKeys[] = {"total time", "framerate", "input drops"};
 
 /**
  * Hold the processing time of different operations
@@ -88,18 +88,44 @@ struct StatEntry
     /** Name of the model. */
     string      m_modelName;
 
+    /** Input, model type and model name without the display labels. */
+    string      m_input;
+    string      m_type;
+    string      m_model;
+
+    /** Individual samples per tag, kept while collection is enabled. */
+    map<string, vector<float>>  m_samples{};
+
     /** Processing time details. */
     MapProcTime m_proc{};
 
     /** Metrics context. */
     MapMetrics  m_metrics{};
+
+    /** Lock for the values, only contended by the threads of one flow. */
+    mutex       m_lock;
+};
+
+struct ElementStatEntry
+{
+    /** Kind of latency measured. */
+    string      m_tag;
+
+    /** Latency details. */
+    ProcTime    m_time{};
+
+    /** Metrics context. */
+    MapMetrics  m_metrics{};
 };
 
 /* Initialize the status. */
 MapStatEntry Statistics::m_stats{};
+MapElementStat Statistics::m_elemStats{};
 bool Statistics::m_printCurses = false;
 bool Statistics::m_printStdout = !Statistics::m_printCurses;
 thread Statistics::m_reportingThread;
+atomic<bool> Statistics::m_collectSamples{false};
+mutex Statistics::m_mutex;
 
 int32_t Statistics::addEntry(uint32_t       key,
                              const string  &inputName,
@@ -108,6 +134,8 @@ int32_t Statistics::addEntry(uint32_t       key,
 {
     int32_t status = 0;
 
+    std::unique_lock<std::mutex> lock(m_mutex);
+
     /* Check if an entry for this key already exists. */
     if (m_stats.find(key) != m_stats.end())
     {
@@ -118,7 +146,7 @@ int32_t Statistics::addEntry(uint32_t       key,
     if (status == 0)
     {
         string      fName = modelPath;
-        StatEntry   s;
+        StatEntry  &s = m_stats[key];
 
         /* Delete the trailing '/' if present. This will lead to an empty
          * string in the call to filename() below, if not deleted.
@@ -128,7 +156,10 @@ int32_t Statistics::addEntry(uint32_t       key,
             fName.pop_back();
         }
 
-        s.m_modelName = "Model Name:   " + string(filesystem::path(fName).filename());
+        s.m_model     = filesystem::path(fName).filename();
+        s.m_type      = modelType;
+        s.m_input     = inputName;
+        s.m_modelName = "Model Name:   " + s.m_model;
         s.m_modelType = "Model Type:   " + modelType;
         s.m_inputName = "Input Source: " + inputName;
 
@@ -142,8 +173,6 @@ int32_t Statistics::addEntry(uint32_t       key,
         {
             s.m_metrics[tag] = Metrics();
         }
-
-        m_stats[key] = s;
     }
 
     return status;
@@ -155,9 +184,13 @@ int32_t Statistics::reportProcTime(uint32_t         key,
 {
     StatEntry  *e;
     ProcTime   *p;
+    float       average;
     int32_t     status = 0;
 
-    if (m_stats.find(key) == m_stats.end())
+    /* The entries are all added before the reporting starts. */
+    const auto &it = m_stats.find(key);
+
+    if (it == m_stats.end())
     {
         LOG_ERROR("Key [%d] not found.\n", key);
         status = -1;
@@ -165,17 +198,28 @@ int32_t Statistics::reportProcTime(uint32_t         key,
 
     if (status == 0)
     {
-        e = &m_stats[key];
+        e = &it->second;
+
+        std::unique_lock<std::mutex> lock(e->m_lock);
+
         p = &e->m_proc[tag];
 
         p->average = (p->average * p->samples + value)/(p->samples + 1);
         p->samples++;
+        average = p->average;
+
+        if (m_collectSamples)
+        {
+            e->m_samples[tag].push_back(value);
+        }
+
+        lock.unlock();
 
         if (m_printStdout)
         {
             printf("[UTILS] [%s] Time for '%s': %5.2f ms (avg %5.2f ms)\n",
                     e->m_modelName.c_str(),
-                    tag.c_str(), value, p->average);
+                    tag.c_str(), value, average);
         }
     }
 
@@ -189,9 +233,13 @@ int32_t Statistics::reportMetric(uint32_t       key,
 {
     StatEntry  *e;
     Metrics    *m;
+    float       average;
     int32_t     status = 0;
 
-    if (m_stats.find(key) == m_stats.end())
+    /* The entries are all added before the reporting starts. */
+    const auto &it = m_stats.find(key);
+
+    if (it == m_stats.end())
     {
         LOG_ERROR("Key [%d] not found.\n", key);
         status = -1;
@@ -199,19 +247,124 @@ int32_t Statistics::reportMetric(uint32_t       key,
 
     if (status == 0)
     {
-        e = &m_stats[key];
+        e = &it->second;
+
+        std::unique_lock<std::mutex> lock(e->m_lock);
+
         m = &e->m_metrics[tag];
 
         m->value = (m->value * m->samples + value)/(m->samples + 1);
         m->unit  = unit;
 
         m->samples++;
+        average = m->value;
+
+        if (m_collectSamples)
+        {
+            e->m_samples[tag].push_back(value);
+        }
+
+        lock.unlock();
 
         if (m_printStdout)
         {
             printf("[UTILS] [%s] Metric '%s': %5.2f %s\n",
                     e->m_modelName.c_str(),
-                    tag.c_str(), m->value, m->unit.c_str());
+                    tag.c_str(), average, unit.c_str());
+        }
+    }
+
+    return status;
+}
+
+int32_t Statistics::addElementEntry(const string   &name,
+                                    const string   &tag)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    if (m_elemStats.find(name) == m_elemStats.end())
+    {
+        m_elemStats[name].m_tag = tag;
+    }
+
+    return 0;
+}
+
+int32_t Statistics::reportElementTime(const string &name,
+                                      float         value,
+                                      uint64_t      numSamples)
+{
+    ProcTime   *p;
+    int32_t     status = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    const auto &it = m_elemStats.find(name);
+
+    if (it == m_elemStats.end())
+    {
+        LOG_ERROR("Element [%s] not found.\n", name.c_str());
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        p = &it->second.m_time;
+
+        p->average = (p->average * p->samples + value * numSamples)/
+                     (p->samples + numSamples);
+        p->samples += numSamples;
+
+        const string    tag = it->second.m_tag;
+        float           average = p->average;
+
+        lock.unlock();
+
+        if (m_printStdout)
+        {
+            printf("[UTILS] [%s] Time for '%s': %5.2f ms (avg %5.2f ms)\n",
+                    name.c_str(), tag.c_str(), value, average);
+        }
+    }
+
+    return status;
+}
+
+int32_t Statistics::reportElementMetric(const string   &name,
+                                        const string   &tag,
+                                        const string   &unit,
+                                        float           value)
+{
+    Metrics    *m;
+    int32_t     status = 0;
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    const auto &it = m_elemStats.find(name);
+
+    if (it == m_elemStats.end())
+    {
+        LOG_ERROR("Element [%s] not found.\n", name.c_str());
+        status = -1;
+    }
+
+    if (status == 0)
+    {
+        m = &it->second.m_metrics[tag];
+
+        m->value = (m->value * m->samples + value)/(m->samples + 1);
+        m->unit  = unit;
+
+        m->samples++;
+
+        float average = m->value;
+
+        lock.unlock();
+
+        if (m_printStdout)
+        {
+            printf("[UTILS] [%s] Metric '%s': %5.2f %s\n",
+                    name.c_str(), tag.c_str(), average, unit.c_str());
         }
     }
 
@@ -281,6 +434,8 @@ void Statistics::reportingLoop(const string &demoName)
         {
             auto const s = &statsDb[i];
 
+            std::unique_lock<std::mutex> entryLock(s->m_lock);
+
             mvprintw(row++, 1, border.c_str());
             mvprintw(row++, 1, fmt.c_str(), s->m_inputName.c_str());
             mvprintw(row++, 1, fmt.c_str(), s->m_modelName.c_str());
@@ -307,6 +462,39 @@ void Statistics::reportingLoop(const string &demoName)
             mvprintw(row++, 1, border.c_str());
         }
 
+        /* The element metrics are added as they are first reported. */
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        if (!m_elemStats.empty())
+        {
+            mvprintw(row++, 1, border.c_str());
+            mvprintw(row++, 1, fmt.c_str(), "GST elements");
+            mvprintw(row++, 1, border.c_str());
+
+            for (auto &[name, e] : m_elemStats)
+            {
+                if (e.m_time.samples > 0)
+                {
+                    const string &title = (name + " (" + e.m_tag + ")").substr(0, 29);
+
+                    drawDataRow(row, title.c_str(), e.m_time.average, "ms",
+                                e.m_time.samples, len+2);
+                }
+
+                for (auto &[tag, m] : e.m_metrics)
+                {
+                    const string &title = (name + " " + tag).substr(0, 29);
+
+                    drawDataRow(row, title.c_str(), m.value,
+                                m.unit.c_str(), m.samples, len+2);
+                }
+            }
+
+            mvprintw(row++, 1, border.c_str());
+        }
+
+        lock.unlock();
+
         refresh();
         this_thread::sleep_for(chrono::milliseconds(1000));
     }
@@ -338,6 +526,106 @@ void Statistics::disableCursesReport()
     }
 }
 
+void Statistics::enableSampleCollection(bool state)
+{
+    if (state)
+    {
+        for (auto &[key, e] : m_stats)
+        {
+            std::unique_lock<std::mutex> lock(e.m_lock);
+
+            e.m_samples.clear();
+        }
+    }
+
+    m_collectSamples = state;
+}
+
+uint64_t Statistics::getMinSampleCount(const string &tag)
+{
+    uint64_t    count = m_stats.empty() ? 0 : UINT64_MAX;
+
+    for (auto &[key, e] : m_stats)
+    {
+        std::unique_lock<std::mutex> lock(e.m_lock);
+
+        count = std::min<uint64_t>(count, e.m_samples[tag].size());
+    }
+
+    return count;
+}
+
+/* Nearest rank percentile of a sorted vector. */
+static float percentile(const vector<float> &v, float pct)
+{
+    uint64_t rank = ceil(pct / 100 * v.size());
+
+    return v[rank ? rank - 1 : 0];
+}
+
+void Statistics::writeJson(FILE            *fp,
+                           double           duration,
+                           const string    &indent)
+{
+    const char *in = indent.c_str();
+    uint64_t    cnt = 0;
+
+    fprintf(fp, "[\n");
+
+    for (auto &[key, e] : m_stats)
+    {
+        std::unique_lock<std::mutex> lock(e.m_lock);
+
+        auto       &frames = e.m_samples[gMetricKeys[0]];
+        auto       &inferences = e.m_samples[gStatKeys[0]];
+        uint64_t    t = 0;
+
+        fprintf(fp, "%s  {\n", in);
+        fprintf(fp, "%s    \"id\": %d,\n", in, key);
+        fprintf(fp, "%s    \"input\": \"%s\",\n", in, jsonEscape(e.m_input).c_str());
+        fprintf(fp, "%s    \"model\": \"%s\",\n", in, jsonEscape(e.m_model).c_str());
+        fprintf(fp, "%s    \"type\": \"%s\",\n", in, jsonEscape(e.m_type).c_str());
+        fprintf(fp, "%s    \"frames\": %ld,\n", in, frames.size());
+        fprintf(fp, "%s    \"inferences\": %ld,\n", in, inferences.size());
+        fprintf(fp, "%s    \"fps\": %.3f,\n", in,
+                duration > 0 ? frames.size() / duration : 0.0);
+        fprintf(fp, "%s    \"latency_ms\": {", in);
+
+        for (auto &[tag, samples] : e.m_samples)
+        {
+            double  sum = 0;
+
+            /* Frame rate samples are not latencies. */
+            bool    isLatency = e.m_proc.count(tag) ||
+                                (e.m_metrics.count(tag) &&
+                                 e.m_metrics.at(tag).unit == "ms");
+
+            if (samples.empty() || !isLatency)
+            {
+                continue;
+            }
+
+            sort(samples.begin(), samples.end());
+
+            for (auto s : samples)
+            {
+                sum += s;
+            }
+
+            fprintf(fp, "%s\n%s      \"%s\": {\"mean\": %.3f, \"p50\": %.3f, "
+                    "\"p90\": %.3f, \"p99\": %.3f, \"max\": %.3f}",
+                    t++ ? "," : "", in, jsonEscape(tag).c_str(), sum / samples.size(),
+                    percentile(samples, 50), percentile(samples, 90),
+                    percentile(samples, 99), samples.back());
+        }
+
+        fprintf(fp, "\n%s    }\n", in);
+        fprintf(fp, "%s  }%s\n", in, ++cnt < m_stats.size() ? "," : "");
+    }
+
+    fprintf(fp, "%s]", in);
+}
+
 void getPreProcScalerElements(const PreprocessImageConfig   *preProcCfg,
                               vector<GstElement *>          &preProcElements,
                               bool                           isMultiSrc)
@@ -528,6 +816,41 @@ void getPreProcElements(const PreprocessImageConfig *preProcCfg,
     }
 }
 
+std::string getPreProcKey(const PreprocessImageConfig *preProcCfg)
+{
+    std::string key;
+
+    key = to_string(preProcCfg->inDataWidth) + "x" +
+          to_string(preProcCfg->inDataHeight) + ":" +
+          to_string(preProcCfg->resizeWidth) + "x" +
+          to_string(preProcCfg->resizeHeight) + ":" +
+          to_string(preProcCfg->outDataWidth) + "x" +
+          to_string(preProcCfg->outDataHeight);
+
+    /* Without dlpreproc the branch ends in RGB frames and the tensor
+     * conversion happens in the PreprocessImage object, so the tensor
+     * parameters do not affect the branch.
+     */
+    if (gstElementMap["dlpreproc"]["element"])
+    {
+        key += ":" + preProcCfg->dataLayout +
+               ":" + to_string(preProcCfg->reverseChannel) +
+               ":" + to_string(preProcCfg->inputTensorTypes[0]);
+
+        for (auto const &m : preProcCfg->mean)
+        {
+            key += ":" + to_string(m);
+        }
+
+        for (auto const &s : preProcCfg->scale)
+        {
+            key += ":" + to_string(s);
+        }
+    }
+
+    return key;
+}
+
 const std::string to_fraction(std::string& num)
 {
     if(_is_number<int>(num))
@@ -551,6 +874,35 @@ const std::string to_fraction(std::string& num)
     }
 }
 
+std::string jsonEscape(const std::string& s)
+{
+    std::string out;
+
+    out.reserve(s.size());
+
+    for (unsigned char c : s)
+    {
+        if (c == '"' || c == '\\')
+        {
+            out += '\\';
+            out += c;
+        }
+        else if (c < 0x20)
+        {
+            char esc[8];
+
+            snprintf(esc, sizeof(esc), "\\u%04x", c);
+            out += esc;
+        }
+        else
+        {
+            out += c;
+        }
+    }
+
+    return out;
+}
+
 template<typename Numeric>
 bool _is_number(const std::string& s)
 {
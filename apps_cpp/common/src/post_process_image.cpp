@@ -60,6 +60,65 @@ PostprocessImage::PostprocessImage(const PostprocessImageConfig &config,
     m_debugObj(debugConfig)
 {
     m_title = std::string("Model: ") + m_config.modelName;
+
+    m_result = std::make_shared<PostprocResult>();
+    m_resultPool.push_back(m_result);
+
+    m_result->width  = m_config.outDataWidth;
+    m_result->height = m_config.outDataHeight;
+
+    if (m_config.taskType == "classification")
+    {
+        m_result->type = POSTPROC_RESULT_CLASSIFICATION;
+    }
+    else if (m_config.taskType == "detection")
+    {
+        m_result->type = POSTPROC_RESULT_DETECTION;
+    }
+    else if (m_config.taskType == "segmentation")
+    {
+        m_result->type = POSTPROC_RESULT_SEGMENTATION;
+        m_result->maskWidth  = m_config.inDataWidth;
+        m_result->maskHeight = m_config.inDataHeight;
+    }
+    else if (m_config.taskType == "keypoint_detection")
+    {
+        m_result->type = POSTPROC_RESULT_KEYPOINTS;
+    }
+}
+
+void PostprocessImage::nextResult()
+{
+    std::shared_ptr<PostprocResult> next;
+
+    /* Only the pool and m_result refer to a set that is not shared. */
+    if (m_result.use_count() <= 2)
+    {
+        return;
+    }
+
+    for (const auto &r : m_resultPool)
+    {
+        if (r.use_count() == 1)
+        {
+            next = r;
+            break;
+        }
+    }
+
+    if (next == nullptr)
+    {
+        next = std::make_shared<PostprocResult>();
+        m_resultPool.push_back(next);
+    }
+
+    next->type       = m_result->type;
+    next->width      = m_result->width;
+    next->height     = m_result->height;
+    next->maskWidth  = m_result->maskWidth;
+    next->maskHeight = m_result->maskHeight;
+
+    m_result = next;
 }
 
 PostprocessImage* PostprocessImage::makePostprocessImageObj(const PostprocessImageConfig    &config,
@@ -91,6 +150,26 @@ PostprocessImage* PostprocessImage::makePostprocessImageObj(const PostprocessIma
     return cntxt;
 }
 
+int32_t PostprocessImage::enableTracking(const TrackerConfig &config)
+{
+    (void)config;
+
+    LOG_ERROR("Tracking is not supported for task type [%s].\n",
+              m_config.taskType.c_str());
+
+    return -1;
+}
+
+int32_t PostprocessImage::enableCascade(CascadeClassifier *cascade)
+{
+    (void)cascade;
+
+    LOG_ERROR("Cascade is not supported for task type [%s].\n",
+              m_config.taskType.c_str());
+
+    return -1;
+}
+
 const std::string &PostprocessImage::getTaskType()
 {
     return m_config.taskType;
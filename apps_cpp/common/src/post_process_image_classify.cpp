@@ -60,7 +60,8 @@ using namespace cv;
                        m_config.outDataHeight,           \
                        labelOffset,                      \
                        m_config.topN,                    \
-                       buff->numElem)
+                       buff->numElem,                    \
+                       m_result->objects)
 #else
 #define INVOKE_OVERLAY_CLASS_LOGIC(T)                    \
     overlayTopNClasses(frameData,                        \
@@ -70,7 +71,8 @@ using namespace cv;
                        m_config.outDataHeight,           \
                        labelOffset,                      \
                        m_config.topN,                    \
-                       buff->numElem)
+                       buff->numElem,                    \
+                       m_result->objects)
 #endif // defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
 
 PostprocessImageClassify::PostprocessImageClassify(const PostprocessImageConfig &config,
@@ -160,11 +162,13 @@ static vector<tuple<T, int32_t>> get_topN(T        *data,
   * Although OpenCV expects BGR data, this function adjusts the color values so that
   * the post processing can be done on a RGB buffer without extra performance impact.
   *
-  * @param frame Original RGB data buffer, where the in-place updates will happen
+  * @param frame Original RGB data buffer, where the in-place updates will happen,
+  *        or nullptr to only fill the objects
   * @param results Reference to a vector of vector of floats representing the output
   *          from an inference API. It should contain 1 vector representing the
   *          probability with which that class is detected in this image.
   * @param size Number of elements in the input array 'results'.
+  * @param objects Vector receiving the top N classes and their scores
   * @returns original frame with some in-place post processing done
   */
 template <typename T1, typename T2>
@@ -178,7 +182,8 @@ static T1 *overlayTopNClasses(T1                        *frame,
                               int32_t                   outDataHeight,
                               int32_t                   labelOffset,
                               int32_t                   N,
-                              int32_t                   size)
+                              int32_t                   size,
+                              vector<PostprocObject>    &objects)
 {
     vector<tuple<T2,int32_t>> argmax;
     float txtSize = static_cast<float>(outDataWidth)/POSTPROC_DEFAULT_WIDTH;
@@ -187,7 +192,15 @@ static T1 *overlayTopNClasses(T1                        *frame,
     Scalar text_bg_color(5, 11, 120);
 
     argmax = get_topN<T2>(results, N, size);
-    Mat img = Mat(outDataHeight, outDataWidth, CV_8UC3, frame);
+    objects.clear();
+
+    bool draw = frame != nullptr;
+    Mat  img;
+
+    if (draw)
+    {
+        img = Mat(outDataHeight, outDataWidth, CV_8UC3, frame);
+    }
 
     std::string title = "Recognized Classes (Top " + std::to_string(N) + "):";
 
@@ -197,9 +210,12 @@ static T1 *overlayTopNClasses(T1                        *frame,
     Point bgBottomRight = Point(totalTextSize.width + 10, (2 * rowSize) + 3 + 5);
     Point fontCoord = Point(5, 2 * rowSize);
 
-    rectangle(img, bgTopleft, bgBottomRight, text_bg_color, -1);
-    putText(img, title.c_str(), fontCoord, FONT_HERSHEY_SIMPLEX, txtSize,
-            Scalar(0, 255, 0), 2);
+    if (draw)
+    {
+        rectangle(img, bgTopleft, bgBottomRight, text_bg_color, -1);
+        putText(img, title.c_str(), fontCoord, FONT_HERSHEY_SIMPLEX, txtSize,
+                Scalar(0, 255, 0), 2);
+    }
 
 #if defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
     string output;
@@ -208,6 +224,11 @@ static T1 *overlayTopNClasses(T1                        *frame,
     for (int i = 0; i < N; i++)
     {
         int32_t index = get<1>(argmax[i]) + labelOffset;
+        PostprocObject obj;
+
+        obj.classId = index;
+        obj.score   = static_cast<float>(get<0>(argmax[i]));
+        objects.push_back(obj);
 
         if (index >= 0)
         {
@@ -238,9 +259,12 @@ static T1 *overlayTopNClasses(T1                        *frame,
             bgBottomRight = Point(totalTextSize.width + 10, (rowSize * row) + 3 + 5);
             fontCoord = Point(5, rowSize * row);
 
-            rectangle(img, bgTopleft, bgBottomRight, text_bg_color, -1);
-            putText(img, str, fontCoord, FONT_HERSHEY_SIMPLEX, txtSize,
-                    text_color, 2);
+            if (draw)
+            {
+                rectangle(img, bgTopleft, bgBottomRight, text_bg_color, -1);
+                putText(img, str, fontCoord, FONT_HERSHEY_SIMPLEX, txtSize,
+                        text_color, 2);
+            }
         }
     }
 
@@ -264,6 +288,8 @@ void *PostprocessImageClassify::operator()(void            *frameData,
     void       *ret = frameData;
     int32_t     labelOffset = m_config.labelOffsetMap.at(0);
 
+    nextResult();
+
     if (buff->type == DlInferType_Int8)
     {
         ret = INVOKE_OVERLAY_CLASS_LOGIC(int8_t);
@@ -75,14 +75,22 @@ PostprocessImageKeypointDetect::PostprocessImageKeypointDetect(const Postprocess
 void *PostprocessImageKeypointDetect::operator()(void           *frameData,
                                                  VecDlTensorPtr &results)
 {
-    
-    Mat img = Mat(m_config.outDataHeight, m_config.outDataWidth, CV_8UC3, frameData);
+    bool draw = frameData != nullptr;
+    Mat img;
     void *ret = frameData;
     auto *result = results[0];
     float* data = (float*)result->data;
     int tensorHeight = result->shape[result->dim - 2];
     int tensorWidth = result->shape[result->dim - 1];
 
+    nextResult();
+    m_result->objects.clear();
+
+    if (draw)
+    {
+        img = Mat(m_config.outDataHeight, m_config.outDataWidth, CV_8UC3, frameData);
+    }
+
     for(int i = 0; i < tensorHeight ; i++)
     {
         vector<int> det_bbox;
@@ -114,8 +122,11 @@ void *PostprocessImageKeypointDetect::operator()(void           *frameData,
             Point p1(det_bbox[0], det_bbox[1]);
             Point p2(det_bbox[2], det_bbox[3]);
 
-            rectangle(img, p1, p2, Scalar(0,255,0), 2);
-            
+            if (draw)
+            {
+                rectangle(img, p1, p2, Scalar(0,255,0), 2);
+            }
+
             // Draw label
             if (m_config.labelOffsetMap.find(det_label) != m_config.labelOffsetMap.end())
             {
@@ -138,8 +149,31 @@ void *PostprocessImageKeypointDetect::operator()(void           *frameData,
                 skeleton = m_config.datasetInfo.at(adj_class_id).skeleton;
             }
 
-            putText(img, objectname, Point(det_bbox[0], det_bbox[1] + 15),
-                    FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255,0,0), 2);
+            if (draw)
+            {
+                putText(img, objectname, Point(det_bbox[0], det_bbox[1] + 15),
+                        FONT_HERSHEY_SIMPLEX, 0.5, Scalar(255,0,0), 2);
+            }
+
+            PostprocObject obj;
+            obj.classId = adj_class_id;
+            obj.score   = det_score;
+            for (int j = 0; j < 4; j++)
+            {
+                obj.box[j] = det_bbox[j];
+            }
+            obj.keypoints = kpt;
+            for (uint64_t j = 0; j + 1 < obj.keypoints.size(); j += 3)
+            {
+                obj.keypoints[j]     *= m_scaleX;
+                obj.keypoints[j + 1] *= m_scaleY;
+            }
+            m_result->objects.push_back(obj);
+
+            if (!draw)
+            {
+                continue;
+            }
 
             // Draw Keypoints
             int num_kpts = kpt.size()/3;
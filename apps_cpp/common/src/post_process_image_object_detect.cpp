@@ -81,7 +81,7 @@ PostprocessImageObjDetect::PostprocessImageObjDetect(const PostprocessImageConfi
  * @returns original frame with some in-place post processing done
  */
 static void *overlayBoundingBox(void                         *frame,
-                                int                          *box,
+                                const int                    *box,
                                 int32_t                      outDataWidth,
                                 int32_t                      outDataHeight,
                                 const std::string            objectname,
@@ -227,24 +227,40 @@ void *PostprocessImageObjDetect::operator()(void           *frameData,
 
     int32_t numEntries = resultRo[0]->numElem/lastDims[0];
 
+    /* With tracking, the weaker detections also extend the tracks, and
+     * the results of an earlier frame are not decoded again.
+     */
+    float   minScore = m_tracker ? 0.0f : m_config.vizThreshold;
+
+    m_drawItems.clear();
+
+    if (m_tracker)
+    {
+        m_tracker->clearDetections();
+
+        if (!m_resultsUpdated)
+        {
+            numEntries = 0;
+        }
+    }
+
     for (auto i = 0; i < numEntries; i++)
     {
         float score;
-        int label, adj_class_id, box[4];
-        uint8_t color[3];
-        std::string objectname;
+        int label, adj_class_id;
+        DetectDrawItem item;
 
         score = getVal(i, m_config.formatter[5]);
 
-        if (score < m_config.vizThreshold)
+        if (score < minScore)
         {
             continue;
         }
         
-        box[0] = getVal(i, m_config.formatter[0]) * m_scaleX;
-        box[1] = getVal(i, m_config.formatter[1]) * m_scaleY;
-        box[2] = getVal(i, m_config.formatter[2]) * m_scaleX;
-        box[3] = getVal(i, m_config.formatter[3]) * m_scaleY;
+        item.box[0] = getVal(i, m_config.formatter[0]) * m_scaleX;
+        item.box[1] = getVal(i, m_config.formatter[1]) * m_scaleY;
+        item.box[2] = getVal(i, m_config.formatter[2]) * m_scaleX;
+        item.box[3] = getVal(i, m_config.formatter[3]) * m_scaleY;
 
         label = getVal(i, m_config.formatter[4]);
 
@@ -257,37 +273,148 @@ void *PostprocessImageObjDetect::operator()(void           *frameData,
             adj_class_id = m_config.labelOffsetMap.at(0) + label;
         }
 
-        if (m_config.datasetInfo.find(adj_class_id) != m_config.datasetInfo.end())
+        if (m_tracker)
         {
-            objectname = m_config.datasetInfo.at(adj_class_id).name;
-            if ("" != m_config.datasetInfo.at(adj_class_id).superCategory)
+            TrackerDetection det;
+
+            for (int32_t j = 0; j < 4; j++)
             {
-                objectname = m_config.datasetInfo.at(adj_class_id).superCategory +
-                             "/" +
-                             objectname;
+                det.box[j] = item.box[j];
             }
 
-            color[0] = m_config.datasetInfo.at(adj_class_id).rgbColor[0];
-            color[1] = m_config.datasetInfo.at(adj_class_id).rgbColor[1];
-            color[2] = m_config.datasetInfo.at(adj_class_id).rgbColor[2];
+            det.score   = score;
+            det.classId = adj_class_id;
+            m_tracker->addDetection(det);
+            continue;
+        }
+
+        item.classId = adj_class_id;
+        item.score   = score;
+        item.key     = m_drawItems.size();
+        m_drawItems.push_back(item);
+    }
+
+    if (m_tracker)
+    {
+        /* The velocities are per input frame, whatever the number of
+         * frames skipped in between.
+         */
+        int64_t numFrames = 1;
+
+        if (m_trackedFrame >= 0)
+        {
+            numFrames = max<int64_t>((int64_t)m_frameIndex - m_trackedFrame, 1);
+        }
+
+        m_trackedFrame = m_frameIndex;
+
+        if (m_resultsUpdated)
+        {
+            m_tracker->update(numFrames);
         }
         else
         {
-            objectname = "UNDEFINED";
-            color[0] = 20;
-            color[1] = 220;
-            color[2] = 20;
+            m_tracker->predict(numFrames);
+        }
+
+        for (const auto &t : m_tracker->getTracks())
+        {
+            DetectDrawItem item;
+
+            if (!t.visible)
+            {
+                continue;
+            }
+
+            for (int32_t j = 0; j < 4; j++)
+            {
+                item.box[j] = t.box[j];
+            }
+
+            item.classId = t.classId;
+            item.score   = t.score;
+            item.key     = t.id;
+            m_drawItems.push_back(item);
         }
+    }
 
-        overlayBoundingBox(frameData, box, m_config.outDataWidth,
-                            m_config.outDataHeight, objectname, color);
+    /* Classify the regions before anything is drawn over the frame. The
+     * results are kept for the frames without new detections.
+     */
+    if (m_cascade && m_resultsUpdated && frameData != nullptr)
+    {
+        m_cascadeResults.clear();
+
+        for (const auto &item : m_drawItems)
+        {
+            if (static_cast<int32_t>(m_cascadeResults.size()) >=
+                m_cascade->getMaxRois())
+            {
+                break;
+            }
+
+            if (m_cascade->isCandidate(item.classId))
+            {
+                int32_t cls = m_cascade->run(reinterpret_cast<uint8_t*>(frameData),
+                                             m_config.outDataWidth,
+                                             m_config.outDataHeight,
+                                             item.box);
+
+                m_cascadeResults.push_back({item.key, cls});
+            }
+        }
+    }
+
+    nextResult();
+    m_result->objects.resize(m_drawItems.size());
+
+    for (uint64_t i = 0; i < m_drawItems.size(); i++)
+    {
+        const auto     &item = m_drawItems[i];
+        PostprocObject &obj = m_result->objects[i];
+        uint8_t color[3];
+        std::string objectname;
+
+        obj.classId    = item.classId;
+        obj.trackId    = m_tracker ? item.key : -1;
+        obj.subClassId = -1;
+        obj.score      = item.score;
+
+        for (int32_t j = 0; j < 4; j++)
+        {
+            obj.box[j] = item.box[j];
+        }
+
+        getClassInfo(item.classId, objectname, color);
+
+        if (m_tracker)
+        {
+            objectname += " #" + std::to_string(item.key);
+        }
+
+        for (const auto &r : m_cascadeResults)
+        {
+            if (r.first == item.key && r.second >= 0)
+            {
+                obj.subClassId = r.second;
+                objectname += ": " + m_cascade->getClassName(r.second);
+                break;
+            }
+        }
+
+        if (frameData != nullptr)
+        {
+            overlayBoundingBox(frameData, item.box,
+                               m_config.outDataWidth, m_config.outDataHeight,
+                               objectname, color);
+        }
 
 #if defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
         output.append(objectname + "[ ");
 
         for(int32_t j = 0; j < 4; j++)
         {
-            output.append(std::to_string(box[j]) + ", ");
+            output.append(std::to_string(item.box[j]) + ", ");
         }
 
         output.append("]\n");
@@ -302,8 +429,59 @@ void *PostprocessImageObjDetect::operator()(void           *frameData,
     return ret;
 }
 
+void PostprocessImageObjDetect::getClassInfo(int32_t        classId,
+                                             std::string   &name,
+                                             uint8_t       *color)
+{
+    if (m_config.datasetInfo.find(classId) != m_config.datasetInfo.end())
+    {
+        name = m_config.datasetInfo.at(classId).name;
+        if ("" != m_config.datasetInfo.at(classId).superCategory)
+        {
+            name = m_config.datasetInfo.at(classId).superCategory +
+                   "/" +
+                   name;
+        }
+
+        color[0] = m_config.datasetInfo.at(classId).rgbColor[0];
+        color[1] = m_config.datasetInfo.at(classId).rgbColor[1];
+        color[2] = m_config.datasetInfo.at(classId).rgbColor[2];
+    }
+    else
+    {
+        name = "UNDEFINED";
+        color[0] = 20;
+        color[1] = 220;
+        color[2] = 20;
+    }
+}
+
+int32_t PostprocessImageObjDetect::enableTracking(const TrackerConfig &config)
+{
+    TrackerConfig   trackerConfig(config);
+
+    trackerConfig.highScore = m_config.vizThreshold;
+
+    delete m_tracker;
+    m_tracker = new ObjectTracker(trackerConfig);
+    m_trackedFrame = -1;
+
+    return 0;
+}
+
+int32_t PostprocessImageObjDetect::enableCascade(CascadeClassifier *cascade)
+{
+    delete m_cascade;
+    m_cascade = cascade;
+    m_cascadeResults.reserve(m_cascade->getMaxRois());
+
+    return 0;
+}
+
 PostprocessImageObjDetect::~PostprocessImageObjDetect()
 {
+    delete m_tracker;
+    delete m_cascade;
 }
 
 } // namespace ti::edgeai::common
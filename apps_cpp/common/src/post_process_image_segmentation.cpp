@@ -61,7 +61,8 @@ namespace ti::edgeai::common
                  m_config.outDataWidth,                 \
                  m_config.outDataHeight,                \
                  m_config.alpha,                        \
-                 m_config.datasetInfo)
+                 m_config.datasetInfo,                  \
+                 mask)
 #else
 #define INVOKE_BLEND_LOGIC(T)                           \
     blendSegMask(reinterpret_cast<uint8_t*>(frameData), \
@@ -71,7 +72,8 @@ namespace ti::edgeai::common
                  m_config.outDataWidth,                 \
                  m_config.outDataHeight,                \
                  m_config.alpha,                        \
-                 m_config.datasetInfo)
+                 m_config.datasetInfo,                  \
+                 mask)
 #endif // defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
 
 PostprocessImageSemanticSeg::PostprocessImageSemanticSeg(const PostprocessImageConfig   &config,
@@ -89,10 +91,13 @@ PostprocessImageSemanticSeg::PostprocessImageSemanticSeg(const PostprocessImageC
  * For every pixel in input frame, this will find the scaled co-ordinates for a
  * downscaled result and use the color associated with detected class ID.
  *
- * @param frame Original RGB data buffer, where the in-place updates will happen
+ * @param frame Original RGB data buffer, where the in-place updates will happen,
+ *        or nullptr to only fill the mask
  * @param classes Reference to a vector of vector of floats representing the output
  *          from an inference API. It should contain 1 vector describing the class ID
  *          detected for that pixel.
+ * @param mask Buffer receiving the class of every pixel of the results,
+ *        or nullptr if the mask is not used
  * @returns original frame with some in-place post processing done
  */
 template <typename T1, typename T2>
@@ -106,7 +111,8 @@ static T1 *blendSegMask(T1                              *frame,
                         int32_t                         outDataWidth,
                         int32_t                         outDataHeight,
                         float                           alpha,
-                        std::map<int32_t, DatasetInfo>  datasetInfo)
+                        std::map<int32_t, DatasetInfo>  datasetInfo,
+                        uint8_t                        *mask)
 {
     uint8_t    *ptr;
     uint8_t     a;
@@ -131,7 +137,8 @@ static T1 *blendSegMask(T1                              *frame,
 #endif // defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
 
     // Here, (w, h) iterate over frame and (sw, sh) iterate over classes
-    for (h = 0; h < outDataHeight; h++)
+    // There is nothing to blend when only the mask is requested
+    for (h = 0; frame != nullptr && h < outDataHeight; h++)
     {
         sh = (int32_t)(h * inDataHeight / outDataHeight);
         ptr = frame + h * (outDataWidth * 3);
@@ -176,6 +183,11 @@ static T1 *blendSegMask(T1                              *frame,
         }
     }
 
+    for (int32_t i = 0; mask != nullptr && i < inDataWidth * inDataHeight; i++)
+    {
+        mask[i] = static_cast<uint8_t>(classes[i]);
+    }
+
 #if defined(EDGEAI_ENABLE_OUTPUT_FOR_TEST)
     output.append("[ ");
     for (h = 0; h < inDataHeight; h++)
@@ -204,8 +216,17 @@ void *PostprocessImageSemanticSeg::operator()(void             *frameData,
     /* Even though a vector of variants is passed only the first
      * entry is valid.
      */
-    auto *buff = results[0];
-    void *ret  = frameData;
+    auto    *buff = results[0];
+    void    *ret  = frameData;
+    uint8_t *mask = nullptr;
+
+    /* The mask is only filled for its consumers. */
+    if (m_resultsRequired)
+    {
+        nextResult();
+        m_result->mask.resize(m_result->maskWidth * m_result->maskHeight);
+        mask = m_result->mask.data();
+    }
 
     if (buff->type == DlInferType_Int8)
     {